@@ -1,9 +1,8 @@
 #version 130
 
 in vec2 normal;
-
-uniform vec4 color;
-uniform float feather;
+in vec4 color;
+in float feather;
 
 out vec4 outColor;
 
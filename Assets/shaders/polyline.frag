@@ -0,0 +1,45 @@
+#version 130
+
+in vec2 local;
+flat in float segLength;
+flat in vec4 startJoin;
+flat in vec4 endJoin;
+
+uniform vec4 color;
+uniform float u_linewidth;
+uniform float feather;
+
+out vec4 outColor;
+
+#define SHAPE_ROUND 1.0
+#define SHAPE_BEVEL 2.0
+
+// Distance from the line for q, relative to the joint or cap it is past.
+// The inner side of a join is bounded by the quad itself.
+float EndDistance( vec2 q, vec4 join, float dist, float hw )
+{
+	if ( dot( q, join.xy ) < 0.0 )
+		return dist;
+	if ( join.w == SHAPE_ROUND )
+		return length( q );
+	if ( join.w == SHAPE_BEVEL )
+		return max( dist, dot( q, join.xy ) - join.z + hw );
+	return dist;
+}
+
+void main()
+{
+	float hw = u_linewidth * 0.5;
+	float dist = abs( local.y );
+	if ( local.x < 0.0 )
+		dist = EndDistance( local, startJoin, dist, hw );
+	else if ( local.x > segLength )
+		dist = EndDistance( local - vec2( segLength, 0.0 ), endJoin, dist, hw );
+
+	float fade = max( hw * feather, 1e-4 );
+	float alpha = clamp( ( hw - dist ) / fade, 0.0, 1.0 );
+	if ( alpha <= 0.0 )
+		discard;
+
+	outColor = vec4( color.xyz, color.w * alpha );
+}
@@ -0,0 +1,128 @@
+#version 130
+
+// One instance per segment, pointStart to pointEnd, with the points either
+// side of it for the joins. See PolyLinePoint.
+in vec2 pointPrev;
+in vec2 pointStart;
+in vec2 pointEnd;
+in vec2 pointNext;
+
+uniform mat3 u_mv_matrix;
+uniform mat3 u_p_matrix;
+uniform float u_linewidth;
+uniform float u_miterlimit;
+uniform int u_join; // PolyLineJoinMode
+uniform int u_cap;  // PolyLineCapMode
+
+// Position along (x) and across (y) the segment, from pointStart.
+out vec2 local;
+flat out float segLength;
+
+// Per end: outward bisector in local space, bevel distance along it, shape.
+flat out vec4 startJoin;
+flat out vec4 endJoin;
+
+#define JOIN_MITER 0
+#define JOIN_BEVEL 1
+#define JOIN_ROUND 2
+
+#define CAP_BUTT 0
+#define CAP_ROUND 1
+#define CAP_SQUARE 2
+
+#define SHAPE_NONE 0.0
+#define SHAPE_ROUND 1.0
+#define SHAPE_BEVEL 2.0
+
+// Longest miter corner, over the half width. Keeps the quads bounded, very
+// sharp turns lose the tip of their outer corner.
+#define MAX_MITER_SCALE 8.0
+
+#define EPSILON 1e-4
+
+bool IsBreak( vec2 p )
+{
+	return p.x > 1e37; // POLYLINE_BREAK
+}
+
+// Quad corner on side (1 left, -1 right) of the segment end at p. other is
+// the point past p and outward is 1 at the segment's end, -1 at its start.
+vec2 EndCorner( vec2 p, vec2 other, vec2 dir, float outward, float side, out vec4 join )
+{
+	float hw = u_linewidth * 0.5;
+	vec2 n = vec2( -dir.y, dir.x );
+
+	if ( IsBreak( other ) || distance( other, p ) < EPSILON )
+	{
+		join = vec4( 0.0, 0.0, 0.0, ( u_cap == CAP_ROUND ) ? SHAPE_ROUND : SHAPE_NONE );
+		float extend = ( u_cap == CAP_BUTT ) ? 0.0 : hw;
+		return p + dir * outward * extend + n * side * hw;
+	}
+
+	// Directions into and out of the joint, both along the line.
+	vec2 otherDir = normalize( other - p ) * outward;
+	vec2 dirIn = ( outward > 0.0 ) ? dir : otherDir;
+	vec2 dirOut = ( outward > 0.0 ) ? otherDir : dir;
+
+	// Both segments end on the miter line, so they meet without overlap.
+	vec2 miter = vec2( -dirIn.y, dirIn.x ) + vec2( -dirOut.y, dirOut.x );
+	float miterScale = 1.0;
+	if ( length( miter ) > EPSILON )
+	{
+		miter = normalize( miter );
+		miterScale = 1.0 / max( dot( miter, n ), EPSILON );
+	}
+	else
+	{
+		miter = n;
+	}
+
+	// Anything past the outer corners is shaped in the fragment shader.
+	float shape = SHAPE_NONE;
+	vec2 bisector = dirIn - dirOut;
+	if ( length( bisector ) > EPSILON )
+	{
+		bisector = normalize( bisector );
+		if ( u_join == JOIN_ROUND )
+			shape = SHAPE_ROUND;
+		else if ( u_join == JOIN_BEVEL || miterScale > u_miterlimit )
+			shape = SHAPE_BEVEL;
+	}
+	else
+	{
+		bisector = vec2( 0.0 );
+	}
+
+	join = vec4( dot( bisector, dir ), dot( bisector, n ), hw * abs( dot( n, bisector ) ), shape );
+	return p + miter * side * hw * min( miterScale, MAX_MITER_SCALE );
+}
+
+void main()
+{
+	if ( IsBreak( pointStart ) || IsBreak( pointEnd ) || distance( pointStart, pointEnd ) < EPSILON )
+	{
+		// Not a segment, e.g. between two lines batched together. Every
+		// corner lands on the same point so nothing is rasterized.
+		local = vec2( 0.0 );
+		segLength = 0.0;
+		startJoin = vec4( 0.0 );
+		endJoin = vec4( 0.0 );
+		gl_Position = vec4( 0.0, 0.0, 0.0, 1.0 );
+		return;
+	}
+
+	// Triangle strip: start left, start right, end left, end right.
+	float side = ( gl_VertexID == 0 || gl_VertexID == 2 ) ? 1.0 : -1.0;
+
+	vec2 dir = normalize( pointEnd - pointStart );
+	vec2 n = vec2( -dir.y, dir.x );
+	vec2 startCorner = EndCorner( pointStart, pointPrev, dir, -1.0, side, startJoin );
+	vec2 endCorner = EndCorner( pointEnd, pointNext, dir, 1.0, side, endJoin );
+	vec2 pos = ( gl_VertexID >= 2 ) ? endCorner : startCorner;
+
+	segLength = distance( pointStart, pointEnd );
+	local = vec2( dot( pos - pointStart, dir ), dot( pos - pointStart, n ) );
+
+	vec3 clip = u_p_matrix * u_mv_matrix * vec3( pos, 1.0 );
+	gl_Position = vec4( clip.xy, 0.0, 1.0 );
+}
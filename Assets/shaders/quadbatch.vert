@@ -29,9 +29,20 @@ void main()
 	uvcoords = uv * quadUVSize + quadUVOffset;
 #endif
 
-	float sinRot = sin(quadRotRads);
-	float cosRot = cos(quadRotRads);
+#ifdef COMPACT_QUAD
+	// CompactQuad: fixed point position and origin, snorm rotation of pi.
+	vec2 pos = quadPos / COMPACT_QUAD_POSITION_SCALE;
+	vec2 origin = quadOrigin / COMPACT_QUAD_ORIGIN_SCALE;
+	float rotRads = quadRotRads * 3.14159265;
+#else
+	vec2 pos = quadPos;
+	vec2 origin = quadOrigin;
+	float rotRads = quadRotRads;
+#endif
+
+	float sinRot = sin(rotRads);
+	float cosRot = cos(rotRads);
 	mat2 rotMat = mat2( cosRot, sinRot, -sinRot, cosRot );
-	vec2 worldPos = ( rotMat * ( vertPosition + quadOrigin ) ) * quadSize + quadPos;
+	vec2 worldPos = ( rotMat * ( vertPosition + origin ) ) * quadSize + pos;
 	gl_Position = vec4( ( screenSpaceTransform * vec3( worldPos, 1.0f ) ).xy, 0.0f, 1.0f );
 }
@@ -1,6 +1,7 @@
 #include "MapDocument.h"
 #include "SceneObject.h"
 #include "Collision/World.h"
+#include "Collision/XmlMapReader.h"
 #include "Graphics/Texture.h"
 #include "Graphics/Camera.h"
 #include "ProcyonQtUtil.h"
@@ -9,8 +10,6 @@
 
 #include <QFile>
 #include <QXmlStreamWriter>
-#include <QDomDocument>
-#include <QDomElement>
 
 #define MAP_DOCUMENT_UNDO_LIMIT 256
 
@@ -173,140 +172,106 @@ bool MapDocument::Save( const QString& filename )
 	return true;
 }
 
-bool MapDocument::Load( const QString& filename )
+/*
+================
+MapDocumentReader
+
+Streams a map file into a MapDocument, tiles go straight into its World.
+================
+*/
+class MapDocumentReader : public Procyon::XmlMapReader
 {
-	QFile file( filename );
+public:
+	MapDocumentReader( MapDocument* doc )
+		: mDoc( doc )
+		, mObject( nullptr )
+		, mObjectsDone( false )
+	{
+	}
 
-	if ( !file.open( QIODevice::ReadOnly ) )
+	~MapDocumentReader()
 	{
-        PROCYON_WARN( "MapDocument", "Unable to open file '%s' for loading.", filename.toUtf8().data() );
-        return false;
+		delete mObject; // only set if the read failed mid <Object>
 	}
 
-    QDomDocument doc;
+protected:
+	virtual void OnTileDef( const Procyon::TileDef& def )
+	{
+		mDoc->mTileSet->AddTileDef( def );
+	}
 
-    QString errMsg;
-    int errLine, errColumn;
-    if ( !doc.setContent( &file, &errMsg, &errLine, &errColumn ) )
-    {
-        PROCYON_WARN( "MapDocument", "Error parsing XML file '%s' Line %i Column %i: %s"
-            , filename.toUtf8().data()
-            , errLine, errColumn
-            , errMsg.toUtf8().data() );
-        file.close();
-        return false;
-    }
-    file.close();
+	virtual bool OnTilesBegin( const glm::ivec2& size )
+	{
+		mDoc->mWorld->NewWorld( size, mDoc->mTileSet );
+		return true;
+	}
 
-    QDomElement docElem = doc.documentElement();
-    QDomNode n = docElem.firstChild();
-    if ( !n.isNull() )
-    {
-        // Parse TileSet
-        QDomElement domTileSet = docElem.firstChildElement( "TileSet" );
-        if ( !domTileSet.isNull() )
-        {
-            QDomElement domtTileDef = domTileSet.firstChildElement( "TileDef" );
-            while ( !domtTileDef.isNull() )
-            {
-                QString filepath = domtTileDef.attribute( "filepath" );
-
-                Procyon::TileDef def;
-                if ( !filepath.isEmpty() )
-                {
-                    def.filepath = filepath.toUtf8().data();
-					def.collidable = true;
-                }
-
-	            QString type = domtTileDef.attribute( "type" );
-                if ( !type.isEmpty() )
-				{
-					def.type = Procyon::TileDef::StringToTileType( type.toUtf8().data() );
-				}
-
-				mTileSet->AddTileDef( def );
-                domtTileDef = domtTileDef.nextSiblingElement( "TileDef" );
-            }
-        }
+	virtual void OnTile( int x, int y, Procyon::TileId tile )
+	{
+		mDoc->mWorld->SetTile( glm::ivec2( x, y ), tile );
+	}
 
-        // Parse Camera
-        QDomElement domCamera = docElem.firstChildElement( "Camera" );
-        if ( !domCamera.isNull() )
-        {
-            // parse camera
-            mCameraState.center.x = domCamera.attribute( "x" ).toFloat();
-            mCameraState.center.y = domCamera.attribute( "y" ).toFloat();
-            mCameraState.zoom = domCamera.attribute( "zoom" ).toFloat();
-        }
+	virtual void OnStartElement( const char* name, const Attribute* attrs, int count )
+	{
+		if ( strcmp( name, "Camera" ) == 0 )
+		{
+			mDoc->mCameraState.center.x = QString( FindAttribute( attrs, count, "x" ) ).toFloat();
+			mDoc->mCameraState.center.y = QString( FindAttribute( attrs, count, "y" ) ).toFloat();
+			mDoc->mCameraState.zoom = QString( FindAttribute( attrs, count, "zoom" ) ).toFloat();
+		}
+		else if ( strcmp( name, "Object" ) == 0 && !mObjectsDone )
+		{
+			// Objects stop at the first one without a name.
+			QString objName( FindAttribute( attrs, count, "name" ) );
+			if ( objName.isEmpty() )
+			{
+				mObjectsDone = true;
+				return;
+			}
+			mObject = new SceneObject( objName, nullptr );
+		}
+		else if ( strcmp( name, "Position" ) == 0 && mObject )
+		{
+			QPoint pos;
+			pos.setX( QString( FindAttribute( attrs, count, "x" ) ).toFloat() );
+			pos.setY( QString( FindAttribute( attrs, count, "y" ) ).toFloat() );
+			mObject->SetPosition( pos );
+		}
+		else if ( strcmp( name, "Dimensions" ) == 0 && mObject )
+		{
+			QPoint dims;
+			dims.setX( QString( FindAttribute( attrs, count, "width" ) ).toFloat() );
+			dims.setY( QString( FindAttribute( attrs, count, "height" ) ).toFloat() );
+			mObject->SetDimensions( dims );
+		}
+	}
 
-        // Parse Tiles
-        QDomElement domTiles = docElem.firstChildElement( "Tiles" );
-        if ( !domTiles.isNull() )
-        {
-            int sizeX = domTiles.attribute( "width" ).toUInt();
-            int sizeY = domTiles.attribute( "height" ).toUInt();
-            mWorld->NewWorld( glm::ivec2( sizeX, sizeY ), mTileSet );
+	virtual void OnEndElement( const char* name, const char* text )
+	{
+		if ( strcmp( name, "Rotation" ) == 0 && mObject )
+		{
+			mObject->SetRotation( QString( text ).toFloat() );
+		}
+		else if ( strcmp( name, "Object" ) == 0 && mObject )
+		{
+			mDoc->mRoot->AddChild( mObject );
+			mObject = nullptr;
+		}
+	}
 
-            // parse tiles
-            QDomElement domTileRow = domTiles.firstChildElement( "TileRow" );
-            while ( !domTileRow.isNull() )
-            {
-                int w = domTileRow.attribute( "index" ).toInt();
-                QDomElement domTile = domTileRow.firstChildElement( "Tile" );
-                while ( !domTile.isNull() )
-                {
-                    int h = domTile.attribute( "index" ).toInt();
-                    int tileType = domTile.text().toInt();
-                    mWorld->SetTile( glm::ivec2( w, h ), ( Procyon::TileId )tileType );
-                    domTile = domTile.nextSiblingElement( "Tile" );
-                }
-                domTileRow = domTileRow.nextSiblingElement( "TileRow" );
-            }
-        }
+	MapDocument* 	mDoc;
+	SceneObject* 	mObject;
+	bool 			mObjectsDone;
+};
 
-        // Parse Objects
-        QDomElement domObjects = docElem.firstChildElement( "Objects" );
-        if ( !domObjects.isNull() )
-        {
-            QDomElement domObject = domObjects.firstChildElement( "Object" );
-            QString name;
-            while ( !domObject.isNull() && !( name = domObject.attribute( "name" ) ).isEmpty() )
-            {
-                SceneObject* obj = new SceneObject( name, nullptr );
-
-                QDomElement domTransform = domObject.firstChildElement( "Transform" );
-                if ( !domTransform.isNull() )
-                {
-                    QDomElement domPosition = domTransform.firstChildElement( "Position" );
-                    if ( !domPosition.isNull() )
-                    {
-                        QPoint pos;
-                        pos.setX( domPosition.attribute( "x" ).toFloat() );
-                        pos.setY( domPosition.attribute( "y" ).toFloat() );
-                        obj->SetPosition( pos );
-                    }
-
-                    QDomElement domDimensions = domTransform.firstChildElement( "Dimensions" );
-                    if ( !domDimensions.isNull() )
-                    {
-                        QPoint dims;
-                        dims.setX( domDimensions.attribute( "width" ).toFloat() );
-                        dims.setY( domDimensions.attribute( "height" ).toFloat() );
-                        obj->SetDimensions( dims );
-                    }
-
-                    QDomElement domRotation = domTransform.firstChildElement( "Rotation" );
-                    if ( !domRotation.isNull() )
-                    {
-                        obj->SetRotation( domRotation.text().toFloat() );
-                    }
-                }
-
-                mRoot->AddChild( obj );
-                domObject = domObject.nextSiblingElement( "Object" );
-            }
-        }
-    }
+bool MapDocument::Load( const QString& filename )
+{
+	MapDocumentReader reader( this );
+	if ( !reader.Read( filename.toUtf8().data() ) )
+	{
+		PROCYON_WARN( "MapDocument", "Unable to load '%s'.", filename.toUtf8().data() );
+		return false;
+	}
 
 	mFilePath = filename;
 	SetModified( false );
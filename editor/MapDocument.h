@@ -299,6 +299,7 @@ protected:
     QItemSelectionModel* mSelectionModel;
 
     friend class SetTileCommand;
+    friend class MapDocumentReader;
 };
 
 
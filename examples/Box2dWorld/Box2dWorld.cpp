@@ -124,7 +124,7 @@ public:
 	    }
     }
 
-    virtual void Render()
+    virtual void Render( float alpha )
     {
 		for( auto pair : mSpriteBodies )
 		{
@@ -0,0 +1,92 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+/*
+================
+MapConvert
+
+Converts an xml map into a BinaryMap (.pmap) that the Sandbox can map
+straight into memory.
+
+	MapConvert <in.xml> <out.pmap> [-raw]
+================
+*/
+
+#include "ProcyonCommon.h"
+#include "XmlMap.h"
+#include "Collision/BinaryMap.h"
+
+using namespace Procyon;
+
+// BinaryMap::Write() reads a Map, XmlMap only fills a World.
+class WorldMap : public Map
+{
+public:
+	WorldMap( const World& world, const TileSet* tileSet ) : mWorld( world ), mTileSet( tileSet ) { }
+
+	virtual TileId GetTile( int x, int y ) const { return mWorld.GetTile( glm::ivec2( x, y ) ); }
+	virtual const TileSet* GetTileSet() const { return mTileSet; }
+	virtual glm::ivec2 GetSize() const { return mWorld.GetSize(); }
+
+protected:
+	const World& 	mWorld;
+	const TileSet* 	mTileSet;
+};
+
+int main( int argc, char *argv[] )
+{
+	if ( argc < 3 )
+	{
+		fprintf( stderr, "usage: %s <in.xml> <out.pmap> [-raw]\n", argv[ 0 ] );
+		return 1;
+	}
+
+	int result = 1;
+	LOGOG_INITIALIZE();
+	{
+		logog::Cout err;
+
+		const bool compress = !( argc > 3 && strcmp( argv[ 3 ], "-raw" ) == 0 );
+
+		// Only the texture paths are needed, never touch the GPU.
+		XmlMap xml( argv[ 1 ], false );
+		World world;
+		if ( !xml.Load( &world ) )
+		{
+			PROCYON_ERROR( "MapConvert", "Unable to load '%s'.", argv[ 1 ] );
+		}
+		else if ( !BinaryMap::Write( argv[ 2 ], WorldMap( world, xml.GetTileSet() ), compress ) )
+		{
+			PROCYON_ERROR( "MapConvert", "Unable to write '%s'.", argv[ 2 ] );
+		}
+		else
+		{
+			result = 0;
+		}
+	}
+	LOGOG_SHUTDOWN();
+
+	return result;
+}
@@ -0,0 +1,197 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+/*
+================
+MapLoadBench
+
+Compares loading an xml map through a tinyxml2 document against XmlMap
+streaming it into a World. Each path runs in its own process so the peak
+resident set reported is that path's alone.
+
+	MapLoadBench <map.xml> [dom|stream]
+	MapLoadBench -generate <map.xml> <width> <height>
+================
+*/
+
+#include "ProcyonCommon.h"
+#include "XmlMap.h"
+
+#include <tinyxml2.h>
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace Procyon;
+
+// Peak resident set of this process, in kilobytes.
+static long PeakRSSKb()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) );
+	return (long)( counters.PeakWorkingSetSize / 1024 );
+#else
+	struct rusage usage;
+	getrusage( RUSAGE_SELF, &usage );
+	return usage.ru_maxrss;
+#endif
+}
+
+// The document walk XmlMap used before XmlMapReader.
+static bool LoadDom( const char* filePath, std::vector< TileId >& tiles )
+{
+	tinyxml2::XMLDocument doc;
+	if ( doc.LoadFile( filePath ) != tinyxml2::XML_SUCCESS )
+		return false;
+
+	const tinyxml2::XMLElement* map = doc.FirstChildElement( "Map" );
+	const tinyxml2::XMLElement* tilesElem = ( map ) ? map->FirstChildElement( "Tiles" ) : NULL;
+	if ( !tilesElem )
+		return false;
+
+	glm::ivec2 size;
+	if ( tilesElem->QueryIntAttribute( "width", &size.x ) != tinyxml2::XML_SUCCESS
+		|| tilesElem->QueryIntAttribute( "height", &size.y ) != tinyxml2::XML_SUCCESS
+		|| size.x <= 0
+		|| size.y <= 0 )
+		return false;
+	tiles.assign( size.x * size.y, 0 );
+
+	for ( const tinyxml2::XMLElement* row = tilesElem->FirstChildElement( "TileRow" ); row; row = row->NextSiblingElement( "TileRow" ) )
+	{
+		int x = 0;
+		if ( row->QueryIntAttribute( "index", &x ) != tinyxml2::XML_SUCCESS )
+			return false;
+
+		for ( const tinyxml2::XMLElement* tile = row->FirstChildElement( "Tile" ); tile; tile = tile->NextSiblingElement( "Tile" ) )
+		{
+			int y = 0;
+			if ( tile->QueryIntAttribute( "index", &y ) != tinyxml2::XML_SUCCESS )
+				return false;
+
+			if ( x >= 0 && x < size.x && y >= 0 && y < size.y && tile->GetText() )
+				tiles[ x * size.y + y ] = (TileId)atoi( tile->GetText() );
+		}
+	}
+	return true;
+}
+
+static bool Generate( const char* filePath, int width, int height )
+{
+	std::ofstream out( filePath );
+	if ( !out )
+		return false;
+
+	out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<Map>\n";
+	out << "\t<TileSet>\n\t\t<TileDef filepath=\"sprites/tile.png\" type=\"Solid\"/>\n\t</TileSet>\n";
+	out << "\t<Tiles width=\"" << width << "\" height=\"" << height << "\">\n";
+	for ( int x = 0; x < width; x++ )
+	{
+		out << "\t\t<TileRow index=\"" << x << "\">\n";
+		for ( int y = 0; y < height; y++ )
+		{
+			out << "\t\t\t<Tile index=\"" << y << "\">" << ( ( y < height / 4 || ( x * 7 + y ) % 13 == 0 ) ? 1 : 0 ) << "</Tile>\n";
+		}
+		out << "\t\t</TileRow>\n";
+	}
+	out << "\t</Tiles>\n</Map>\n";
+	return out.good();
+}
+
+static int Run( const char* filePath, const std::string& mode )
+{
+	const long baseKb = PeakRSSKb();
+	const auto start = std::chrono::high_resolution_clock::now();
+
+	bool loaded = false;
+	size_t tileCount = 0;
+	if ( mode == "dom" )
+	{
+		std::vector< TileId > tiles;
+		loaded = LoadDom( filePath, tiles );
+		tileCount = tiles.size();
+	}
+	else
+	{
+		XmlMap map( filePath, false );
+		World world;
+		loaded = map.Load( &world );
+		tileCount = world.GetSize().x * world.GetSize().y;
+	}
+
+	const auto end = std::chrono::high_resolution_clock::now();
+	if ( !loaded )
+	{
+		fprintf( stderr, "Unable to load '%s'.\n", filePath );
+		return 1;
+	}
+
+	printf( "%-8s %10zu tiles %10.1f ms  peak rss %8ld kb (+%ld kb)\n"
+		, mode.c_str()
+		, tileCount
+		, std::chrono::duration< double, std::milli >( end - start ).count()
+		, PeakRSSKb()
+		, PeakRSSKb() - baseKb );
+	return 0;
+}
+
+int main( int argc, char *argv[] )
+{
+	if ( argc == 5 && strcmp( argv[ 1 ], "-generate" ) == 0 )
+	{
+		return Generate( argv[ 2 ], atoi( argv[ 3 ] ), atoi( argv[ 4 ] ) ) ? 0 : 1;
+	}
+
+	if ( argc < 2 )
+	{
+		fprintf( stderr, "usage: %s <map.xml> [dom|stream]\n       %s -generate <map.xml> <width> <height>\n", argv[ 0 ], argv[ 0 ] );
+		return 1;
+	}
+
+	if ( argc < 3 )
+	{
+		// One process per path, peak rss never goes back down.
+		const std::string self = std::string( "\"" ) + argv[ 0 ] + "\" \"" + argv[ 1 ] + "\" ";
+		const int dom = system( ( self + "dom" ).c_str() );
+		const int stream = system( ( self + "stream" ).c_str() );
+		return ( dom == 0 && stream == 0 ) ? 0 : 1;
+	}
+
+	int result = 0;
+	LOGOG_INITIALIZE();
+	{
+		logog::Cout err;
+		result = Run( argv[ 1 ], argv[ 2 ] );
+	}
+	LOGOG_SHUTDOWN();
+
+	return result;
+}
@@ -27,6 +27,7 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "ProcyonCommon.h"
 #include "Aabb.h"
+#include "Collision/BodySystem.h"
 
 #define PIXELS_PER_METER 32.0f
 #define PixelsToMeters( pixels ) 						\
@@ -50,9 +51,7 @@ namespace Procyon {
 	class Renderable;
 	class Renderer;
     class AnimatedSprite;
-	class World;
-	class Tile;
-	class Contact;
+	class BodySystem;
 	class Sound;
 	class Text;
 }
@@ -60,12 +59,16 @@ namespace Procyon {
 class Player
 {
 public:
-						Player( Procyon::World* world );
+						Player( Procyon::BodySystem* bodies );
 						~Player();
 
+	// Process() sets the body's velocity, PostStep() follows it once the
+	// BodySystem has stepped.
 	void 				Process( Procyon::FrameTime ft );
+	void 				PostStep( Procyon::FrameTime ft );
 
-	void				Draw( Procyon::Renderer* r ) const;
+	// alpha blends from the position before the last step to the current.
+	void				Draw( Procyon::Renderer* r, float alpha ) const;
 
 	glm::vec2			GetPosition() const;
 	Procyon::Aabb		GetBounds() const;
@@ -76,22 +79,14 @@ public:
 	void 				SetLeftRightInput( float input );
 
 protected:
-	void 				UpdatePosition( Procyon::FrameTime ft );
-
-	void 				CollideTile( const glm::vec2& delta, const glm::ivec2& t, Procyon::FrameTime ft );
-	void 				Collide( const Procyon::Aabb& other, Procyon::FrameTime ft );
-
-	void 				CollisionResponse( const Procyon::Contact& c, Procyon::FrameTime ft );
-
-	Procyon::World* 	     mWorld;
-	Procyon::Aabb		     mBounds;
+	Procyon::BodySystem* 	 mBodies;
+	Procyon::BodyId 		 mBody;
 	glm::vec2	             mInput;
 	glm::vec2 			     mVelocity;
+	glm::vec2 			     mPrevPosition;
 	Procyon::AnimatedSprite* mSprite;
-	glm::vec2 			     mPenetrationCorrection;
 	Procyon::Sound*		     mJumpSnd;
 	Procyon::Text*		     mPlayerText;
-	bool				     mGrounded;
 };
 
 #endif /* _PLAYER_H */
@@ -26,25 +26,20 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 #include "Platform/Mouse.h"
 #include "Graphics/Renderer.h"
 #include "Graphics/RenderCore.h"
-#include "Graphics/GL/ProcyonVaser.h"
 #include "Player.h"
 
 using namespace Procyon;
 
-std::vector< glm::highp_vec2 > sPoints;
+static const int maxSamples = 200;
+std::vector< glm::vec2 > sPoints;
 int sPointsStart = 0;
-std::vector< glm::highp_vec2 > sPoints2;
+std::vector< glm::vec2 > sPoints2;
 
-VASEr::polyline_opt sOpts;
-VASEr::tessellator_opt sTessOpts;
+// sPoints is a ring buffer, the trail is drawn oldest first from here.
+std::vector< glm::vec2 > sTrail;
 
 PolyLine::PolyLine()
 {
-	memset( &sOpts, 0, sizeof( VASEr::polyline_opt ) );
-	memset( &sTessOpts, 0, sizeof( VASEr::tessellator_opt ) );
-
-	sOpts.tess = &sTessOpts;
-	sTessOpts.tessellate_only = true;
 }
 
 void PolyLine::Process( FrameTime t, Player* player)
@@ -55,7 +50,6 @@ void PolyLine::Process( FrameTime t, Player* player)
 	}
 
 	static const float screen_x = 500.0f;
-	static const int maxSamples = 200;
 	static const float x_scale = screen_x / (float)maxSamples;
 	static float accum = 0.0f;
 	static float sampleHz = 1.0f / 15.0f;
@@ -80,75 +74,15 @@ void PolyLine::Process( FrameTime t, Player* player)
 
 void PolyLine::Draw( Renderer* r ) const
 {
-	if (false && sPoints.size() >= 4)
+	if ( sPoints.size() >= 2 )
 	{
-		sOpts.cap = VASEr::PLC_round;
-		sOpts.feather = true;
-		sOpts.feathering = 1.0;
-		VASEr::VASErin::vertex_array_holder holder;
-		sTessOpts.holder = &holder;
-
-		const double weight = 3.0;
-		const VaseColor color = GlmToVaseColor(glm::vec4(245/255.0f, 121/255.0f, 79/255.0f, 1.0f));
-		//VASEr::segment( GlmToVaseVec2( sPoints[ 0 ] ), GlmToVaseVec2( sPoints[ 1 ] ), color, weight, &sOpts);
-
-		std::vector< VaseVec2 > stuff(sPoints.size());
-		std::vector< VaseColor > stuffColor(sPoints.size());
-		for (size_t i = 0; i < sPoints.size(); i++)
-		{
-			PROCYON_DEBUG("PolyLine", "sPoints[ %i ] <%f, %f>", i, sPoints[i].x, sPoints[i].y);
-			VaseVec2& d = stuff[i];
-			d.x = sPoints[i].x;
-			d.y = sPoints[i].y;
-
-			VaseColor& c = stuffColor[i];
-			c.r = (sPoints[i].x + 250.0f) / 250.0f;
-			c.g = (sPoints[i].y + 250.0f) / 250.0f;
-			c.b = 0.0;
-			c.a = 0.6f;
-		}
-		//VASEr::polyline( stuff.data(), stuffColor.data(), weight, stuff.size(), &sOpts );
+		sTrail.clear();
+		const size_t start = ( sPoints.size() == maxSamples ) ? sPointsStart % maxSamples : 0;
+		sTrail.insert( sTrail.end(), sPoints.begin() + start, sPoints.end() );
+		sTrail.insert( sTrail.end(), sPoints.begin(), sPoints.begin() + start );
 
-		VASEr::polybezier_opt bazOpts;
-		bazOpts.poly = &sOpts;
-		VASEr::polybezier(stuff.data(), color, weight, (int)stuff.size(), &bazOpts);
-
-		if (holder.glmode == GL_TRIANGLES)
-		{
-			PROCYON_DEBUG("PolyLine", "vertex_array_holder.vert %i mode: Triangles", holder.vert.size());
-
-			assert(holder.vert.size()/2 == holder.color.size()/4);
-			std::vector< ColorVertex > native(holder.vert.size()/2);
-			for (int i = 0; i < holder.vert.size()/2; i++)
-			{
-				ColorVertex& vert = native[i];
-				vert.position[0] = holder.vert[i * 2];
-				vert.position[1] = holder.vert[i * 2 + 1];
-				vert.color[0] = holder.color[i * 4];
-				vert.color[1] = holder.color[i * 4 + 1];
-				vert.color[2] = holder.color[i * 4 + 2];
-				vert.color[3] = holder.color[i * 4 + 3];
-			}
-
-			RenderCommand cmd;
-			cmd.op               = RENDER_OP_POLYGON;
-			cmd.flags            = 0;
-			cmd.colorprimmode    = PRIMITIVE_TRIANGLE;
-			cmd.colorverts       = (ColorVertex*)native.data();
-			cmd.colorvertcount   = (int)native.size();
-			r->GetRenderCore()->AddOrAppendCommand(cmd);
-		}
-		else
-		{
-			const char* mode = NULL;
-			switch (holder.glmode)
-			{
-			case GL_TRIANGLES: mode = "Triangles"; break;
-			case GL_TRIANGLE_STRIP: mode = "Triangle Strip"; break;
-			default: mode = "Other"; break;
-			}
-			PROCYON_DEBUG("PolyLine", "Not Triangles: vertex_array_holder.vert %i mode: %s", holder.vert.size(), mode);
-		}
+		const glm::vec4 color( 245 / 255.0f, 121 / 255.0f, 79 / 255.0f, 0.6f );
+		r->DrawPolyLine( sTrail, color, 3.0f, PolyLineJoinMode::ROUND, PolyLineCapMode::ROUND, 4.0f, false );
 	}
 }
 
@@ -31,8 +31,10 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 #include "Platform/Keyboard.h"
 #include "Platform/Mouse.h"
 #include "XmlMap.h"
+#include "Collision/BinaryMap.h"
 #include "SandboxAssets.h"
 
+
 static glm::vec2 PixelToWorld(const glm::ivec2& pixel, const glm::ivec2& winSize, const Camera2D* cam)
 {
 	return glm::vec2( glm::inverse( cam->GetViewProjection() ) *
@@ -45,8 +47,11 @@ Sandbox::Sandbox()
     , mPlayer( NULL )
     , mCamera( NULL )
     , mCustomMap( NULL )
+    , mCustomXmlMap( NULL )
 	, mFpsText( NULL )
 	, mWorld( NULL )
+	, mBodies( NULL )
+	, mParallelTiles( false )
 {
 }
 
@@ -54,20 +59,41 @@ void Sandbox::Initialize( int argc, char *argv[] )
 {
     SandboxAssets::Load();
 
-    if ( argc >= 2 )
+    // Sandbox [--pipelined] [map]
+    std::string mapPath;
+    for ( int i = 1; i < argc; i++ )
     {
-        mCustomMap = LoadMap( argv[ 1 ] );
+        if ( strcmp( argv[ i ], "--pipelined" ) == 0 )
+        {
+            SetPipelined( true );
+        }
+        else if ( mapPath.empty() )
+        {
+            mapPath = argv[ i ];
+        }
     }
 
     mWindow->SetIcon( *SandboxAssets::sWindowIcon );
 	mRenderer->SetClearColor( glm::vec4( 42.0f/225.0f, 47.0f/255.0f, 67.0f/255.0f, 1.0f ) );
+	mRenderer->GetRenderCore()->SetSortMode( RENDER_SORT_STATE );
+
+	// Deterministic steps for the bodies, drawn interpolated between them.
+	SetTimestepMode( TIMESTEP_FIXED );
+	SetFramePacing( FRAME_PACING_HYBRID );
 
 	// Create the tile map
 	mWorld = new World();
-	mWorld->LoadMap( ( mCustomMap ) ? mCustomMap : SandboxAssets::sMap );
+	if ( mapPath.empty() || !LoadMap( mapPath ) )
+	{
+		mWorld->LoadMap( SandboxAssets::sMap );
+	}
+
+	// Create the kinematic bodies, stepped against the world
+	mBodies = new BodySystem( mWorld );
+	mBodies->SetGravity( glm::vec2( 0.0f, PLAYER_GRAVITY ) );
 
 	// Create the player
-	mPlayer   = new Player( mWorld );
+	mPlayer   = new Player( mBodies );
 
 	// Create the background
 	Sprite* bg = new Sprite( SandboxAssets::sCityBgTexture );
@@ -115,6 +141,7 @@ void Sandbox::Initialize( int argc, char *argv[] )
     mCamera = new Camera2D();
 	mCamera->OrthographicProj( -SANDBOX_RESOLUTION_X / 2.0f, SANDBOX_RESOLUTION_X / 2.0f, -SANDBOX_RESOLUTION_Y / 2.0f, SANDBOX_RESOLUTION_Y / 2.0f );
 	mCamera->SetPosition( mPlayer->GetPosition() );
+	mCameraPosition = mPrevCameraPosition = mPlayer->GetPosition();
 	mScreenCamera = new Camera2D();
 	mScreenCamera->OrthographicProj( -SANDBOX_WINDOW_WIDTH / 2.0f, SANDBOX_WINDOW_WIDTH / 2.0f, -SANDBOX_WINDOW_HEIGHT / 2.0f, SANDBOX_WINDOW_HEIGHT / 2.0f );
 
@@ -135,9 +162,11 @@ void Sandbox::Cleanup()
 {
     delete mJoyStick;
     delete mPlayer;
+    delete mBodies;
     delete mCamera;
     delete mScreenCamera;
     delete mCustomMap;
+    delete mCustomXmlMap;
     SandboxAssets::Destroy();
 }
 
@@ -180,44 +209,68 @@ void Sandbox::Process( FrameTime t )
 		mPlayer->Jump();
 	}
 
+	if ( Keyboard::OnKeyDown( KEY_P ) )
+	{
+		mParallelTiles = !mParallelTiles;
+	}
+
     mPlayer->Process( t );
+	mBodies->Step( t.dt );
+	mPlayer->PostStep( t );
 
 	mPolyLine.Process( t, mPlayer );
 
 	// Move camera
 	glm::vec2 target = mPlayer->GetPosition() + glm::vec2(0.0f, CAMERA_VERTICAL_OFFSET);
-    mCamera->SetPosition( glm::floor( mCamera->GetPosition() * (1.0f - CAMERA_LERP_RATE) + target * CAMERA_LERP_RATE ) );
+	mPrevCameraPosition = mCameraPosition;
+    mCameraPosition = glm::floor( mCameraPosition * (1.0f - CAMERA_LERP_RATE) + target * CAMERA_LERP_RATE );
 
 	// Update fps text
 	mFpsText->SetText( BuildFPSString() );
 }
 
-void Sandbox::Render()
+void Sandbox::Render( float alpha )
 {
+	RenderCore* core = mRenderer->GetRenderCore();
+	mCamera->SetPosition( glm::floor( glm::mix( mPrevCameraPosition, mCameraPosition, alpha ) ) );
+
 	mRenderer->ResetCameras( *mScreenCamera );
 	mRenderer->PushCamera( *mCamera );
 
 	// Draw background sprites
+	core->SetLayer( SANDBOX_LAYER_BACKGROUND );
 	for ( auto iter : mBackground )
 	{
 		mRenderer->Draw( iter );
 	}
 
 	// Draw Tiles
-	mWorld->Render( mRenderer );
+	core->SetLayer( SANDBOX_LAYER_TILES );
+	if ( mParallelTiles )
+	{
+		RenderTileStrips( core );
+	}
+	else
+	{
+		mWorld->Render( mRenderer );
+	}
 
 	// Draw sprites
+	core->SetLayer( SANDBOX_LAYER_SPRITES );
 	for ( auto iter : mStaticSprites )
 	{
 		mRenderer->Draw( iter );
 	}
 
-	mPlayer->Draw( mRenderer );
+	core->SetLayer( SANDBOX_LAYER_PLAYER );
+	mPlayer->Draw( mRenderer, alpha );
 
 	mPolyLine.Draw( mRenderer );
 
 	mRenderer->PopCamera();
 
+	core->SetLayer( SANDBOX_LAYER_HUD );
+
 	mRenderer->DrawRectShape(
 		Mouse::GetPosition( mWindow ) * glm::ivec2( 1, -1 ),
 		glm::vec2( 5.0f ),
@@ -227,6 +280,33 @@ void Sandbox::Render()
 	mRenderer->Draw( mFpsText );
 }
 
+void Sandbox::RenderTileStrips( RenderCore* core )
+{
+	// Record each strip of columns on its own job into its own list...
+	const int columns = mWorld->GetSize().x;
+	const int stripWidth = ( columns + SANDBOX_TILE_STRIPS - 1 ) / SANDBOX_TILE_STRIPS;
+
+	JobCounter jobs[ SANDBOX_TILE_STRIPS ];
+	for ( int i = 0; i < SANDBOX_TILE_STRIPS; i++ )
+	{
+		RenderCommandList* list = &mTileStrips[ i ];
+		const int beginX = i * stripWidth;
+		mJobs.Push( [this, list, beginX, stripWidth]()
+		{
+			list->Clear();
+			list->SetLayer( SANDBOX_LAYER_TILES );
+			mWorld->RenderStrip( list, beginX, beginX + stripWidth );
+		}, &jobs[ i ] );
+	}
+
+	// ...then submit them in strip order so the frame is the same every run.
+	for ( int i = 0; i < SANDBOX_TILE_STRIPS; i++ )
+	{
+		mJobs.Wait( jobs[ i ] );
+		core->Submit( mTileStrips[ i ] );
+	}
+}
+
 void Sandbox::OnMouseMoved( const InputEvent& ev )
 {
 	glm::vec2 screenPos = glm::vec2( glm::inverse( mCamera->GetProjection() )
@@ -245,22 +325,42 @@ void Sandbox::OnWindowChanged( const InputEvent& ev )
 	mFpsText->SetPosition( 6.0f - ev.width / 2.0f, -ev.height / 2.0f );
 }
 
-Map* Sandbox::LoadMap( std::string filePath )
+bool Sandbox::LoadMap( const std::string& filePath )
 {
+    // .pmap files are BinaryMaps written by MapConvert, anything else is xml.
+    const std::string ext = ".pmap";
+    if ( filePath.size() > ext.size() && filePath.compare( filePath.size() - ext.size(), ext.size(), ext ) == 0 )
+    {
+        BinaryMap *map = new BinaryMap( filePath );
+        if ( !map->Load() )
+        {
+            delete map;
+            return false;
+        }
+        mWorld->LoadMap( map );
+        mCustomMap = map;
+        return true;
+    }
+
+    // Xml tiles go straight into the world, the map only keeps the TileSet.
     XmlMap *map = new XmlMap( filePath );
-    if ( !map->Load() )
+    if ( !map->Load( mWorld ) )
     {
         delete map;
-        return nullptr;
+        return false;
     }
-    return map;
+    mCustomXmlMap = map;
+    return true;
 }
 
 std::string Sandbox::BuildFPSString() const
 {
     const RenderFrameStats& stats = mRenderer->GetRenderCore()->GetFrameStats();
 	std::stringstream builder;
-    builder << "fps " << (int)mAvgFPS << " batches " << stats.batches << " quads " << stats.totalquads;
+    builder << "fps " << (int)mAvgFPS << ( IsPipelined() ? " pipelined" : "" ) << " batches " << stats.batches << " quads " << stats.totalquads;
     builder << " [min " << stats.batchmin << " max " << stats.batchmax << "]";
+    builder << " merged " << stats.sortmerges;
+    builder << " gl " << stats.statecallsissued << "/" << stats.statecallsissued + stats.statecallsskipped;
+    builder << " peak " << stats.peakcommands << "cmds/" << stats.peakvertexbytes / 1024 << "kb flushes+" << stats.autoflushes;
 	return builder.str();
 }
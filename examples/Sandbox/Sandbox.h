@@ -30,6 +30,7 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 #include "Platform/Joystick.h"
 #include "Graphics/Camera.h"
 #include "Graphics/Text.h"
+#include "Graphics/RenderCommandList.h"
 #include "Collision/World.h"
 #include "Player.h"
 #include "PolyLine.h"
@@ -38,6 +39,7 @@ namespace Procyon
 {
     class Map;
 	class Sprite;
+	class XmlMap;
 }
 
 using namespace Procyon::GL;
@@ -50,6 +52,16 @@ using namespace Procyon;
 #define CAMERA_VERTICAL_OFFSET 96.0f
 #define CAMERA_LERP_RATE 1.00f
 
+// RenderCore layers, drawn in ascending order
+#define SANDBOX_LAYER_BACKGROUND 0
+#define SANDBOX_LAYER_TILES 1
+#define SANDBOX_LAYER_SPRITES 2
+#define SANDBOX_LAYER_PLAYER 3
+#define SANDBOX_LAYER_HUD 4
+
+// Tile columns are recorded by this many jobs in parallel
+#define SANDBOX_TILE_STRIPS 4
+
 class Sandbox : public MainLoop
 {
 public:
@@ -59,28 +71,37 @@ public:
     virtual void    Cleanup();
 
     virtual void    Process( FrameTime t );
-    virtual void    Render();
+    virtual void    Render( float alpha );
 
     virtual void    OnMouseMoved( const InputEvent& ev );
 
     virtual void    OnWindowChanged( const InputEvent& ev );
 
 protected:
-    Map*            LoadMap( std::string filePath );
+    bool            LoadMap( const std::string& filePath );
 	std::string 	BuildFPSString() const;
+	void 			RenderTileStrips( RenderCore* core );
 
     IJoystick*      mJoyStick;
     Player*         mPlayer;
     Camera2D*       mCamera;
+	glm::vec2 		mCameraPosition; 		// as of the last tick
+	glm::vec2 		mPrevCameraPosition; 	// as of the tick before
     Camera2D*       mScreenCamera;
     Map*            mCustomMap;
+    XmlMap*         mCustomXmlMap;
 	Text*           mFpsText;
 	PolyLine		mPolyLine;
 	World*          mWorld;
+	BodySystem*     mBodies;
 
 	std::vector< Procyon::Sprite* > mBackground;
 	std::vector< Procyon::Sprite* > mStaticSprites;
 
+	// P toggles between chunked tiles and recording them in parallel strips
+	bool 			mParallelTiles;
+	RenderCommandList mTileStrips[ SANDBOX_TILE_STRIPS ];
+
 };
 
 #endif /* _SANDBOX_H */
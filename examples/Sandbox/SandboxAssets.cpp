@@ -61,12 +61,13 @@ TileSet SandboxMap::sTileSet;
 FontFace*       SandboxAssets::sMainFont        = NULL;
 Map*            SandboxAssets::sMap             = NULL;
 IImage*         SandboxAssets::sWindowIcon      = NULL;
-Texture*		SandboxAssets::sPlayerTexture   = NULL;
-Texture*		SandboxAssets::sDumpsterTexture   = NULL;
-Texture*		SandboxAssets::sLightPostTexture   = NULL;
-Texture*		SandboxAssets::sLightPostBeamTexture   = NULL;
-Texture*		SandboxAssets::sCityBgTexture   = NULL;
-Texture*		SandboxAssets::sCityBg2Texture   = NULL;
+TextureAtlas*	SandboxAssets::sSpriteAtlas     = NULL;
+AtlasRegion		SandboxAssets::sPlayerTexture;
+AtlasRegion		SandboxAssets::sDumpsterTexture;
+AtlasRegion		SandboxAssets::sLightPostTexture;
+AtlasRegion		SandboxAssets::sLightPostBeamTexture;
+AtlasRegion		SandboxAssets::sCityBgTexture;
+AtlasRegion		SandboxAssets::sCityBg2Texture;
 Texture*		SandboxAssets::sTileTexture     = NULL;
 Texture*		SandboxAssets::sTestTexture     = NULL;
 SoundBuffer*    SandboxAssets::sJumpSound       = NULL;
@@ -75,12 +76,23 @@ void SandboxAssets::Load()
 {
 	sMainFont 		= new FontFace( "fonts/arial.ttf", 20);
     sWindowIcon     = new FileImage( "sprites/tile.png" );
-    sPlayerTexture  = Texture::Allocate( "sprites/Raccoon_Spritesheet.png" );
-    sDumpsterTexture  = Texture::Allocate( "sprites/dumpster.png" );
-    sLightPostTexture  = Texture::Allocate( "sprites/lightpole_Post.png" );
-    sLightPostBeamTexture  = Texture::Allocate( "sprites/lightpole_Light.png" );
-	sCityBgTexture  = Texture::Allocate( "sprites/buildings.png" );
-	sCityBg2Texture  = Texture::Allocate( "sprites/dirty-cement.png" );
+
+    // Share one page between the scene sprites so they batch together.
+    sSpriteAtlas    = new TextureAtlas();
+    TextureAtlas::RegionId player       = sSpriteAtlas->Add( "sprites/Raccoon_Spritesheet.png" );
+    TextureAtlas::RegionId dumpster     = sSpriteAtlas->Add( "sprites/dumpster.png" );
+    TextureAtlas::RegionId lightpost    = sSpriteAtlas->Add( "sprites/lightpole_Post.png" );
+    TextureAtlas::RegionId beam         = sSpriteAtlas->Add( "sprites/lightpole_Light.png" );
+    TextureAtlas::RegionId citybg       = sSpriteAtlas->Add( "sprites/buildings.png" );
+    TextureAtlas::RegionId citybg2      = sSpriteAtlas->Add( "sprites/dirty-cement.png" );
+    sSpriteAtlas->Build();
+    sPlayerTexture          = sSpriteAtlas->GetRegion( player );
+    sDumpsterTexture        = sSpriteAtlas->GetRegion( dumpster );
+    sLightPostTexture       = sSpriteAtlas->GetRegion( lightpost );
+    sLightPostBeamTexture   = sSpriteAtlas->GetRegion( beam );
+    sCityBgTexture          = sSpriteAtlas->GetRegion( citybg );
+    sCityBg2Texture         = sSpriteAtlas->GetRegion( citybg2 );
+
     sTileTexture    = Texture::Allocate( "sprites/tile.png" );
     sTestTexture    = Texture::Allocate( "tinyTest.png" );
     sJumpSound      =  new SoundBuffer( "audio/jump4.wav" );
@@ -98,8 +110,7 @@ void SandboxAssets::Destroy()
 	delete sMainFont;
 	delete sMap;
     delete sWindowIcon;
-    delete sPlayerTexture;
-    delete sDumpsterTexture;
+    delete sSpriteAtlas;
     delete sTileTexture;
     delete sTestTexture;
     delete sJumpSound;
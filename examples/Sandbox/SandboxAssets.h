@@ -27,6 +27,7 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "Graphics/FontFace.h"
 #include "Graphics/Texture.h"
+#include "Graphics/TextureAtlas.h"
 #include "Collision/World.h"
 #include "Audio/SoundBuffer.h"
 
@@ -36,12 +37,13 @@ public:
 	static Procyon::FontFace*		sMainFont;
 	static Procyon::Map* 			sMap;
     static Procyon::IImage*			sWindowIcon;
-    static Procyon::Texture*		sPlayerTexture;
-    static Procyon::Texture*		sDumpsterTexture;
-	static Procyon::Texture*		sLightPostTexture;
-	static Procyon::Texture*		sLightPostBeamTexture;
-	static Procyon::Texture*		sCityBgTexture;
-	static Procyon::Texture*		sCityBg2Texture;
+    static Procyon::TextureAtlas*	sSpriteAtlas;
+    static Procyon::AtlasRegion		sPlayerTexture;
+    static Procyon::AtlasRegion		sDumpsterTexture;
+	static Procyon::AtlasRegion		sLightPostTexture;
+	static Procyon::AtlasRegion		sLightPostBeamTexture;
+	static Procyon::AtlasRegion		sCityBgTexture;
+	static Procyon::AtlasRegion		sCityBg2Texture;
     static Procyon::Texture*		sTileTexture;
     static Procyon::Texture*		sTestTexture;
     static Procyon::SoundBuffer*	sJumpSound;
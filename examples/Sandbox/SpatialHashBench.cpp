@@ -0,0 +1,137 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+/*
+================
+SpatialHashBench
+
+Moves 10k boxes around a bounded area, updating a SpatialHash and
+enumerating overlapping pairs each frame.
+
+	SpatialHashBench [boxes] [frames]
+================
+*/
+
+#include "ProcyonCommon.h"
+#include "Collision/SpatialHash.h"
+
+#include <chrono>
+
+using namespace Procyon;
+
+#define BENCH_AREA 		4096.0f
+#define BENCH_CELL_SIZE 32.0f
+
+typedef std::chrono::high_resolution_clock Clock;
+
+static double Milliseconds( Clock::time_point start, Clock::time_point end )
+{
+	return std::chrono::duration< double, std::milli >( end - start ).count();
+}
+
+static int Run( int count, int frames )
+{
+	std::vector< Aabb > boxes;
+	std::vector< glm::vec2 > velocities;
+	std::vector< ProxyId > ids;
+	SpatialHash hash( BENCH_CELL_SIZE );
+
+	srand( 1 );
+	for ( int i = 0; i < count; i++ )
+	{
+		const float half = 4.0f + rand() % 12;
+		boxes.push_back( Aabb( rand() * BENCH_AREA / RAND_MAX, rand() * BENCH_AREA / RAND_MAX, half, half ) );
+		velocities.push_back( glm::vec2( rand() % 129 - 64, rand() % 129 - 64 ) );
+		ids.push_back( hash.Insert( boxes.back() ) );
+	}
+
+	std::vector< ProxyPair > pairs;
+	double updateMs = 0.0;
+	double pairsMs = 0.0;
+	size_t totalPairs = 0;
+	const float dt = 1.0f / 60.0f;
+	for ( int frame = 0; frame < frames; frame++ )
+	{
+		const Clock::time_point start = Clock::now();
+		for ( int i = 0; i < count; i++ )
+		{
+			glm::vec2& c = boxes[ i ].mCenter;
+			c += velocities[ i ] * dt;
+			if ( c.x < 0.0f || c.x > BENCH_AREA ) velocities[ i ].x = -velocities[ i ].x;
+			if ( c.y < 0.0f || c.y > BENCH_AREA ) velocities[ i ].y = -velocities[ i ].y;
+			hash.Update( ids[ i ], boxes[ i ] );
+		}
+
+		const Clock::time_point updated = Clock::now();
+		pairs.clear();
+		hash.FindPairs( pairs );
+		const Clock::time_point found = Clock::now();
+
+		updateMs += Milliseconds( start, updated );
+		pairsMs += Milliseconds( updated, found );
+		totalPairs += pairs.size();
+	}
+
+	// Check the last frame against every pair tested directly.
+	size_t bruteForce = 0;
+	const Clock::time_point bruteStart = Clock::now();
+	for ( int i = 0; i < count; i++ )
+	{
+		for ( int j = i + 1; j < count; j++ )
+		{
+			const glm::vec2 d = glm::abs( boxes[ i ].mCenter - boxes[ j ].mCenter );
+			const glm::vec2 r = boxes[ i ].mHalfExtent + boxes[ j ].mHalfExtent;
+			bruteForce += ( d.x < r.x && d.y < r.y ) ? 1 : 0;
+		}
+	}
+	const double bruteMs = Milliseconds( bruteStart, Clock::now() );
+
+	printf( "%d boxes, %d frames, %.1f pairs/frame\n", count, frames, (double)totalPairs / frames );
+	printf( "update     %8.3f ms/frame\n", updateMs / frames );
+	printf( "pairs      %8.3f ms/frame  %12.0f pairs/sec\n", pairsMs / frames, totalPairs / ( pairsMs / 1000.0 ) );
+	printf( "brute      %8.3f ms        (%zu pairs, hash found %zu)\n", bruteMs, bruteForce, pairs.size() );
+	return ( bruteForce == pairs.size() ) ? 0 : 1;
+}
+
+int main( int argc, char *argv[] )
+{
+	const int count = ( argc > 1 ) ? atoi( argv[ 1 ] ) : 10000;
+	const int frames = ( argc > 2 ) ? atoi( argv[ 2 ] ) : 300;
+	if ( count <= 0 || frames <= 0 )
+	{
+		fprintf( stderr, "usage: %s [boxes] [frames]\n", argv[ 0 ] );
+		return 1;
+	}
+
+	int result = 0;
+	LOGOG_INITIALIZE();
+	{
+		logog::Cout err;
+		result = Run( count, frames );
+	}
+	LOGOG_SHUTDOWN();
+
+	return result;
+}
@@ -27,27 +27,33 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "ProcyonCommon.h"
 #include "Collision/World.h"
+#include "Collision/XmlMapReader.h"
 
 namespace Procyon {
 
-	class XmlMap : public Map
+	// Streams an xml map's tiles straight into a World, only the TileSet is
+	// kept here and it must outlive the world.
+	class XmlMap : protected XmlMapReader
 	{
 	public:
-		XmlMap( const std::string& filePath );
+		XmlMap( const std::string& filePath, bool loadTextures = true );
 
 		const std::string& GetFilePath() const { return mFilePath; }
 
-		bool Load();
+		// Leaves world empty on failure.
+		bool Load( World* world );
 
-		virtual TileId GetTile( int x, int y ) const;
-		virtual const TileSet* GetTileSet() const { return &mTileSet; }
-        virtual glm::ivec2 GetSize() const { return mSize; }
+		const TileSet* GetTileSet() const { return &mTileSet; }
 
 	protected:
+		virtual void OnTileDef( const TileDef& def );
+		virtual bool OnTilesBegin( const glm::ivec2& size );
+		virtual void OnTile( int x, int y, TileId tile );
+
 		std::string             mFilePath;
+		bool 					mLoadTextures;
 		TileSet 	            mTileSet;
-        glm::ivec2              mSize;
-        std::vector< TileId >   mTiles;
+		World* 					mWorld; // only during Load()
 	};
 
 } /* namespace Procyon */
@@ -1,6 +0,0 @@
-class backend
-{
-public:
-	static void vah_draw(vertex_array_holder& vah);
-	static void polyline( const Vec2*, Color, double W, int length, const polyline_opt*); //constant color and weight
-};
@@ -0,0 +1,301 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "BinaryMap.h"
+#include "Graphics/Texture.h"
+
+#define CHUNK_AREA ( WORLD_CHUNK_TILES * WORLD_CHUNK_TILES )
+
+namespace Procyon {
+
+	BinaryMap::BinaryMap( const std::string& filePath, bool loadTextures /* = true */ )
+		: mFilePath( filePath )
+		, mLoadTextures( loadTextures )
+	{
+	}
+
+	BinaryMap::~BinaryMap()
+	{
+		Unload();
+	}
+
+	bool BinaryMap::Load()
+	{
+		Unload();
+
+		if ( !mFile.Open( mFilePath ) )
+			return false;
+
+		if ( !Parse() )
+		{
+			PROCYON_WARN( "BinaryMap", "Malformed map file '%s'", mFilePath.c_str() );
+			Unload();
+			return false;
+		}
+
+		PROCYON_DEBUG( "BinaryMap", "Loaded '%s'. Width: %i Height: %i Decoded: %i tiles."
+			, mFilePath.c_str(), mSize.x, mSize.y, (int)mDecoded.size() );
+		return true;
+	}
+
+	bool BinaryMap::Parse()
+	{
+		const unsigned char* data = mFile.GetData();
+		const size_t size = mFile.GetSize();
+		auto inRange = [size]( size_t offset, size_t bytes ) { return offset <= size && bytes <= size - offset; };
+
+		BinaryMapHeader header;
+		if ( !inRange( 0, sizeof( header ) ) )
+			return false;
+		memcpy( &header, data, sizeof( header ) );
+
+		if ( header.magic != BINARY_MAP_MAGIC || header.version != BINARY_MAP_VERSION )
+			return false;
+
+		if ( header.chunkTiles != WORLD_CHUNK_TILES )
+		{
+			PROCYON_WARN( "BinaryMap", "Chunk size %i does not match WORLD_CHUNK_TILES, re-export the map.", header.chunkTiles );
+			return false;
+		}
+
+		if ( header.width <= 0 || header.height <= 0 )
+			return false;
+
+		mSize = glm::ivec2( header.width, header.height );
+		mChunkCount = ( mSize + WORLD_CHUNK_TILES - 1 ) / WORLD_CHUNK_TILES;
+
+		// Tile defs
+		const char* strings = (const char*)data + header.stringOffset;
+		if ( !inRange( header.stringOffset, header.stringBytes )
+			|| !inRange( header.tileDefOffset, (size_t)header.tileDefCount * sizeof( BinaryMapTileDef ) ) )
+			return false;
+
+		for ( uint32_t i = 0; i < header.tileDefCount; i++ )
+		{
+			BinaryMapTileDef in;
+			memcpy( &in, data + header.tileDefOffset + i * sizeof( in ), sizeof( in ) );
+			if ( in.filepath >= header.stringBytes || !memchr( strings + in.filepath, 0, header.stringBytes - in.filepath ) )
+				return false;
+
+			TileDef def;
+			def.filepath 	= strings + in.filepath;
+			def.type 		= (TileType)in.type;
+			def.collidable 	= in.collidable != 0;
+			if ( mLoadTextures && !def.filepath.empty() )
+			{
+				def.texture = Texture::Allocate( def.filepath );
+			}
+			mTileSet.AddTileDef( def );
+		}
+
+		// Chunks, raw ones are used in place.
+		const size_t chunkCount = (size_t)mChunkCount.x * mChunkCount.y;
+		if ( !inRange( header.chunkOffset, chunkCount * sizeof( BinaryMapChunk ) ) )
+			return false;
+
+		mChunks.assign( chunkCount, NULL );
+		std::vector< size_t > decodedAt( chunkCount, 0 );
+		for ( size_t i = 0; i < chunkCount; i++ )
+		{
+			BinaryMapChunk chunk;
+			memcpy( &chunk, data + header.chunkOffset + i * sizeof( chunk ), sizeof( chunk ) );
+			if ( !inRange( chunk.offset, chunk.bytes ) || ( chunk.offset % sizeof( TileId ) ) != 0 )
+				return false;
+
+			switch ( chunk.encoding )
+			{
+				case BINARY_CHUNK_RAW:
+				{
+					if ( chunk.bytes != CHUNK_AREA * sizeof( TileId ) )
+						return false;
+
+					const TileId* tiles = (const TileId*)( data + chunk.offset );
+					for ( size_t t = 0; t < CHUNK_AREA; t++ )
+					{
+						if ( tiles[ t ] > header.tileDefCount )
+							return false;
+					}
+					mChunks[ i ] = tiles;
+					break;
+				}
+				case BINARY_CHUNK_RLE:
+				{
+					if ( chunk.bytes % ( 2 * sizeof( uint32_t ) ) != 0 )
+						return false;
+
+					decodedAt[ i ] = mDecoded.size();
+					const uint32_t* run = (const uint32_t*)( data + chunk.offset );
+					const uint32_t* runEnd = run + chunk.bytes / sizeof( uint32_t );
+					for ( ; run != runEnd; run += 2 )
+					{
+						if ( run[ 0 ] > CHUNK_AREA - ( mDecoded.size() - decodedAt[ i ] ) || run[ 1 ] > header.tileDefCount )
+							return false;
+						mDecoded.insert( mDecoded.end(), run[ 0 ], run[ 1 ] );
+					}
+
+					if ( mDecoded.size() - decodedAt[ i ] != CHUNK_AREA )
+						return false;
+					break;
+				}
+				default: return false;
+			}
+		}
+
+		// mDecoded is final now, point the RLE chunks into it.
+		for ( size_t i = 0; i < chunkCount; i++ )
+		{
+			if ( !mChunks[ i ] )
+			{
+				mChunks[ i ] = &mDecoded[ decodedAt[ i ] ];
+			}
+		}
+
+		return true;
+	}
+
+	void BinaryMap::Unload()
+	{
+		for ( int id = 1; id < mTileSet.Size(); id++ )
+		{
+			delete mTileSet.GetTileDef( id ).texture;
+		}
+		mTileSet.Clear();
+
+		mChunks.clear();
+		mDecoded.clear();
+		mSize = glm::ivec2();
+		mChunkCount = glm::ivec2();
+		mFile.Close();
+	}
+
+	TileId BinaryMap::GetTile( int x, int y ) const
+	{
+		const TileId* chunk = mChunks[ ( y / WORLD_CHUNK_TILES ) * mChunkCount.x + x / WORLD_CHUNK_TILES ];
+		return chunk[ ( x % WORLD_CHUNK_TILES ) * WORLD_CHUNK_TILES + y % WORLD_CHUNK_TILES ];
+	}
+
+	const TileId* BinaryMap::GetChunk( const glm::ivec2& chunk ) const
+	{
+		if ( chunk.x < 0 || chunk.x >= mChunkCount.x || chunk.y < 0 || chunk.y >= mChunkCount.y )
+			return NULL;
+		return mChunks[ chunk.y * mChunkCount.x + chunk.x ];
+	}
+
+	/* static */ bool BinaryMap::Write( const std::string& filePath, const Map& map, bool compress /* = true */ )
+	{
+		const glm::ivec2 size = map.GetSize();
+		const glm::ivec2 chunkCount = ( size + WORLD_CHUNK_TILES - 1 ) / WORLD_CHUNK_TILES;
+		const TileSet* tileSet = map.GetTileSet();
+		const uint32_t tileDefCount = ( tileSet ) ? (uint32_t)( tileSet->Size() - 1 ) : 0;
+
+		// Tile defs and their strings
+		std::vector< BinaryMapTileDef > tileDefs( tileDefCount );
+		std::vector< char > strings;
+		for ( uint32_t i = 0; i < tileDefCount; i++ )
+		{
+			const TileDef& def = tileSet->GetTileDef( i + 1 );
+			tileDefs[ i ].filepath 		= (uint32_t)strings.size();
+			tileDefs[ i ].type 			= (uint8_t)def.type;
+			tileDefs[ i ].collidable 	= ( def.collidable ) ? 1 : 0;
+			tileDefs[ i ].reserved 		= 0;
+			strings.insert( strings.end(), def.filepath.begin(), def.filepath.end() );
+			strings.push_back( '\0' );
+		}
+		strings.resize( ( strings.size() + 3 ) & ~(size_t)3, '\0' );
+
+		BinaryMapHeader header;
+		header.magic 			= BINARY_MAP_MAGIC;
+		header.version 			= BINARY_MAP_VERSION;
+		header.width 			= size.x;
+		header.height 			= size.y;
+		header.chunkTiles 		= WORLD_CHUNK_TILES;
+		header.tileDefCount 	= tileDefCount;
+		header.tileDefOffset 	= sizeof( BinaryMapHeader );
+		header.chunkOffset 		= header.tileDefOffset + tileDefCount * sizeof( BinaryMapTileDef );
+		header.stringOffset 	= header.chunkOffset + chunkCount.x * chunkCount.y * sizeof( BinaryMapChunk );
+		header.stringBytes 		= (uint32_t)strings.size();
+		const uint32_t dataOffset = header.stringOffset + header.stringBytes;
+
+		// Chunk data, everything in it is 32 bit so alignment comes for free.
+		std::vector< BinaryMapChunk > chunks;
+		std::vector< uint32_t > payload;
+		std::vector< TileId > tiles( CHUNK_AREA );
+		std::vector< uint32_t > runs;
+		for ( int cy = 0; cy < chunkCount.y; cy++ )
+		{
+			for ( int cx = 0; cx < chunkCount.x; cx++ )
+			{
+				for ( int i = 0; i < CHUNK_AREA; i++ )
+				{
+					const int x = cx * WORLD_CHUNK_TILES + i / WORLD_CHUNK_TILES;
+					const int y = cy * WORLD_CHUNK_TILES + i % WORLD_CHUNK_TILES;
+					tiles[ i ] = ( x < size.x && y < size.y ) ? map.GetTile( x, y ) : 0;
+				}
+
+				runs.clear();
+				for ( int i = 0; i < CHUNK_AREA; i++ )
+				{
+					if ( !runs.empty() && runs.back() == tiles[ i ] )
+					{
+						runs[ runs.size() - 2 ]++;
+						continue;
+					}
+					runs.push_back( 1 );
+					runs.push_back( tiles[ i ] );
+				}
+
+				BinaryMapChunk chunk;
+				chunk.offset 	= dataOffset + (uint32_t)( payload.size() * sizeof( uint32_t ) );
+				chunk.reserved 	= 0;
+				if ( compress && runs.size() < tiles.size() )
+				{
+					chunk.encoding = BINARY_CHUNK_RLE;
+					payload.insert( payload.end(), runs.begin(), runs.end() );
+				}
+				else
+				{
+					chunk.encoding = BINARY_CHUNK_RAW;
+					payload.insert( payload.end(), tiles.begin(), tiles.end() );
+				}
+				chunk.bytes = dataOffset + (uint32_t)( payload.size() * sizeof( uint32_t ) ) - chunk.offset;
+				chunks.push_back( chunk );
+			}
+		}
+
+		std::ofstream out( filePath, std::ios::binary | std::ios::out | std::ios::trunc );
+		if ( !out )
+		{
+			PROCYON_WARN( "BinaryMap", "Unable to open '%s' for writing.", filePath.c_str() );
+			return false;
+		}
+
+		out.write( (const char*)&header, sizeof( header ) );
+		out.write( (const char*)tileDefs.data(), tileDefs.size() * sizeof( BinaryMapTileDef ) );
+		out.write( (const char*)chunks.data(), chunks.size() * sizeof( BinaryMapChunk ) );
+		out.write( strings.data(), strings.size() );
+		out.write( (const char*)payload.data(), payload.size() * sizeof( uint32_t ) );
+		return out.good();
+	}
+
+} /* namespace Procyon */
@@ -0,0 +1,134 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _BINARY_MAP_H
+#define _BINARY_MAP_H
+
+#include "ProcyonCommon.h"
+#include "World.h"
+#include "Platform/MappedFile.h"
+
+#define BINARY_MAP_MAGIC 	0x50414D50 // "PMAP"
+#define BINARY_MAP_VERSION 	1
+
+namespace Procyon {
+
+	/*
+	================
+	Binary map format (.pmap)
+
+	Little endian, every offset is in bytes from the start of the file and
+	4 byte aligned.
+
+		BinaryMapHeader
+		BinaryMapTileDef 	[ tileDefCount ]
+		BinaryMapChunk 		[ chunksX * chunksY ], row major by chunk
+		string table 		NUL terminated tile def filepaths
+		chunk data
+
+	A chunk covers chunkTiles squared tiles stored column major, zero padded
+	past the map edge. BINARY_CHUNK_RAW data is the TileId array itself,
+	BINARY_CHUNK_RLE data is ( uint32 count, TileId id ) runs over it.
+	================
+	*/
+	enum BinaryMapChunkEncoding
+	{
+		BINARY_CHUNK_RAW,
+		BINARY_CHUNK_RLE
+	};
+
+	struct BinaryMapHeader
+	{
+		uint32_t 	magic;
+		uint32_t 	version;
+		int32_t 	width;
+		int32_t 	height;
+		int32_t 	chunkTiles;
+		uint32_t 	tileDefCount;
+		uint32_t 	tileDefOffset;
+		uint32_t 	chunkOffset;
+		uint32_t 	stringOffset;
+		uint32_t 	stringBytes;
+	};
+
+	struct BinaryMapTileDef
+	{
+		uint32_t 	filepath; 	// string table offset
+		uint8_t 	type; 		// TileType
+		uint8_t 	collidable;
+		uint16_t 	reserved;
+	};
+
+	struct BinaryMapChunk
+	{
+		uint32_t 	offset;
+		uint32_t 	bytes;
+		uint32_t 	encoding; 	// BinaryMapChunkEncoding
+		uint32_t 	reserved;
+	};
+
+	/*
+	================
+	BinaryMap
+
+	Map backed by a memory mapped .pmap file. Raw chunks are served straight
+	out of the mapping, only RLE chunks are decoded at Load(). Keep the map
+	alive as long as anything reads from it.
+	================
+	*/
+	class BinaryMap : public Map
+	{
+	public:
+								BinaryMap( const std::string& filePath, bool loadTextures = true );
+								~BinaryMap();
+
+		const std::string& 		GetFilePath() const { return mFilePath; }
+
+		bool 					Load();
+
+		virtual TileId 			GetTile( int x, int y ) const;
+		virtual const TileSet* 	GetTileSet() const { return &mTileSet; }
+		virtual glm::ivec2 		GetSize() const { return mSize; }
+		virtual const TileId* 	GetChunk( const glm::ivec2& chunk ) const;
+
+		// Serialize map, RLE encoding chunks where that is smaller.
+		static bool 			Write( const std::string& filePath, const Map& map, bool compress = true );
+
+	protected:
+		bool 					Parse();
+		void 					Unload();
+
+		std::string 				mFilePath;
+		bool 						mLoadTextures;
+		MappedFile 					mFile;
+		TileSet 					mTileSet;
+		glm::ivec2 					mSize;
+		glm::ivec2 					mChunkCount;
+		std::vector< const TileId* > mChunks;
+		std::vector< TileId > 		mDecoded; // RLE chunks
+	};
+
+} /* namespace Procyon */
+
+#endif /* _BINARY_MAP_H */
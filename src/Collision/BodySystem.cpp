@@ -0,0 +1,303 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "BodySystem.h"
+#include "Collide.h"
+#include "Contact.h"
+
+namespace Procyon {
+
+	BodySystem::BodySystem( const World* world )
+		: mWorld( world )
+	{
+	}
+
+	BodyId BodySystem::Add( const Aabb& bounds, float gravityScale /* = 1.0f */ )
+	{
+		BodyId id;
+		if ( !mFreeIds.empty() )
+		{
+			id = mFreeIds.back();
+			mFreeIds.pop_back();
+		}
+		else
+		{
+			id = (BodyId)mIndex.size();
+			mIndex.push_back( -1 );
+		}
+
+		mIndex[ id ] = (int)mIds.size();
+		mCenterX.push_back( bounds.mCenter.x );
+		mCenterY.push_back( bounds.mCenter.y );
+		mHalfX.push_back( bounds.mHalfExtent.x );
+		mHalfY.push_back( bounds.mHalfExtent.y );
+		mVelX.push_back( 0.0f );
+		mVelY.push_back( 0.0f );
+		mDeltaX.push_back( 0.0f );
+		mDeltaY.push_back( 0.0f );
+		mGravityScale.push_back( gravityScale );
+		mMaxSpeedX.push_back( std::numeric_limits< float >::max() );
+		mMaxSpeedY.push_back( std::numeric_limits< float >::max() );
+		mFlags.push_back( 0 );
+		mIds.push_back( id );
+		return id;
+	}
+
+	template< typename T >
+	static void SwapRemove( std::vector< T >& v, int i )
+	{
+		v[ i ] = v.back();
+		v.pop_back();
+	}
+
+	void BodySystem::Remove( BodyId id )
+	{
+		const int i = mIndex[ id ];
+		assert( i >= 0 );
+
+		mIndex[ mIds.back() ] = i;
+		mIndex[ id ] = -1;
+		mFreeIds.push_back( id );
+
+		SwapRemove( mCenterX, i );
+		SwapRemove( mCenterY, i );
+		SwapRemove( mHalfX, i );
+		SwapRemove( mHalfY, i );
+		SwapRemove( mVelX, i );
+		SwapRemove( mVelY, i );
+		SwapRemove( mDeltaX, i );
+		SwapRemove( mDeltaY, i );
+		SwapRemove( mGravityScale, i );
+		SwapRemove( mMaxSpeedX, i );
+		SwapRemove( mMaxSpeedY, i );
+		SwapRemove( mFlags, i );
+		SwapRemove( mIds, i );
+	}
+
+	void BodySystem::Clear()
+	{
+		mCenterX.clear();
+		mCenterY.clear();
+		mHalfX.clear();
+		mHalfY.clear();
+		mVelX.clear();
+		mVelY.clear();
+		mDeltaX.clear();
+		mDeltaY.clear();
+		mGravityScale.clear();
+		mMaxSpeedX.clear();
+		mMaxSpeedY.clear();
+		mFlags.clear();
+		mIds.clear();
+		mIndex.clear();
+		mFreeIds.clear();
+	}
+
+	void BodySystem::Step( float dt )
+	{
+		if ( dt <= 0.0f )
+			return;
+
+		Integrate( dt );
+
+		for ( int i = 0; i < GetCount(); i++ )
+		{
+			mFlags[ i ] &= ~BODY_GROUNDED;
+			if ( mWorld )
+			{
+				Sweep( i );
+				ResolveOverlaps( i );
+			}
+			else
+			{
+				mCenterX[ i ] += mDeltaX[ i ];
+				mCenterY[ i ] += mDeltaY[ i ];
+			}
+		}
+	}
+
+	void BodySystem::Integrate( float dt )
+	{
+		const int count = GetCount();
+		const float gx = mGravity.x * dt;
+		const float gy = mGravity.y * dt;
+
+		float* RESTRICT velX = mVelX.data();
+		float* RESTRICT velY = mVelY.data();
+		float* RESTRICT deltaX = mDeltaX.data();
+		float* RESTRICT deltaY = mDeltaY.data();
+		const float* RESTRICT scale = mGravityScale.data();
+		const float* RESTRICT maxX = mMaxSpeedX.data();
+		const float* RESTRICT maxY = mMaxSpeedY.data();
+		for ( int i = 0; i < count; i++ )
+		{
+			velX[ i ] = glm::clamp( velX[ i ] + gx * scale[ i ], -maxX[ i ], maxX[ i ] );
+			velY[ i ] = glm::clamp( velY[ i ] + gy * scale[ i ], -maxY[ i ], maxY[ i ] );
+			deltaX[ i ] = velX[ i ] * dt;
+			deltaY[ i ] = velY[ i ] * dt;
+		}
+	}
+
+	void BodySystem::Sweep( int i )
+	{
+		Aabb bounds( mCenterX[ i ], mCenterY[ i ], mHalfX[ i ], mHalfY[ i ] );
+		glm::vec2 velocity( mVelX[ i ], mVelY[ i ] );
+		glm::vec2 remaining( mDeltaX[ i ], mDeltaY[ i ] );
+
+		for ( int iter = 0; iter < BODY_SWEEP_ITERATIONS && remaining != glm::vec2( 0.0f ); iter++ )
+		{
+			SweepHit hit;
+			if ( !mWorld->SweepAabb( bounds, remaining, hit ) )
+			{
+				bounds.mCenter += remaining;
+				break;
+			}
+
+			bounds.mCenter += remaining * hit.time;
+			remaining *= 1.0f - hit.time;
+			remaining -= hit.normal * glm::dot( remaining, hit.normal );
+
+			const float normVel = glm::dot( velocity, hit.normal );
+			if ( normVel < 0.0f )
+			{
+				velocity -= hit.normal * normVel;
+			}
+			if ( hit.normal.y > 0.0f )
+			{
+				mFlags[ i ] |= BODY_GROUNDED;
+			}
+		}
+
+		// Keep the step actually taken for the one way checks.
+		mDeltaX[ i ] = bounds.mCenter.x - mCenterX[ i ];
+		mDeltaY[ i ] = bounds.mCenter.y - mCenterY[ i ];
+		mCenterX[ i ] = bounds.mCenter.x;
+		mCenterY[ i ] = bounds.mCenter.y;
+		mVelX[ i ] = velocity.x;
+		mVelY[ i ] = velocity.y;
+	}
+
+	void BodySystem::ResolveOverlaps( int i )
+	{
+		const Aabb bounds( mCenterX[ i ], mCenterY[ i ], mHalfX[ i ], mHalfY[ i ] );
+		const glm::vec2 delta( mDeltaX[ i ], mDeltaY[ i ] );
+
+		mScratchTiles.clear();
+		mWorld->TileIntersection( bounds, mScratchTiles );
+
+		// Largest push out in each direction, so two tiles sharing a face
+		// don't push twice.
+		glm::vec2 pushMin( 0.0f );
+		glm::vec2 pushMax( 0.0f );
+		glm::vec2 velocity( mVelX[ i ], mVelY[ i ] );
+
+		TileBatch batch;
+		float normalX[ TILE_BATCH_SIZE ];
+		float normalY[ TILE_BATCH_SIZE ];
+		float distance[ TILE_BATCH_SIZE ];
+		for ( size_t first = 0; first < mScratchTiles.size(); first += TILE_BATCH_SIZE )
+		{
+			batch.count = (int)glm::min( mScratchTiles.size() - first, (size_t)TILE_BATCH_SIZE );
+			for ( int j = 0; j < batch.count; j++ )
+			{
+				const glm::ivec2& t = mScratchTiles[ first + j ];
+				const uint8_t cell = mWorld->GetTileCell( t );
+				batch.minX[ j ] = (float)( t.x * TILE_PIXEL_SIZE );
+				batch.minY[ j ] = (float)( t.y * TILE_PIXEL_SIZE );
+				batch.oneWay[ j ] = ( cell & TILECELL_ONE_WAY ) != 0;
+
+				// Anything but solid and one way never collides, park it far away.
+				if ( !( cell & ( TILECELL_SOLID | TILECELL_ONE_WAY ) ) )
+					batch.minX[ j ] = std::numeric_limits< float >::max();
+			}
+
+			QueryAabbVsTileBatch( bounds, delta, batch, normalX, normalY, distance );
+
+			for ( int j = 0; j < batch.count; j++ )
+			{
+				const Contact c( glm::vec2( normalX[ j ], normalY[ j ] ), distance[ j ] );
+				if ( c.distance >= 0.0f || mWorld->IsInternalCollision( mScratchTiles[ first + j ], c ) )
+					continue;
+
+				const glm::vec2 push = c.normal * -c.distance;
+				pushMin = glm::min( pushMin, push );
+				pushMax = glm::max( pushMax, push );
+
+				const float normVel = glm::dot( velocity, c.normal );
+				if ( normVel < 0.0f )
+				{
+					velocity -= c.normal * normVel;
+				}
+				if ( c.normal.y > 0.0f )
+				{
+					mFlags[ i ] |= BODY_GROUNDED;
+				}
+			}
+		}
+
+		mCenterX[ i ] += pushMin.x + pushMax.x;
+		mCenterY[ i ] += pushMin.y + pushMax.y;
+		mVelX[ i ] = velocity.x;
+		mVelY[ i ] = velocity.y;
+	}
+
+	Aabb BodySystem::GetBounds( BodyId id ) const
+	{
+		const int i = mIndex[ id ];
+		return Aabb( mCenterX[ i ], mCenterY[ i ], mHalfX[ i ], mHalfY[ i ] );
+	}
+
+	void BodySystem::SetCenter( BodyId id, const glm::vec2& center )
+	{
+		const int i = mIndex[ id ];
+		mCenterX[ i ] = center.x;
+		mCenterY[ i ] = center.y;
+	}
+
+	glm::vec2 BodySystem::GetVelocity( BodyId id ) const
+	{
+		const int i = mIndex[ id ];
+		return glm::vec2( mVelX[ i ], mVelY[ i ] );
+	}
+
+	void BodySystem::SetVelocity( BodyId id, const glm::vec2& velocity )
+	{
+		const int i = mIndex[ id ];
+		mVelX[ i ] = velocity.x;
+		mVelY[ i ] = velocity.y;
+	}
+
+	void BodySystem::SetMaxSpeed( BodyId id, const glm::vec2& maxSpeed )
+	{
+		const int i = mIndex[ id ];
+		mMaxSpeedX[ i ] = maxSpeed.x;
+		mMaxSpeedY[ i ] = maxSpeed.y;
+	}
+
+	bool BodySystem::IsGrounded( BodyId id ) const
+	{
+		return ( mFlags[ mIndex[ id ] ] & BODY_GROUNDED ) != 0;
+	}
+
+} /* namespace Procyon */
@@ -0,0 +1,113 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _BODY_SYSTEM_H
+#define _BODY_SYSTEM_H
+
+#include "ProcyonCommon.h"
+#include "World.h"
+
+// Slides per step along surfaces hit while sweeping
+#define BODY_SWEEP_ITERATIONS 3
+
+namespace Procyon {
+
+	typedef uint32_t BodyId;
+
+	enum BodyFlags
+	{
+		BODY_GROUNDED = BIT( 0 ) 	// standing on something after the last Step()
+	};
+
+	/*
+	================
+	BodySystem
+
+	Kinematic AABB bodies moved against a World's tiles. Body state is kept
+	as parallel arrays and every body is stepped in one pass, integration in
+	straight loops over them, then a sweep through the grid so fast bodies
+	can't tunnel, then a batched push out of anything still overlapped.
+
+	BodyIds stay valid until Remove(), dense indices do not.
+	================
+	*/
+	class BodySystem
+	{
+	public:
+							BodySystem( const World* world );
+
+		void 				SetWorld( const World* world ) { mWorld = world; }
+		void 				SetGravity( const glm::vec2& gravity ) { mGravity = gravity; }
+		const glm::vec2& 	GetGravity() const { return mGravity; }
+
+		// gravityScale of 0 for bodies that fly, e.g. projectiles.
+		BodyId 				Add( const Aabb& bounds, float gravityScale = 1.0f );
+		void 				Remove( BodyId id );
+		void 				Clear();
+		int 				GetCount() const { return (int)mIds.size(); }
+
+		void 				Step( float dt );
+
+		Aabb 				GetBounds( BodyId id ) const;
+		void 				SetCenter( BodyId id, const glm::vec2& center );
+		glm::vec2 			GetVelocity( BodyId id ) const;
+		void 				SetVelocity( BodyId id, const glm::vec2& velocity );
+		// Velocity is clamped to +-maxSpeed per axis after gravity each
+		// Step(), unlimited by default.
+		void 				SetMaxSpeed( BodyId id, const glm::vec2& maxSpeed );
+		bool 				IsGrounded( BodyId id ) const;
+
+	protected:
+		void 				Integrate( float dt );
+		void 				Sweep( int i );
+		void 				ResolveOverlaps( int i );
+
+		const World* 				mWorld;
+		glm::vec2 					mGravity;
+
+		// Body state, indexed densely.
+		std::vector< float > 		mCenterX;
+		std::vector< float > 		mCenterY;
+		std::vector< float > 		mHalfX;
+		std::vector< float > 		mHalfY;
+		std::vector< float > 		mVelX;
+		std::vector< float > 		mVelY;
+		std::vector< float > 		mDeltaX;
+		std::vector< float > 		mDeltaY;
+		std::vector< float > 		mGravityScale;
+		std::vector< float > 		mMaxSpeedX;
+		std::vector< float > 		mMaxSpeedY;
+		std::vector< uint8_t > 		mFlags;
+		std::vector< BodyId > 		mIds;
+
+		// BodyId to dense index, -1 once removed.
+		std::vector< int > 			mIndex;
+		std::vector< BodyId > 		mFreeIds;
+
+		std::vector< glm::ivec2 > 	mScratchTiles;
+	};
+
+} /* namespace Procyon */
+
+#endif /* _BODY_SYSTEM_H */
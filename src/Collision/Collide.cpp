@@ -0,0 +1,134 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "Collide.h"
+#include "Contact.h"
+
+namespace Procyon {
+
+	static bool TestAabbAxis( const glm::vec2& axis, float minA, float maxA, float minB, float maxB, glm::vec2* mtvAxis, float* mtvDist )
+	{
+		float d0 = (maxB - minA);   // 'Left' side
+		float d1 = (maxA - minB);   // 'Right' side
+
+		if ( d0 <= 0.0f || d1 <= 0.0f )
+		{
+			return false;
+		}
+
+		float overlap = ( d0 < d1 ) ? d0 : -d1;
+
+		glm::vec2 seperation = axis * overlap;
+
+		float sepLengthSquared = glm::dot( seperation, seperation );
+		if ( sepLengthSquared < *mtvDist )
+		{
+			*mtvDist = sepLengthSquared;
+			*mtvAxis = seperation;
+		}
+
+		return true;
+	}
+
+	bool QueryAabbVsAabb( const Aabb& a, const Aabb& b, Contact* out )
+	{
+		float mtvDist = std::numeric_limits<float>::max();
+		glm::vec2 mtvAxis;
+
+		if ( !TestAabbAxis( glm::vec2(1.0f, 0.0f),
+				a.GetMin().x, a.GetMax().x, b.GetMin().x, b.GetMax().x,
+				&mtvAxis, &mtvDist ) )
+		{
+			return false;
+		}
+
+		if ( !TestAabbAxis( glm::vec2(0.0f, 1.0f),
+				a.GetMin().y, a.GetMax().y, b.GetMin().y, b.GetMax().y,
+				&mtvAxis, &mtvDist ) )
+		{
+			return false;
+		}
+
+		out->normal = glm::normalize(mtvAxis);
+		out->distance = sqrt(mtvDist) * -CONTACT_SLOP;
+
+		return true;
+	}
+
+	bool QueryAabbVsTopPlane( const glm::vec2& delta, const Aabb& a, const Aabb& b, Contact* out )
+	{
+		float d0 = ( b.GetMax().y - a.GetMin().y );
+		float d1 = ( a.GetMax().y - b.GetMax().y );
+		float delta0 = d0 + delta.y;
+
+		if ( d0 <= 0.0f || d1 <= 0.0f || delta0 >= 0.0f )
+		{
+			return false;
+		}
+
+		float overlap = ( d0 < d1 ) ? d0 : -d1;
+		glm::vec2 seperation = glm::vec2( 0.0f, 1.0f ) * overlap;
+		out->normal = glm::normalize( seperation );
+		out->distance = sqrt( glm::dot( seperation, seperation ) ) * -CONTACT_SLOP;
+
+		return true;
+	}
+
+	void QueryAabbVsTileBatch( const Aabb& a, const glm::vec2& delta, const TileBatch& tiles
+		, float* outNormalX, float* outNormalY, float* outDistance )
+	{
+		const glm::vec2 aMin = a.GetMin();
+		const glm::vec2 aMax = a.GetMax();
+		const float tileSize = (float)TILE_PIXEL_SIZE;
+
+		// Straight line selects only, so this vectorizes.
+		for ( int i = 0; i < tiles.count; i++ )
+		{
+			const float bMinX = tiles.minX[ i ];
+			const float bMinY = tiles.minY[ i ];
+			const float bMaxX = bMinX + tileSize;
+			const float bMaxY = bMinY + tileSize;
+
+			// Overlap of each face, positive when penetrating.
+			const float left 	= bMaxX - aMin.x;
+			const float right 	= aMax.x - bMinX;
+			const float down 	= bMaxY - aMin.y;
+			const float up 		= aMax.y - bMinY;
+
+			const float pushX = ( left < right ) ? left : -right;
+			const float pushY = ( down < up ) ? down : -up;
+			const bool useX = fabsf( pushX ) <= fabsf( pushY );
+			const bool overlapX = left > 0.0f && right > 0.0f;
+
+			const bool solid = !tiles.oneWay[ i ] && overlapX && down > 0.0f && up > 0.0f;
+			const bool platform = tiles.oneWay[ i ] && overlapX && down > 0.0f && aMax.y > bMaxY && down + delta.y < 0.0f;
+
+			const float depth = ( solid ) ? fabsf( ( useX ) ? pushX : pushY ) : ( platform ) ? down : 0.0f;
+			outNormalX[ i ] = ( solid && useX ) ? ( ( pushX > 0.0f ) ? 1.0f : -1.0f ) : 0.0f;
+			outNormalY[ i ] = ( solid && !useX ) ? ( ( pushY > 0.0f ) ? 1.0f : -1.0f ) : ( platform ) ? 1.0f : 0.0f;
+			outDistance[ i ] = depth * -CONTACT_SLOP;
+		}
+	}
+
+} /* namespace Procyon */
@@ -0,0 +1,71 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _COLLIDE_H
+#define _COLLIDE_H
+
+#include "ProcyonCommon.h"
+#include "World.h"
+
+// Contacts push a little past touching so the next step starts apart.
+#define CONTACT_SLOP 1.001f
+
+#define TILE_BATCH_SIZE 16
+
+namespace Procyon {
+
+	class Contact;
+
+	// Minimum translation contact pushing a out of b. Returns false if they
+	// don't overlap.
+	bool QueryAabbVsAabb( const Aabb& a, const Aabb& b, Contact* out );
+
+	// Contact pushing a up out of the top face of b. Only if a moved down
+	// onto it by delta, sides and bottom are ignored.
+	bool QueryAabbVsTopPlane( const glm::vec2& delta, const Aabb& a, const Aabb& b, Contact* out );
+
+	/*
+	================
+	TileBatch
+
+	Up to TILE_BATCH_SIZE tiles laid out for QueryAabbVsTileBatch().
+	================
+	*/
+	struct TileBatch
+	{
+		float 		minX[ TILE_BATCH_SIZE ];
+		float 		minY[ TILE_BATCH_SIZE ];
+		uint8_t 	oneWay[ TILE_BATCH_SIZE ];
+		int 		count;
+	};
+
+	// QueryAabbVsAabb() against solid tiles and QueryAabbVsTopPlane() against
+	// one way tiles, for a whole batch at once. Branch free, outDistance is
+	// 0 where there is no contact and negative penetration otherwise.
+	void QueryAabbVsTileBatch( const Aabb& a, const glm::vec2& delta, const TileBatch& tiles
+		, float* outNormalX, float* outNormalY, float* outDistance );
+
+} /* namespace Procyon */
+
+#endif /* _COLLIDE_H */
@@ -47,6 +47,55 @@ namespace Procyon {
 		}
 	};
 
+	/*
+	================
+	SweepHit
+
+	First contact found by World::SweepAabb().
+	================
+	*/
+	struct SweepHit
+	{
+		float 		time; 	// fraction of delta moved before contact, [0, 1]
+		glm::vec2 	normal; // axis aligned, facing the moving box
+		glm::ivec2 	tile;
+	};
+
+	/*
+	================
+	Ray
+
+	Input to World::RaycastMany(), dir need not be normalized.
+	================
+	*/
+	struct Ray
+	{
+		glm::vec2 	origin;
+		glm::vec2 	dir;
+		float 		maxDist;
+	};
+
+	enum RaycastFlags
+	{
+		RAYCAST_IGNORE_ONE_WAY = BIT( 0 ) 	// one way platforms never block
+	};
+
+	/*
+	================
+	RaycastHit
+
+	First blocking tile found by World::Raycast(). A ray starting inside a
+	solid tile hits it at distance 0 with a zero normal.
+	================
+	*/
+	struct RaycastHit
+	{
+		float 		distance; 	// pixels along the normalized ray
+		glm::vec2 	point; 		// where the ray enters the tile
+		glm::vec2 	normal; 	// face entered through
+		glm::ivec2 	tile;
+	};
+
 } /* namespace Procyon */
 
 #endif /* _CONTACT_H */
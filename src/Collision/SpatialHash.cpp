@@ -0,0 +1,326 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "SpatialHash.h"
+
+namespace Procyon {
+
+	static inline uint64_t CellKey( int x, int y )
+	{
+		return ( (uint64_t)(uint32_t)x << 32 ) | (uint32_t)y;
+	}
+
+	static inline bool InRange( const glm::ivec4& r, int x, int y )
+	{
+		return x >= r.x && x <= r.z && y >= r.y && y <= r.w;
+	}
+
+	static inline bool Overlaps( const Aabb& a, const Aabb& b )
+	{
+		const glm::vec2 d = glm::abs( a.mCenter - b.mCenter );
+		const glm::vec2 r = a.mHalfExtent + b.mHalfExtent;
+		return d.x < r.x && d.y < r.y;
+	}
+
+	// Entry time of the segment from + delta into bounds, as a fraction of delta.
+	static bool SegmentVsAabb( const glm::vec2& from, const glm::vec2& delta, const Aabb& bounds, float& outTime )
+	{
+		const glm::vec2 min = bounds.GetMin();
+		const glm::vec2 max = bounds.GetMax();
+
+		float tEnter = 0.0f;
+		float tExit = 1.0f;
+		for ( int axis = 0; axis < 2; axis++ )
+		{
+			if ( delta[ axis ] == 0.0f )
+			{
+				if ( from[ axis ] < min[ axis ] || from[ axis ] > max[ axis ] )
+					return false;
+				continue;
+			}
+
+			const float inv = 1.0f / delta[ axis ];
+			float t0 = ( min[ axis ] - from[ axis ] ) * inv;
+			float t1 = ( max[ axis ] - from[ axis ] ) * inv;
+			if ( t0 > t1 )
+				std::swap( t0, t1 );
+
+			tEnter = std::max( tEnter, t0 );
+			tExit = std::min( tExit, t1 );
+			if ( tEnter > tExit )
+				return false;
+		}
+
+		outTime = tEnter;
+		return true;
+	}
+
+	SpatialHash::SpatialHash( float cellSize )
+		: mCellSize( cellSize )
+		, mInvCellSize( 1.0f / cellSize )
+		, mCount( 0 )
+		, mStamp( 0 )
+	{
+		assert( cellSize > 0.0f );
+	}
+
+	ProxyId SpatialHash::Insert( const Aabb& bounds )
+	{
+		ProxyId id;
+		if ( !mFreeIds.empty() )
+		{
+			id = mFreeIds.back();
+			mFreeIds.pop_back();
+		}
+		else
+		{
+			id = (ProxyId)mProxies.size();
+			mProxies.push_back( Proxy{ bounds, glm::ivec4() } );
+			mStamps.push_back( 0 );
+		}
+
+		const glm::ivec4 cells = CellRange( bounds );
+		mProxies[ id ].bounds = bounds;
+		mProxies[ id ].cells = cells;
+		AddToCells( id, cells, glm::ivec4( 0, 0, -1, -1 ) );
+		mCount++;
+		return id;
+	}
+
+	void SpatialHash::Update( ProxyId id, const Aabb& bounds )
+	{
+		Proxy& proxy = mProxies[ id ];
+		assert( proxy.cells.x <= proxy.cells.z );
+
+		// Most moves stay within the same cells.
+		const glm::ivec4 cells = CellRange( bounds );
+		proxy.bounds = bounds;
+		if ( cells == proxy.cells )
+			return;
+
+		// Only touch the cells entered or left.
+		RemoveFromCells( id, proxy.cells, cells );
+		AddToCells( id, cells, proxy.cells );
+		proxy.cells = cells;
+	}
+
+	void SpatialHash::Remove( ProxyId id )
+	{
+		Proxy& proxy = mProxies[ id ];
+		assert( proxy.cells.x <= proxy.cells.z );
+
+		RemoveFromCells( id, proxy.cells, glm::ivec4( 0, 0, -1, -1 ) );
+		proxy.cells = glm::ivec4( 0, 0, -1, -1 );
+		mFreeIds.push_back( id );
+		mCount--;
+	}
+
+	void SpatialHash::Clear()
+	{
+		mProxies.clear();
+		mFreeIds.clear();
+		mCells.clear();
+		mStamps.clear();
+		mCount = 0;
+	}
+
+	void SpatialHash::Query( const Aabb& bounds, std::vector< ProxyId >& out ) const
+	{
+		const glm::ivec4 range = CellRange( bounds );
+		const uint32_t stamp = NextStamp();
+		for ( int x = range.x; x <= range.z; x++ )
+		{
+			for ( int y = range.y; y <= range.w; y++ )
+			{
+				const Cell* cell = FindCell( x, y );
+				if ( !cell )
+					continue;
+
+				for ( ProxyId id : *cell )
+				{
+					if ( mStamps[ id ] == stamp )
+						continue;
+					mStamps[ id ] = stamp;
+
+					if ( Overlaps( bounds, mProxies[ id ].bounds ) )
+						out.push_back( id );
+				}
+			}
+		}
+	}
+
+	bool SpatialHash::Raycast( const glm::vec2& from, const glm::vec2& delta, ProxyId& outId, float& outTime, ProxyId ignore /* = PROXY_NONE */ ) const
+	{
+		// Walk the cells the segment crosses, in order.
+		glm::ivec2 cell = glm::ivec2( glm::floor( from * mInvCellSize ) );
+		const glm::ivec2 end = glm::ivec2( glm::floor( ( from + delta ) * mInvCellSize ) );
+
+		glm::ivec2 step;
+		glm::vec2 tNext, tDelta;
+		for ( int axis = 0; axis < 2; axis++ )
+		{
+			step[ axis ] = ( delta[ axis ] > 0.0f ) ? 1 : ( ( delta[ axis ] < 0.0f ) ? -1 : 0 );
+			if ( step[ axis ] == 0 )
+			{
+				tNext[ axis ] = FLT_MAX;
+				tDelta[ axis ] = FLT_MAX;
+				continue;
+			}
+
+			const float boundary = ( cell[ axis ] + ( ( step[ axis ] > 0 ) ? 1 : 0 ) ) * mCellSize;
+			tNext[ axis ] = ( boundary - from[ axis ] ) / delta[ axis ];
+			tDelta[ axis ] = mCellSize / fabs( delta[ axis ] );
+		}
+
+		const uint32_t stamp = NextStamp();
+		float best = FLT_MAX;
+		for ( ;; )
+		{
+			if ( const Cell* c = FindCell( cell.x, cell.y ) )
+			{
+				for ( ProxyId id : *c )
+				{
+					if ( mStamps[ id ] == stamp || id == ignore )
+						continue;
+					mStamps[ id ] = stamp;
+
+					float t;
+					if ( SegmentVsAabb( from, delta, mProxies[ id ].bounds, t ) && t < best )
+					{
+						best = t;
+						outId = id;
+					}
+				}
+			}
+
+			// Nothing in a later cell can be hit before the best so far.
+			const float tExit = std::min( tNext.x, tNext.y );
+			if ( best <= tExit || tExit > 1.0f || cell == end )
+				break;
+
+			const int axis = ( tNext.x < tNext.y ) ? 0 : 1;
+			cell[ axis ] += step[ axis ];
+			tNext[ axis ] += tDelta[ axis ];
+		}
+
+		if ( best > 1.0f )
+			return false;
+
+		outTime = best;
+		return true;
+	}
+
+	void SpatialHash::FindPairs( std::vector< ProxyPair >& out ) const
+	{
+		// Each pair is found from its lower id, so walking ids in order gives
+		// a deterministic ordering regardless of hashing.
+		for ( ProxyId a = 0; a < (ProxyId)mProxies.size(); a++ )
+		{
+			const Proxy& proxy = mProxies[ a ];
+			if ( proxy.cells.x > proxy.cells.z )
+				continue;
+
+			const size_t first = out.size();
+			const uint32_t stamp = NextStamp();
+			for ( int x = proxy.cells.x; x <= proxy.cells.z; x++ )
+			{
+				for ( int y = proxy.cells.y; y <= proxy.cells.w; y++ )
+				{
+					const Cell* cell = FindCell( x, y );
+					if ( !cell )
+						continue;
+
+					for ( ProxyId b : *cell )
+					{
+						if ( b <= a || mStamps[ b ] == stamp )
+							continue;
+						mStamps[ b ] = stamp;
+
+						if ( Overlaps( proxy.bounds, mProxies[ b ].bounds ) )
+							out.push_back( ProxyPair{ a, b } );
+					}
+				}
+			}
+
+			std::sort( out.begin() + first, out.end(), []( const ProxyPair& l, const ProxyPair& r ) { return l.b < r.b; } );
+		}
+	}
+
+	glm::ivec4 SpatialHash::CellRange( const Aabb& bounds ) const
+	{
+		const glm::ivec2 min = glm::ivec2( glm::floor( bounds.GetMin() * mInvCellSize ) );
+		const glm::ivec2 max = glm::ivec2( glm::floor( bounds.GetMax() * mInvCellSize ) );
+		return glm::ivec4( min.x, min.y, max.x, max.y );
+	}
+
+	void SpatialHash::AddToCells( ProxyId id, const glm::ivec4& cells, const glm::ivec4& skip )
+	{
+		for ( int x = cells.x; x <= cells.z; x++ )
+		{
+			for ( int y = cells.y; y <= cells.w; y++ )
+			{
+				if ( !InRange( skip, x, y ) )
+				{
+					mCells[ CellKey( x, y ) ].push_back( id );
+				}
+			}
+		}
+	}
+
+	void SpatialHash::RemoveFromCells( ProxyId id, const glm::ivec4& cells, const glm::ivec4& skip )
+	{
+		for ( int x = cells.x; x <= cells.z; x++ )
+		{
+			for ( int y = cells.y; y <= cells.w; y++ )
+			{
+				if ( InRange( skip, x, y ) )
+					continue;
+
+				Cell& cell = mCells[ CellKey( x, y ) ];
+				Cell::iterator it = std::find( cell.begin(), cell.end(), id );
+				assert( it != cell.end() );
+				*it = cell.back();
+				cell.pop_back();
+			}
+		}
+	}
+
+	const SpatialHash::Cell* SpatialHash::FindCell( int x, int y ) const
+	{
+		std::unordered_map< uint64_t, Cell >::const_iterator it = mCells.find( CellKey( x, y ) );
+		return ( it != mCells.end() && !it->second.empty() ) ? &it->second : NULL;
+	}
+
+	uint32_t SpatialHash::NextStamp() const
+	{
+		if ( ++mStamp == 0 )
+		{
+			// Wrapped, forget every visit so stale stamps can't match.
+			std::fill( mStamps.begin(), mStamps.end(), 0 );
+			mStamp = 1;
+		}
+		return mStamp;
+	}
+
+} /* namespace Procyon */
@@ -0,0 +1,112 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _SPATIAL_HASH_H
+#define _SPATIAL_HASH_H
+
+#include "ProcyonCommon.h"
+#include "Aabb.h"
+
+namespace Procyon {
+
+	typedef uint32_t ProxyId;
+
+	#define PROXY_NONE ((ProxyId)-1)
+
+	// Two overlapping proxies, a < b.
+	struct ProxyPair
+	{
+		ProxyId a;
+		ProxyId b;
+	};
+
+	/*
+	================
+	SpatialHash
+
+	Broadphase for dynamic objects. Each proxy's Aabb is filed under every
+	uniform grid cell it touches, only occupied cells are stored. Pick a cell
+	size around the size of a typical object; ones much larger still work
+	but are filed under many cells.
+
+	ProxyIds stay valid until Remove(). Queries are const but share scratch
+	state, so don't run them concurrently on the same SpatialHash.
+	================
+	*/
+	class SpatialHash
+	{
+	public:
+							SpatialHash( float cellSize );
+
+		ProxyId 			Insert( const Aabb& bounds );
+		void 				Update( ProxyId id, const Aabb& bounds );
+		void 				Remove( ProxyId id );
+		void 				Clear();
+
+		const Aabb& 		GetBounds( ProxyId id ) const { return mProxies[ id ].bounds; }
+		int 				GetCount() const { return mCount; }
+
+		// Appends every proxy overlapping bounds, in no particular order.
+		void 				Query( const Aabb& bounds, std::vector< ProxyId >& out ) const;
+
+		// First proxy hit by the segment from + delta, outTime is the fraction
+		// of delta travelled. Proxies already containing from hit at 0.
+		bool 				Raycast( const glm::vec2& from, const glm::vec2& delta, ProxyId& outId, float& outTime, ProxyId ignore = PROXY_NONE ) const;
+
+		// Appends every overlapping pair once, ordered by a then b.
+		void 				FindPairs( std::vector< ProxyPair >& out ) const;
+
+	protected:
+		struct Proxy
+		{
+			Aabb 		bounds;
+			glm::ivec4 	cells; 	// x0, y0, x1, y1 inclusive, x1 < x0 once removed
+		};
+
+		typedef std::vector< ProxyId > Cell;
+
+		glm::ivec4 			CellRange( const Aabb& bounds ) const;
+		void 				AddToCells( ProxyId id, const glm::ivec4& cells, const glm::ivec4& skip );
+		void 				RemoveFromCells( ProxyId id, const glm::ivec4& cells, const glm::ivec4& skip );
+		const Cell* 		FindCell( int x, int y ) const;
+		uint32_t 			NextStamp() const;
+
+		float 								mCellSize;
+		float 								mInvCellSize;
+		int 								mCount;
+		std::vector< Proxy > 				mProxies;
+		std::vector< ProxyId > 				mFreeIds;
+
+		// Keyed by packed cell coordinates. Emptied cells are kept so
+		// objects moving back and forth don't reallocate.
+		std::unordered_map< uint64_t, Cell > mCells;
+
+		// Per proxy, the query that last visited it.
+		mutable std::vector< uint32_t > 	mStamps;
+		mutable uint32_t 					mStamp;
+	};
+
+} /* namespace Procyon */
+
+#endif /* _SPATIAL_HASH_H */
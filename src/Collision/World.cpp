@@ -26,18 +26,56 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 #include "Contact.h"
 #include "Graphics/Texture.h"
 #include "Graphics/Renderer.h"
+#include "Graphics/RenderCore.h"
+#include "Graphics/QuadBuffer.h"
 #include "Graphics/Sprite.h"
 
-#define TILE_INDEX( tx, ty ) ( ( tx ) * mSize.y + ( ty ) )
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
-#define FOREACH_TILE_INDEX( tiles ) 			\
-	for ( int x = 0; x < mSize.x; x++ )			\
-		for ( int y = 0; y < mSize.y; y++ )		\
+#define CHUNK_AREA ( WORLD_CHUNK_TILES * WORLD_CHUNK_TILES )
+#define CHUNK_OF( tx, ty ) ( ( ( ty ) / WORLD_CHUNK_TILES ) * mChunkCount.x + ( tx ) / WORLD_CHUNK_TILES )
+// Pixels a box may touch or overlap a tile by without entering it
+#define SWEEP_EPSILON 1e-3f
+
+#define CHUNK_TILE_INDEX( tx, ty ) ( ( ( tx ) % WORLD_CHUNK_TILES ) * WORLD_CHUNK_TILES + ( ty ) % WORLD_CHUNK_TILES )
 
 namespace Procyon {
 
 	TileDef TileDef::Empty;
 
+	static_assert( WORLD_CHUNK_TILES == 32, "ChunkTiles masks are one uint32_t per row and column" );
+
+	static inline int LowestBit( uint32_t mask )
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward( &index, mask );
+		return (int)index;
+#else
+		return __builtin_ctz( mask );
+#endif
+	}
+
+	static inline int HighestBit( uint32_t mask )
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanReverse( &index, mask );
+		return (int)index;
+#else
+		return 31 - __builtin_clz( mask );
+#endif
+	}
+
+	// Bits [lo, hi] set.
+	static inline uint32_t BitRange( int lo, int hi )
+	{
+		const uint32_t upTo = ( hi >= 31 ) ? 0xFFFFFFFFu : ( ( 1u << ( hi + 1 ) ) - 1 );
+		return upTo & ~( ( 1u << lo ) - 1 );
+	}
+
 	/* static */ TileType TileDef::StringToTileType(const std::string& typeStr )
 	{
 		if ( typeStr == "Air" ) return TILETYPE_AIR;
@@ -87,24 +125,229 @@ namespace Procyon {
 		mTileDefs.clear();
 	}
 
+	World::~World()
+	{
+		for ( Chunk& chunk : mChunks )
+		{
+			delete chunk.tiles;
+			delete chunk.quads;
+		}
+	}
+
 	void World::NewWorld( const glm::ivec2& size, const TileSet* tileset )
 	{
 		mTileSet = tileset;
 		mSize = size;
-		mTiles.clear();
-		mTiles.resize( size.x * size.y, 0 ); // clear to empty
+		ResetChunks(); // clear to empty
 	}
 
 	void World::LoadMap( const Map* map )
 	{
 		mTileSet = map->GetTileSet();
 		mSize = map->GetSize();
-		mTiles.clear();
-		mTiles.resize( mSize.x * mSize.y, 0 ); // clear to empty
-		FOREACH_TILE_INDEX( mTiles )
+		ResetChunks();
+
+		std::vector< TileId > scratch( CHUNK_AREA );
+		for ( int cy = 0; cy < mChunkCount.y; cy++ )
+		{
+			for ( int cx = 0; cx < mChunkCount.x; cx++ )
+			{
+				// Chunk layouts match, take them whole when the map has them.
+				const TileId* tiles = map->GetChunk( glm::ivec2( cx, cy ) );
+				if ( !tiles )
+				{
+					for ( int i = 0; i < CHUNK_AREA; i++ )
+					{
+						const int x = cx * WORLD_CHUNK_TILES + i / WORLD_CHUNK_TILES;
+						const int y = cy * WORLD_CHUNK_TILES + i % WORLD_CHUNK_TILES;
+						scratch[ i ] = ( x < mSize.x && y < mSize.y ) ? map->GetTile( x, y ) : 0;
+					}
+					tiles = scratch.data();
+				}
+				SetChunkTiles( glm::ivec2( cx, cy ), tiles );
+			}
+		}
+		BuildNeighbourBits();
+	}
+
+	size_t World::GetTileMemory() const
+	{
+		size_t bytes = mChunks.capacity() * sizeof( Chunk );
+		for ( const Chunk& chunk : mChunks )
+		{
+			if ( chunk.tiles )
+				bytes += sizeof( ChunkTiles );
+		}
+		return bytes;
+	}
+
+	// Same quad as Renderer::DrawRectShape(), without needing the Renderer.
+	static void MakeRectQuad( const glm::vec2& pos, const glm::vec2& dims, const glm::vec4& color, BatchedQuad* out )
+	{
+		out->position[0] = pos.x;
+		out->position[1] = pos.y;
+		out->size[0]     = dims.x;
+		out->size[1]     = dims.y;
+		out->rotation    = 0.0f;
+		out->uvoffset[0] = 0.0f;
+		out->uvoffset[1] = 0.0f;
+		out->uvsize[0]   = 0.0f;
+		out->uvsize[1]   = 0.0f;
+		out->color[0]    = color.x;
+		out->color[1]    = color.y;
+		out->color[2]    = color.z;
+		out->color[3]    = color.w;
+		out->origin[0]	 = 0.0f;
+		out->origin[1]	 = 0.0f;
+	}
+
+	bool World::MakeTileQuad( int x, int y, BatchedQuad* out ) const
+	{
+		const TileDef& tt = GetTileDef( glm::ivec2( x, y ) );
+
+		switch ( tt.type )
+		{
+			case TILETYPE_SOLID:
+			{
+				glm::vec2 dims( (float)TILE_PIXEL_SIZE );
+				glm::vec2 pos = glm::vec2( (float)x , (float)y ) * (float)TILE_PIXEL_SIZE + HALF_TILE_SIZE;
+				MakeRectQuad( pos, dims, glm::vec4(92/255.0f, 172/255.0f, 144/255.0f, 1.f), out );
+				return true;
+			}
+			case TILETYPE_ONE_WAY:
+			{
+				glm::vec2 dims( (float)TILE_PIXEL_SIZE, 8.0f  );
+				glm::vec2 pos = glm::vec2( (float)x , (float)y ) * (float)TILE_PIXEL_SIZE + dims/2.0f;
+				pos.y += (TILE_PIXEL_SIZE - dims.y);
+				MakeRectQuad( pos, dims, glm::vec4(247/255.0f, 186/255.0f, 81/255.0f, 1.f), out );
+				return true;
+			}
+			default: return false;
+		}
+	}
+
+	void World::ResetChunks()
+	{
+		for ( Chunk& chunk : mChunks )
 		{
-			mTiles[ TILE_INDEX( x, y) ] = map->GetTile( x, y );
+			delete chunk.tiles;
+			delete chunk.quads;
 		}
+
+		mChunkCount = ( mSize + WORLD_CHUNK_TILES - 1 ) / WORLD_CHUNK_TILES;
+		mChunks.assign( mChunkCount.x * mChunkCount.y, Chunk() );
+	}
+
+	void World::ReleaseChunkQuads()
+	{
+		for ( Chunk& chunk : mChunks )
+		{
+			delete chunk.quads;
+			chunk.quads = nullptr;
+			chunk.dirty = true;
+		}
+	}
+
+	// tiles is a whole chunk, column major and zero past the world edge.
+	void World::SetChunkTiles( const glm::ivec2& chunk, const TileId* tiles )
+	{
+		Chunk& c = mChunks[ chunk.y * mChunkCount.x + chunk.x ];
+		if ( !c.tiles )
+		{
+			c.tiles = new ChunkTiles();
+		}
+		memcpy( c.tiles->tiles, tiles, sizeof( c.tiles->tiles ) );
+		memset( c.tiles->columns, 0, sizeof( c.tiles->columns ) );
+		memset( c.tiles->rows, 0, sizeof( c.tiles->rows ) );
+		memset( c.tiles->cells, 0, sizeof( c.tiles->cells ) );
+		c.tiles->count = 0;
+
+		// Neighbour bits need every chunk, see BuildNeighbourBits().
+		for ( int i = 0; i < CHUNK_AREA; i++ )
+		{
+			if ( tiles[ i ] )
+			{
+				const int x = i / WORLD_CHUNK_TILES;
+				const int y = i % WORLD_CHUNK_TILES;
+				c.tiles->columns[ x ] |= 1u << y;
+				c.tiles->rows[ y ] |= 1u << x;
+				c.tiles->cells[ i ] = TileCellBits( tiles[ i ] );
+				c.tiles->count++;
+			}
+		}
+
+		if ( !c.tiles->count )
+		{
+			delete c.tiles;
+			c.tiles = nullptr;
+		}
+		c.dirty = true;
+	}
+
+	uint8_t World::TileCellBits( TileId id ) const
+	{
+		const TileDef& def = mTileSet->GetTileDef( id );
+		if ( !def.collidable )
+			return 0;
+
+		return TILECELL_COLLIDABLE
+			| ( ( def.type == TILETYPE_SOLID ) ? TILECELL_SOLID : 0 )
+			| ( ( def.type == TILETYPE_ONE_WAY ) ? TILECELL_ONE_WAY : 0 );
+	}
+
+	uint8_t World::NeighbourBits( int x, int y ) const
+	{
+		return ( ( GetTileCell( glm::ivec2( x - 1, y ) ) & TILECELL_SOLID ) ? TILECELL_SOLID_LEFT : 0 )
+			| ( ( GetTileCell( glm::ivec2( x + 1, y ) ) & TILECELL_SOLID ) ? TILECELL_SOLID_RIGHT : 0 )
+			| ( ( GetTileCell( glm::ivec2( x, y - 1 ) ) & TILECELL_SOLID ) ? TILECELL_SOLID_DOWN : 0 )
+			| ( ( GetTileCell( glm::ivec2( x, y + 1 ) ) & TILECELL_SOLID ) ? TILECELL_SOLID_UP : 0 );
+	}
+
+	// Every tile's own bits must already be set.
+	void World::BuildNeighbourBits()
+	{
+		for ( int cy = 0; cy < mChunkCount.y; cy++ )
+		{
+			for ( int cx = 0; cx < mChunkCount.x; cx++ )
+			{
+				ChunkTiles* tiles = mChunks[ cy * mChunkCount.x + cx ].tiles;
+				for ( int lx = 0; tiles && lx < WORLD_CHUNK_TILES; lx++ )
+				{
+					for ( uint32_t mask = tiles->columns[ lx ]; mask; mask &= mask - 1 )
+					{
+						const int ly = LowestBit( mask );
+						tiles->cells[ lx * WORLD_CHUNK_TILES + ly ] |= NeighbourBits( cx * WORLD_CHUNK_TILES + lx, cy * WORLD_CHUNK_TILES + ly );
+					}
+				}
+			}
+		}
+	}
+
+	void World::BuildChunk( const glm::ivec2& chunk )
+	{
+		const glm::ivec2 begin = chunk * WORLD_CHUNK_TILES;
+		const glm::ivec2 end = glm::min( begin + WORLD_CHUNK_TILES, mSize );
+
+		Chunk& c = mChunks[ chunk.y * mChunkCount.x + chunk.x ];
+		mChunkScratch.clear();
+		for ( int x = begin.x; c.tiles && x < end.x; x++ )
+		{
+			for ( uint32_t mask = c.tiles->columns[ x - begin.x ]; mask; mask &= mask - 1 )
+			{
+				BatchedQuad quad;
+				if ( MakeTileQuad( x, begin.y + LowestBit( mask ), &quad ) )
+				{
+					mChunkScratch.push_back( quad );
+				}
+			}
+		}
+
+		if ( !c.quads )
+		{
+			c.quads = mChunkCore->AllocateQuadBuffer();
+		}
+		c.quads->SetQuads( mChunkScratch.data(), (int)mChunkScratch.size() );
+		c.dirty = false;
 	}
 
 	void World::Render( Renderer *r )
@@ -112,33 +355,73 @@ namespace Procyon {
 		if ( !mTileSet )
 			return;
 
-		FOREACH_TILE_INDEX( mTiles )
+		// Buffers belong to the core that allocated them.
+		RenderCore* rc = r->GetRenderCore();
+		if ( rc != mChunkCore )
 		{
-			const TileDef& tt = mTileSet->GetTileDef( mTiles[ TILE_INDEX( x, y ) ] );
+			ReleaseChunkQuads();
+			mChunkCore = rc;
+		}
+
+		// GetScreenRect()'s top left is the corner with the largest y.
+		const Rect view = r->GetCamera().GetScreenRect();
+		const glm::vec2 cornerA = view.GetTopLeft();
+		const glm::vec2 cornerB = cornerA + glm::vec2( view.GetWidth(), -view.GetHeight() );
+		const glm::vec2 viewMin = glm::min( cornerA, cornerB );
+		const glm::vec2 viewMax = glm::max( cornerA, cornerB );
 
-			switch ( tt.type )
+		const float chunkPixels = (float)( WORLD_CHUNK_TILES * TILE_PIXEL_SIZE );
+		const glm::ivec2 first = glm::max( glm::ivec2( glm::floor( viewMin / chunkPixels ) ), glm::ivec2( 0 ) );
+		const glm::ivec2 last = glm::min( glm::ivec2( glm::floor( viewMax / chunkPixels ) ), mChunkCount - 1 );
+
+		for ( int cy = first.y; cy <= last.y; cy++ )
+		{
+			for ( int cx = first.x; cx <= last.x; cx++ )
 			{
-				case TILETYPE_SOLID:
+				const Chunk& chunk = mChunks[ cy * mChunkCount.x + cx ];
+				if ( !chunk.tiles )
+					continue; // all air
+
+				if ( chunk.dirty )
 				{
-					glm::vec2 dims( (float)TILE_PIXEL_SIZE );
-					glm::vec2 pos = glm::vec2( (float)x , (float)y ) * (float)TILE_PIXEL_SIZE + HALF_TILE_SIZE;
-					r->DrawRectShape(pos, dims, 0.0f, glm::vec4(92/255.0f, 172/255.0f, 144/255.0f, 1.f));
-					//r->DrawTexture( tt.texture, pos, dims, 0 );
-					break;
+					BuildChunk( glm::ivec2( cx, cy ) );
 				}
-				case TILETYPE_ONE_WAY:
+				rc->AddQuadBuffer( chunk.quads, NULL );
+			}
+		}
+	}
+
+	void World::RenderStrip( RenderCore* rc, int beginX, int endX ) const
+	{
+		if ( !mTileSet )
+			return;
+
+		RenderCommand cmd;
+		cmd.op               = RENDER_OP_QUAD;
+		cmd.flags            = 0;
+		cmd.texture          = NULL;
+		cmd.instancecount    = 1;
+
+		beginX = glm::max( beginX, 0 );
+		endX = glm::min( endX, mSize.x );
+		for ( int x = beginX; x < endX; x++ )
+		{
+			for ( int cy = 0; cy < mChunkCount.y; cy++ )
+			{
+				const ChunkTiles* tiles = mChunks[ CHUNK_OF( x, cy * WORLD_CHUNK_TILES ) ].tiles;
+				for ( uint32_t mask = ( tiles ) ? tiles->columns[ x % WORLD_CHUNK_TILES ] : 0; mask; mask &= mask - 1 )
 				{
-					glm::vec2 dims( (float)TILE_PIXEL_SIZE, 8.0f  );
-					glm::vec2 pos = glm::vec2( (float)x , (float)y ) * (float)TILE_PIXEL_SIZE + dims/2.0f;
-					pos.y += (TILE_PIXEL_SIZE - dims.y);
-					r->DrawRectShape(pos, dims, 0.0f, glm::vec4(247/255.0f, 186/255.0f, 81/255.0f, 1.f));
-					break;
+					BatchedQuad quad;
+					if ( MakeTileQuad( x, cy * WORLD_CHUNK_TILES + LowestBit( mask ), &quad ) )
+					{
+						rc->AddOrAppendQuad( cmd, quad );
+					}
 				}
 			}
 		}
 	}
 
-	void World::TileIntersection( const Aabb& bounds, std::vector< glm::ivec2 >& out )
+	void World::TileIntersection( const Aabb& bounds, std::vector< glm::ivec2 >& out ) const
 	{
 		glm::vec2 min = bounds.GetMin();
 		int minX = int( min.x ) / TILE_PIXEL_SIZE;
@@ -157,45 +440,290 @@ namespace Procyon {
 		maxX = glm::clamp( maxX, 0, mSize.x - 1 );
 		maxY = glm::clamp( maxY, 0, mSize.y - 1 );
 
-		PROCYON_DEBUG( "World", "IsInternalCollision <%i, %i> max <%i, %i>", minX, minY, maxX, maxY );
-
 		for ( int x = minX; x <= maxX; x++ )
 		{
-			for ( int y = minY; y <= maxY; y++ )
+			for ( int cy = minY / WORLD_CHUNK_TILES; cy <= maxY / WORLD_CHUNK_TILES; cy++ )
 			{
-				if( GetTileDef( glm::vec2( x, y ) ).collidable )
+				const ChunkTiles* tiles = mChunks[ CHUNK_OF( x, cy * WORLD_CHUNK_TILES ) ].tiles;
+				if ( !tiles )
+					continue;
+
+				const int base = cy * WORLD_CHUNK_TILES;
+				uint32_t mask = tiles->columns[ x % WORLD_CHUNK_TILES ]
+					& BitRange( glm::max( minY - base, 0 ), glm::min( maxY - base, WORLD_CHUNK_TILES - 1 ) );
+				for ( ; mask; mask &= mask - 1 )
 				{
-					out.push_back( glm::ivec2( x, y ) );
+					const int y = base + LowestBit( mask );
+					if( tiles->cells[ CHUNK_TILE_INDEX( x, y ) ] & TILECELL_COLLIDABLE )
+					{
+						out.push_back( glm::ivec2( x, y ) );
+					}
 				}
 			}
 		}
 	}
 
-	bool World::IsInternalCollision( const glm::ivec2& gridCoords, const Contact& c )
+	bool World::IsInternalCollision( const glm::ivec2& gridCoords, const Contact& c ) const
+	{
+		// A face shared with a solid neighbour can't be touched from outside.
+		uint8_t faces = 0;
+		if ( c.normal.x > 0.0f )
+			faces |= TILECELL_SOLID_RIGHT;
+		else if ( c.normal.x < 0.0f )
+			faces |= TILECELL_SOLID_LEFT;
+
+		if ( c.normal.y > 0.0f )
+			faces |= TILECELL_SOLID_UP;
+		else if ( c.normal.y < 0.0f )
+			faces |= TILECELL_SOLID_DOWN;
+
+		return ( GetTileCell( gridCoords ) & faces ) != 0;
+	}
+
+	bool World::FirstCollidableInColumn( int x, int y0, int y1, int& outY ) const
+	{
+		return FirstCollidable( true, x, y0, y1, outY );
+	}
+
+	bool World::FirstCollidableInRow( int y, int x0, int x1, int& outX ) const
+	{
+		return FirstCollidable( false, y, x0, x1, outX );
+	}
+
+	bool World::FirstCollidable( bool column, int line, int from, int to, int& out ) const
 	{
-		if ( c.normal.x > 0.0f && gridCoords.x + 1 < mSize.x )
+		const int extent = ( column ) ? mSize.y : mSize.x;
+		if ( !mTileSet || line < 0 || line >= ( ( column ) ? mSize.x : mSize.y ) )
+			return false;
+
+		const int lo = glm::max( glm::min( from, to ), 0 );
+		const int hi = glm::min( glm::max( from, to ), extent - 1 );
+		if ( lo > hi )
+			return false;
+
+		const bool forward = ( to >= from );
+		const int lastChunk = ( ( forward ) ? hi : lo ) / WORLD_CHUNK_TILES;
+		for ( int c = ( ( forward ) ? lo : hi ) / WORLD_CHUNK_TILES; ; c += ( forward ) ? 1 : -1 )
 		{
-			if ( mTiles[ TILE_INDEX( gridCoords.x + 1, gridCoords.y ) ] )
-				return true;
+			const ChunkTiles* tiles = ( column )
+				? mChunks[ c * mChunkCount.x + line / WORLD_CHUNK_TILES ].tiles
+				: mChunks[ ( line / WORLD_CHUNK_TILES ) * mChunkCount.x + c ].tiles;
+			if ( tiles )
+			{
+				const int base = c * WORLD_CHUNK_TILES;
+				uint32_t mask = ( ( column ) ? tiles->columns : tiles->rows )[ line % WORLD_CHUNK_TILES ]
+					& BitRange( glm::max( lo - base, 0 ), glm::min( hi - base, WORLD_CHUNK_TILES - 1 ) );
+				while ( mask )
+				{
+					const int bit = ( forward ) ? LowestBit( mask ) : HighestBit( mask );
+					mask &= ~( 1u << bit );
+
+					const int index = ( column )
+						? ( line % WORLD_CHUNK_TILES ) * WORLD_CHUNK_TILES + bit
+						: bit * WORLD_CHUNK_TILES + line % WORLD_CHUNK_TILES;
+					if ( tiles->cells[ index ] & TILECELL_COLLIDABLE )
+					{
+						out = base + bit;
+						return true;
+					}
+				}
+			}
+
+			if ( c == lastChunk )
+				return false;
 		}
-		else if ( c.normal.x < 0.0f && gridCoords.x - 1 >= 0 )
+	}
+
+	bool World::SweepAabb( const Aabb& bounds, const glm::vec2& delta, SweepHit& outHit ) const
+	{
+		if ( !mTileSet )
+			return false;
+
+		const float tileSize = (float)TILE_PIXEL_SIZE;
+		const glm::vec2 min = bounds.GetMin();
+		const glm::vec2 max = bounds.GetMax();
+
+		// Per axis: direction, the last tile line the leading edge covers, the
+		// time it crosses into the next one and the time between crossings.
+		glm::ivec2 dir;
+		glm::ivec2 cell;
+		glm::vec2 next;
+		glm::vec2 step;
+		for ( int i = 0; i < 2; i++ )
 		{
-			if ( mTiles[ TILE_INDEX( gridCoords.x - 1, gridCoords.y ) ] )
-				return true;
+			dir[ i ] = ( delta[ i ] > 0.0f ) ? 1 : ( delta[ i ] < 0.0f ) ? -1 : 0;
+			if ( dir[ i ] > 0 )
+			{
+				cell[ i ] = (int)ceil( ( max[ i ] - SWEEP_EPSILON ) / tileSize ) - 1;
+				next[ i ] = ( ( cell[ i ] + 1 ) * tileSize - max[ i ] ) / delta[ i ];
+			}
+			else if ( dir[ i ] < 0 )
+			{
+				cell[ i ] = (int)floor( ( min[ i ] + SWEEP_EPSILON ) / tileSize );
+				next[ i ] = ( cell[ i ] * tileSize - min[ i ] ) / delta[ i ];
+			}
+			else
+			{
+				cell[ i ] = 0;
+				next[ i ] = std::numeric_limits< float >::infinity();
+			}
+			step[ i ] = ( dir[ i ] ) ? tileSize / fabs( delta[ i ] ) : 0.0f;
 		}
 
-		if ( c.normal.y > 0.0f && gridCoords.y + 1 < mSize.y )
+		for ( ;; )
 		{
-			if ( mTiles[ TILE_INDEX( gridCoords.x, gridCoords.y + 1 ) ] )
-				return true;
+			const int axis = ( next.x <= next.y ) ? 0 : 1;
+			const int other = 1 - axis;
+			const float t = glm::max( next[ axis ], 0.0f );
+			if ( t > 1.0f )
+				return false;
+
+			cell[ axis ] += dir[ axis ];
+			next[ axis ] += step[ axis ];
+
+			const int line = cell[ axis ];
+			if ( line < 0 || line >= mSize[ axis ] )
+				continue;
+
+			// Tiles the box covers along the other axis at t. The leading side
+			// uses the tracked cell so corners crossed at the same t are hit.
+			int first = (int)floor( ( min[ other ] + delta[ other ] * t + SWEEP_EPSILON ) / tileSize );
+			int last = (int)ceil( ( max[ other ] + delta[ other ] * t - SWEEP_EPSILON ) / tileSize ) - 1;
+			if ( dir[ other ] > 0 )
+				last = cell[ other ];
+			else if ( dir[ other ] < 0 )
+				first = cell[ other ];
+
+			first = glm::max( first, 0 );
+			last = glm::min( last, mSize[ other ] - 1 );
+			for ( int i = first; i <= last; i++ )
+			{
+				glm::ivec2 tile;
+				tile[ axis ] = line;
+				tile[ other ] = i;
+
+				const uint8_t bits = GetTileCell( tile );
+				const bool blocks = ( bits & TILECELL_SOLID )
+					|| ( ( bits & TILECELL_ONE_WAY ) && axis == 1 && dir[ 1 ] < 0 );
+				if ( blocks )
+				{
+					outHit.time = t;
+					outHit.normal = glm::vec2( 0.0f );
+					outHit.normal[ axis ] = (float)-dir[ axis ];
+					outHit.tile = tile;
+					return true;
+				}
+			}
 		}
-		else if( c.normal.y < 0.0f && gridCoords.y - 1 >= 0 )
+	}
+
+	bool World::Raycast( const glm::vec2& origin, const glm::vec2& dir, float maxDist, RaycastHit& outHit, int flags /* = 0 */ ) const
+	{
+		const float length = glm::length( dir );
+		if ( !mTileSet || length == 0.0f || maxDist < 0.0f )
+			return false;
+
+		const float tileSize = (float)TILE_PIXEL_SIZE;
+		const glm::vec2 d = dir / length;
+
+		// Clip to the world so rays from outside start at its edge. enter is
+		// the axis crossed getting in, -1 if origin is already inside.
+		float tMin = 0.0f;
+		float tMax = maxDist;
+		int enter = -1;
+		for ( int i = 0; i < 2; i++ )
+		{
+			const float hi = mSize[ i ] * tileSize;
+			if ( d[ i ] == 0.0f )
+			{
+				if ( origin[ i ] < 0.0f || origin[ i ] >= hi )
+					return false;
+				continue;
+			}
+
+			float t0 = -origin[ i ] / d[ i ];
+			float t1 = ( hi - origin[ i ] ) / d[ i ];
+			if ( t0 > t1 )
+				std::swap( t0, t1 );
+			if ( t0 > tMin )
+			{
+				tMin = t0;
+				enter = i;
+			}
+			tMax = glm::min( tMax, t1 );
+		}
+		if ( tMin > tMax )
+			return false;
+
+		// Amanatides-Woo: per axis the distance to the next tile line and
+		// the distance between lines.
+		const glm::vec2 start = origin + d * tMin;
+		glm::ivec2 cell = glm::clamp( glm::ivec2( glm::floor( start / tileSize ) ), glm::ivec2( 0 ), mSize - 1 );
+		glm::ivec2 sign;
+		glm::vec2 next;
+		glm::vec2 step;
+		for ( int i = 0; i < 2; i++ )
+		{
+			sign[ i ] = ( d[ i ] > 0.0f ) ? 1 : ( d[ i ] < 0.0f ) ? -1 : 0;
+			if ( sign[ i ] )
+			{
+				next[ i ] = ( ( cell[ i ] + ( sign[ i ] > 0 ) ) * tileSize - origin[ i ] ) / d[ i ];
+				step[ i ] = tileSize / fabs( d[ i ] );
+			}
+			else
+			{
+				next[ i ] = std::numeric_limits< float >::infinity();
+				step[ i ] = 0.0f;
+			}
+		}
+
+		float t = tMin;
+		int axis = enter;
+		for ( ;; )
 		{
-			if ( mTiles[ TILE_INDEX( gridCoords.x, gridCoords.y - 1 ) ] )
+			const uint8_t bits = GetTileCell( cell );
+			const bool blocks = ( bits & TILECELL_SOLID )
+				|| ( ( bits & TILECELL_ONE_WAY ) && !( flags & RAYCAST_IGNORE_ONE_WAY ) && axis == 1 && sign[ 1 ] < 0 );
+			if ( blocks )
+			{
+				outHit.distance = t;
+				outHit.point = origin + d * t;
+				outHit.normal = glm::vec2( 0.0f );
+				if ( axis >= 0 )
+					outHit.normal[ axis ] = (float)-sign[ axis ];
+				outHit.tile = cell;
 				return true;
+			}
+
+			axis = ( next.x <= next.y ) ? 0 : 1;
+			t = next[ axis ];
+			cell[ axis ] += sign[ axis ];
+			next[ axis ] += step[ axis ];
+			if ( t > tMax || cell[ axis ] < 0 || cell[ axis ] >= mSize[ axis ] )
+				return false;
 		}
+	}
 
-		return false;
+	int World::RaycastMany( const Ray* rays, int count, RaycastHit* outHits, int flags /* = 0 */ ) const
+	{
+		int hits = 0;
+		for ( int i = 0; i < count; i++ )
+		{
+			const Ray& ray = rays[ i ];
+			RaycastHit& hit = outHits[ i ];
+			if ( Raycast( ray.origin, ray.dir, ray.maxDist, hit, flags ) )
+			{
+				hits++;
+				continue;
+			}
+
+			const float length = glm::length( ray.dir );
+			hit.distance = ray.maxDist;
+			hit.point = ( length > 0.0f ) ? ray.origin + ray.dir * ( ray.maxDist / length ) : ray.origin;
+			hit.normal = glm::vec2( 0.0f );
+			hit.tile = glm::ivec2( -1 );
+		}
+		return hits;
 	}
 
 	void World::SetTile( const glm::ivec2& t, TileId id )
@@ -203,17 +731,78 @@ namespace Procyon {
 		if ( t.x < 0 || t.x >= mSize.x ||
 			 t.y < 0 || t.y >= mSize.y )
 			return;
-		mTiles[ TILE_INDEX( t.x, t.y ) ] = id;
+
+		Chunk& c = mChunks[ CHUNK_OF( t.x, t.y ) ];
+		if ( !c.tiles )
+		{
+			if ( !id )
+				return; // already air
+			c.tiles = new ChunkTiles();
+		}
+
+		const int lx = t.x % WORLD_CHUNK_TILES;
+		const int ly = t.y % WORLD_CHUNK_TILES;
+		TileId& tile = c.tiles->tiles[ CHUNK_TILE_INDEX( t.x, t.y ) ];
+		if ( !tile && id )
+		{
+			c.tiles->columns[ lx ] |= 1u << ly;
+			c.tiles->rows[ ly ] |= 1u << lx;
+			c.tiles->count++;
+		}
+		else if ( tile && !id )
+		{
+			c.tiles->columns[ lx ] &= ~( 1u << ly );
+			c.tiles->rows[ ly ] &= ~( 1u << lx );
+			c.tiles->count--;
+		}
+		tile = id;
+		c.dirty = true;
+
+		uint8_t& cell = c.tiles->cells[ CHUNK_TILE_INDEX( t.x, t.y ) ];
+		cell = ( id ) ? TileCellBits( id ) | NeighbourBits( t.x, t.y ) : 0;
+
+		// Neighbours facing t pick up whether it's solid now.
+		const glm::ivec2 offsets[ 4 ] = { glm::ivec2( -1, 0 ), glm::ivec2( 1, 0 ), glm::ivec2( 0, -1 ), glm::ivec2( 0, 1 ) };
+		const uint8_t facing[ 4 ] = { TILECELL_SOLID_RIGHT, TILECELL_SOLID_LEFT, TILECELL_SOLID_UP, TILECELL_SOLID_DOWN };
+		for ( int i = 0; i < 4; i++ )
+		{
+			const glm::ivec2 n = t + offsets[ i ];
+			if ( n.x < 0 || n.x >= mSize.x || n.y < 0 || n.y >= mSize.y )
+				continue;
+
+			ChunkTiles* neighbour = mChunks[ CHUNK_OF( n.x, n.y ) ].tiles;
+			if ( !neighbour || !neighbour->tiles[ CHUNK_TILE_INDEX( n.x, n.y ) ] )
+				continue; // air has no bits
+
+			uint8_t& bits = neighbour->cells[ CHUNK_TILE_INDEX( n.x, n.y ) ];
+			bits = ( cell & TILECELL_SOLID ) ? ( bits | facing[ i ] ) : ( bits & ~facing[ i ] );
+		}
+
+		if ( !c.tiles->count )
+		{
+			delete c.tiles;
+			c.tiles = nullptr;
+		}
 	}
 
 	TileId World::GetTile( const glm::ivec2& t ) const
 	{
-		return mTiles[ TILE_INDEX( t.x, t.y ) ];
+		const ChunkTiles* tiles = mChunks[ CHUNK_OF( t.x, t.y ) ].tiles;
+		return ( tiles ) ? tiles->tiles[ CHUNK_TILE_INDEX( t.x, t.y ) ] : 0;
 	}
 
 	const TileDef& World::GetTileDef( const glm::ivec2& t ) const
 	{
-		return mTileSet->GetTileDef( mTiles[ TILE_INDEX( t.x, t.y ) ] );
+		return mTileSet->GetTileDef( GetTile( t ) );
+	}
+
+	uint8_t World::GetTileCell( const glm::ivec2& t ) const
+	{
+		if ( t.x < 0 || t.x >= mSize.x || t.y < 0 || t.y >= mSize.y )
+			return 0;
+
+		const ChunkTiles* tiles = mChunks[ CHUNK_OF( t.x, t.y ) ].tiles;
+		return ( tiles ) ? tiles->cells[ CHUNK_TILE_INDEX( t.x, t.y ) ] : 0;
 	}
 
 	// Point in pixels
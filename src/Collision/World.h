@@ -26,6 +26,7 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 #define _WORLD_H
 
 #include "ProcyonCommon.h"
+#include "Graphics/RenderCore.h"
 
 #define TILE_PIXEL_SIZE 16
 #define HALF_TILE_SIZE (((float)TILE_PIXEL_SIZE)/2.0f)
@@ -33,14 +34,22 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 #define TILE_CENTER_TO_WORLD(x, y) ( TILE_TO_WORLD(x, y) + HALF_TILE_SIZE )
 #define WORLD_TO_TILE(x,y) glm::ivec2(x / TILE_PIXEL_SIZE, y / TILE_PIXEL_SIZE)
 
+// Edge length in tiles of the chunks World renders and culls by
+#define WORLD_CHUNK_TILES 32
+
 namespace Procyon {
 
 	class Renderable;
 	class Renderer;
+	class RenderCore;
+	class QuadBuffer;
 	class Texture;
 	class Camera2D;
 	class World;
 	class Contact;
+	struct SweepHit;
+	struct Ray;
+	struct RaycastHit;
 
 	// TileId type
 	typedef uint32_t TileId;
@@ -52,6 +61,25 @@ namespace Procyon {
 		TILETYPE_ONE_WAY	// "Jump-through" one-way platform
 	};
 
+	/*
+	================
+	TileCellFlags
+
+	Per tile byte World keeps beside the tile ids so collision tests don't
+	go through the TileSet. Solid means a collidable TILETYPE_SOLID tile.
+	================
+	*/
+	enum TileCellFlags
+	{
+		TILECELL_COLLIDABLE 	= BIT( 0 ),
+		TILECELL_SOLID 			= BIT( 1 ),
+		TILECELL_ONE_WAY 		= BIT( 2 ), 	// collidable TILETYPE_ONE_WAY
+		TILECELL_SOLID_LEFT 	= BIT( 4 ), 	// solid neighbour at x - 1
+		TILECELL_SOLID_RIGHT 	= BIT( 5 ), 	// solid neighbour at x + 1
+		TILECELL_SOLID_DOWN 	= BIT( 6 ), 	// solid neighbour at y - 1
+		TILECELL_SOLID_UP 		= BIT( 7 ) 		// solid neighbour at y + 1
+	};
+
 	struct TileDef
 	{
 		// Filepath for the texture
@@ -91,30 +119,109 @@ namespace Procyon {
 		virtual TileId GetTile( int x, int y ) const = 0;
 		virtual const TileSet* GetTileSet() const = 0;
         virtual glm::ivec2 GetSize() const = 0;
+
+		// All WORLD_CHUNK_TILES squared tiles of chunk, column major and zero
+		// padded past the map edge. NULL if the map only supports GetTile().
+		virtual const TileId* GetChunk( const glm::ivec2& chunk ) const { return NULL; }
 	};
 
 	class World
 	{
 	public:
+							World() = default;
+							~World();
+
+		// Owns its chunk storage, so copying would free it twice.
+							World( const World& ) = delete;
+		World& 				operator=( const World& ) = delete;
+
 		void 				NewWorld( const glm::ivec2& size, const TileSet* tileset );
 		void  				LoadMap( const Map* map );
+		// Draw the chunks overlapping the renderer's camera. Each chunk's quads
+		// are kept in a QuadBuffer and only rebuilt after SetTile() touches it.
 		void 				Render( Renderer *r );
 
-		void 				TileIntersection( const Aabb& bounds, std::vector<glm::ivec2>& out );
-		bool 				IsInternalCollision( const glm::ivec2& gridCoords, const Contact& c );
+		// Post the tiles in columns [beginX, endX) to rc. Only reads the world,
+		// so disjoint strips may be recorded from different threads.
+		void 				RenderStrip( RenderCore* rc, int beginX, int endX ) const;
+
+		void 				TileIntersection( const Aabb& bounds, std::vector<glm::ivec2>& out ) const;
+		bool 				IsInternalCollision( const glm::ivec2& gridCoords, const Contact& c ) const;
+
+		// First collidable tile walking column x from y0 to y1, or row y from
+		// x0 to x1, both inclusive and in either direction. Empty chunks and
+		// air are skipped a word at a time. Returns false if there is none.
+		bool 				FirstCollidableInColumn( int x, int y0, int y1, int& outY ) const;
+		bool 				FirstCollidableInRow( int y, int x0, int x1, int& outX ) const;
+
+		// Move bounds along delta through the grid and report the first tile
+		// it would enter. Solid tiles block from any side, one way tiles only
+		// from above. Tiles bounds already overlaps are ignored, resolve those
+		// with TileIntersection(). Allocation free and read only, so any number
+		// of bodies may sweep at once.
+		bool 				SweepAabb( const Aabb& bounds, const glm::vec2& delta, SweepHit& outHit ) const;
+
+		// First collidable tile along the ray within maxDist pixels, walking
+		// the grid a tile at a time. One way tiles only block rays entering
+		// through their top unless flags has RAYCAST_IGNORE_ONE_WAY.
+		bool 				Raycast( const glm::vec2& origin, const glm::vec2& dir, float maxDist, RaycastHit& outHit, int flags = 0 ) const;
+
+		// Raycast() each of rays into outHits, returning the number that hit.
+		// Misses get a distance of maxDist, a zero normal and tile ( -1, -1 ).
+		int 				RaycastMany( const Ray* rays, int count, RaycastHit* outHits, int flags = 0 ) const;
 
 		void 			 	SetTile( const glm::ivec2& t, TileId type );
 		TileId	 			GetTile( const glm::ivec2& t ) const;
 		const TileDef&	 	GetTileDef( const glm::ivec2& t ) const;
+
+		// TileCellFlags of t, 0 for air and outside the world. Kept up to date
+		// by SetTile() and LoadMap(), reload after changing the TileSet.
+		uint8_t 			GetTileCell( const glm::ivec2& t ) const;
 		const TileDef&		PointToTileDef( const glm::vec2& point ) const;
 
 		bool				InBounds( const glm::ivec2& t );
 		const glm::ivec2& 	GetSize() const { return mSize; }
 
+		// Bytes held by tile storage.
+		size_t 				GetTileMemory() const;
+
 	protected:
+		// Tiles of one chunk, only allocated while it holds a non air tile.
+		struct ChunkTiles
+		{
+			TileId 			tiles[ WORLD_CHUNK_TILES * WORLD_CHUNK_TILES ]; // column major
+			uint32_t 		columns[ WORLD_CHUNK_TILES ]; 	// bit y set if ( x, y ) is not air
+			uint32_t 		rows[ WORLD_CHUNK_TILES ]; 		// bit x set if ( x, y ) is not air
+			uint8_t 		cells[ WORLD_CHUNK_TILES * WORLD_CHUNK_TILES ]; // TileCellFlags, column major
+			int 			count; 							// non air tiles
+		};
+
+		struct Chunk
+		{
+			ChunkTiles* 	tiles = nullptr;
+			QuadBuffer* 	quads = nullptr;
+			bool 			dirty = true;
+		};
+
+		bool 				MakeTileQuad( int x, int y, BatchedQuad* out ) const;
+		void 				ResetChunks();
+		void 				ReleaseChunkQuads();
+		void 				SetChunkTiles( const glm::ivec2& chunk, const TileId* tiles );
+		uint8_t 			TileCellBits( TileId id ) const;
+		uint8_t 			NeighbourBits( int x, int y ) const;
+		void 				BuildNeighbourBits();
+		bool 				FirstCollidable( bool column, int line, int from, int to, int& out ) const;
+		void 				BuildChunk( const glm::ivec2& chunk );
+
 		const TileSet* 			mTileSet = nullptr;
 		glm::ivec2 				mSize;
-		std::vector< TileId >	mTiles;
+
+		// Tile storage and render buffers, chunk ( x, y ) is at y * mChunkCount.x + x.
+		// Chunk buffers are allocated from mChunkCore.
+		RenderCore* 				mChunkCore = nullptr;
+		glm::ivec2 					mChunkCount;
+		std::vector< Chunk > 		mChunks;
+		std::vector< BatchedQuad > 	mChunkScratch;
 	};
 
 } /* namespace Procyon */
@@ -0,0 +1,471 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "XmlMapReader.h"
+
+namespace Procyon {
+
+	static bool ParseInt( const char* str, int& out )
+	{
+		if ( !str )
+			return false;
+
+		char* end = NULL;
+		const long value = strtol( str, &end, 10 );
+		if ( end == str )
+			return false;
+
+		while ( isspace( (unsigned char)*end ) )
+			end++;
+
+		out = (int)value;
+		return *end == '\0';
+	}
+
+	static void AppendUtf8( std::string& out, unsigned long code )
+	{
+		if ( code < 0x80 )
+		{
+			out.push_back( (char)code );
+		}
+		else if ( code < 0x800 )
+		{
+			out.push_back( (char)( 0xC0 | ( code >> 6 ) ) );
+			out.push_back( (char)( 0x80 | ( code & 0x3F ) ) );
+		}
+		else if ( code < 0x10000 )
+		{
+			out.push_back( (char)( 0xE0 | ( code >> 12 ) ) );
+			out.push_back( (char)( 0x80 | ( ( code >> 6 ) & 0x3F ) ) );
+			out.push_back( (char)( 0x80 | ( code & 0x3F ) ) );
+		}
+		else
+		{
+			out.push_back( (char)( 0xF0 | ( code >> 18 ) ) );
+			out.push_back( (char)( 0x80 | ( ( code >> 12 ) & 0x3F ) ) );
+			out.push_back( (char)( 0x80 | ( ( code >> 6 ) & 0x3F ) ) );
+			out.push_back( (char)( 0x80 | ( code & 0x3F ) ) );
+		}
+	}
+
+	XmlMapReader::XmlMapReader()
+		: mPos( 0 )
+		, mEnd( 0 )
+		, mLine( 1 )
+		, mDepth( 0 )
+		, mAttrCount( 0 )
+		, mTilesSeen( false )
+	{
+	}
+
+	bool XmlMapReader::Read( const std::string& filePath )
+	{
+		mStream.open( filePath.c_str(), std::ios::in | std::ios::binary );
+		if ( !mStream )
+		{
+			PROCYON_WARN( "XmlMapReader", "Unable to open '%s'.", filePath.c_str() );
+			mStream.clear();
+			return false;
+		}
+
+		mPos 		= 0;
+		mEnd 		= 0;
+		mLine 		= 1;
+		mDepth 		= 0;
+		mAttrCount 	= 0;
+		mTilesSeen 	= false;
+		mSize 		= glm::ivec2();
+		mTile 		= glm::ivec2();
+		mText.clear();
+
+		const bool success = Parse();
+		if ( !success )
+		{
+			PROCYON_WARN( "XmlMapReader", "Failed to read map xml '%s' near line %i.", filePath.c_str(), mLine );
+		}
+
+		mStream.close();
+		mStream.clear();
+		return success;
+	}
+
+	/* static */ const char* XmlMapReader::FindAttribute( const Attribute* attrs, int count, const char* name )
+	{
+		for ( int i = 0; i < count; i++ )
+		{
+			if ( strcmp( attrs[ i ].name, name ) == 0 )
+				return attrs[ i ].value;
+		}
+		return NULL;
+	}
+
+	bool XmlMapReader::Parse()
+	{
+		bool sawRoot = false;
+		for ( int c = Get(); c != EOF; c = Get() )
+		{
+			// Character data
+			if ( c != '<' )
+			{
+				if ( mDepth == 0 )
+				{
+					if ( !isspace( c ) )
+						return false;
+				}
+				else if ( c == '&' )
+				{
+					if ( !ReadEntity( mText ) )
+						return false;
+				}
+				else
+				{
+					mText.push_back( (char)c );
+				}
+				continue;
+			}
+
+			// Declarations, comments, CDATA and doctype
+			if ( Match( "?" ) )
+			{
+				if ( !SkipPast( "?>", NULL ) )
+					return false;
+				continue;
+			}
+			if ( Match( "!" ) )
+			{
+				bool ok;
+				if ( Match( "--" ) )
+					ok = SkipPast( "-->", NULL );
+				else if ( Match( "[CDATA[" ) )
+					ok = SkipPast( "]]>", ( mDepth > 0 ) ? &mText : NULL );
+				else
+					ok = SkipPast( ">", NULL );
+
+				if ( !ok )
+					return false;
+				continue;
+			}
+
+			// </name>
+			if ( Match( "/" ) )
+			{
+				if ( !ReadName( mName ) )
+					return false;
+
+				SkipSpace();
+				if ( Get() != '>' || mDepth == 0 || mStack[ mDepth - 1 ] != mName )
+					return false;
+
+				if ( !EndElement() )
+					return false;
+				continue;
+			}
+
+			// <name attr="value" ... /?>
+			if ( !ReadName( mName ) || ( mDepth == 0 && sawRoot ) )
+				return false;
+			sawRoot = true;
+
+			bool empty = false;
+			mAttrCount = 0;
+			for ( ;; )
+			{
+				SkipSpace();
+				if ( Match( ">" ) )
+					break;
+				if ( Match( "/" ) )
+				{
+					if ( Get() != '>' )
+						return false;
+					empty = true;
+					break;
+				}
+
+				if ( mAttrCount == (int)mAttrNames.size() )
+				{
+					mAttrNames.emplace_back();
+					mAttrValues.emplace_back();
+				}
+				std::string& name = mAttrNames[ mAttrCount ];
+				std::string& value = mAttrValues[ mAttrCount ];
+
+				if ( !ReadName( name ) )
+					return false;
+
+				SkipSpace();
+				if ( Get() != '=' )
+					return false;
+
+				SkipSpace();
+				const int quote = Get();
+				if ( quote != '"' && quote != '\'' )
+					return false;
+
+				value.clear();
+				for ( int v = Get(); v != quote; v = Get() )
+				{
+					if ( v == EOF || v == '<' )
+						return false;
+
+					if ( v == '&' )
+					{
+						if ( !ReadEntity( value ) )
+							return false;
+					}
+					else
+					{
+						value.push_back( (char)v );
+					}
+				}
+				mAttrCount++;
+			}
+
+			// Strings may have moved while growing, point at them only now.
+			mAttrs.resize( mAttrCount );
+			for ( int i = 0; i < mAttrCount; i++ )
+			{
+				mAttrs[ i ].name = mAttrNames[ i ].c_str();
+				mAttrs[ i ].value = mAttrValues[ i ].c_str();
+			}
+
+			if ( !StartElement() || ( empty && !EndElement() ) )
+				return false;
+		}
+
+		return sawRoot && mDepth == 0 && mTilesSeen;
+	}
+
+	bool XmlMapReader::StartElement()
+	{
+		const ElementKind parent = ( mDepth > 0 ) ? mKinds[ mDepth - 1 ] : ELEMENT_OTHER;
+
+		ElementKind kind = ELEMENT_OTHER;
+		if ( mDepth == 0 )
+		{
+			if ( mName != "Map" )
+				return false;
+			kind = ELEMENT_MAP;
+		}
+		else if ( parent == ELEMENT_MAP && mName == "TileSet" )
+			kind = ELEMENT_TILESET;
+		else if ( parent == ELEMENT_MAP && mName == "Tiles" && !mTilesSeen )
+			kind = ELEMENT_TILES;
+		else if ( parent == ELEMENT_TILESET && mName == "TileDef" )
+			kind = ELEMENT_TILEDEF;
+		else if ( parent == ELEMENT_TILES && mName == "TileRow" )
+			kind = ELEMENT_TILEROW;
+		else if ( parent == ELEMENT_TILEROW && mName == "Tile" )
+			kind = ELEMENT_TILE;
+
+		if ( mDepth == (int)mStack.size() )
+		{
+			mStack.emplace_back();
+			mKinds.push_back( kind );
+		}
+		mStack[ mDepth ] = mName;
+		mKinds[ mDepth ] = kind;
+		mDepth++;
+		mText.clear();
+
+		const Attribute* attrs = mAttrs.data();
+		switch ( kind )
+		{
+			case ELEMENT_TILEDEF:
+			{
+				TileDef def;
+				const char* filepath = FindAttribute( attrs, mAttrCount, "filepath" );
+				if ( filepath )
+				{
+					def.filepath = filepath;
+					def.collidable = true;
+				}
+
+				const char* type = FindAttribute( attrs, mAttrCount, "type" );
+				if ( type )
+				{
+					def.type = TileDef::StringToTileType( type );
+				}
+
+				OnTileDef( def );
+				return true;
+			}
+			case ELEMENT_TILES:
+			{
+				if ( !ParseInt( FindAttribute( attrs, mAttrCount, "width" ), mSize.x )
+					|| !ParseInt( FindAttribute( attrs, mAttrCount, "height" ), mSize.y )
+					|| mSize.x <= 0
+					|| mSize.y <= 0 )
+				{
+					return false;
+				}
+				mTilesSeen = true;
+				return OnTilesBegin( mSize );
+			}
+			case ELEMENT_TILEROW: return ParseInt( FindAttribute( attrs, mAttrCount, "index" ), mTile.x );
+			case ELEMENT_TILE: return ParseInt( FindAttribute( attrs, mAttrCount, "index" ), mTile.y );
+			case ELEMENT_OTHER:
+			{
+				OnStartElement( mName.c_str(), attrs, mAttrCount );
+				return true;
+			}
+			default: return true;
+		}
+	}
+
+	bool XmlMapReader::EndElement()
+	{
+		mDepth--;
+		switch ( mKinds[ mDepth ] )
+		{
+			case ELEMENT_TILE:
+			{
+				if ( mTile.x >= 0 && mTile.x < mSize.x &&
+					 mTile.y >= 0 && mTile.y < mSize.y )
+				{
+					OnTile( mTile.x, mTile.y, (TileId)atoi( mText.c_str() ) );
+				}
+				break;
+			}
+			case ELEMENT_OTHER:
+			{
+				OnEndElement( mStack[ mDepth ].c_str(), mText.c_str() );
+				break;
+			}
+			default: break;
+		}
+		mText.clear();
+		return true;
+	}
+
+	int XmlMapReader::Peek()
+	{
+		if ( mPos == mEnd )
+		{
+			mStream.read( mBuffer, sizeof( mBuffer ) );
+			mPos = 0;
+			mEnd = (int)mStream.gcount();
+			if ( mEnd == 0 )
+				return EOF;
+		}
+		return (unsigned char)mBuffer[ mPos ];
+	}
+
+	int XmlMapReader::Get()
+	{
+		const int c = Peek();
+		if ( c != EOF )
+		{
+			mPos++;
+			if ( c == '\n' )
+				mLine++;
+		}
+		return c;
+	}
+
+	bool XmlMapReader::Match( const char* str )
+	{
+		for ( ; *str; str++ )
+		{
+			if ( Peek() != (unsigned char)*str )
+				return false;
+			Get();
+		}
+		return true;
+	}
+
+	bool XmlMapReader::SkipPast( const char* terminator, std::string* out )
+	{
+		const size_t len = strlen( terminator );
+		char last[ 4 ] = { 0 };
+		assert( len <= sizeof( last ) );
+
+		for ( ;; )
+		{
+			const int c = Get();
+			if ( c == EOF )
+				return false;
+
+			memmove( last, last + 1, len - 1 );
+			last[ len - 1 ] = (char)c;
+			if ( out )
+				out->push_back( (char)c );
+
+			if ( memcmp( last, terminator, len ) == 0 )
+			{
+				if ( out )
+					out->resize( out->size() - len );
+				return true;
+			}
+		}
+	}
+
+	void XmlMapReader::SkipSpace()
+	{
+		while ( Peek() != EOF && isspace( Peek() ) )
+			Get();
+	}
+
+	bool XmlMapReader::ReadName( std::string& out )
+	{
+		out.clear();
+		for ( int c = Peek(); c != EOF && ( isalnum( c ) || c == '_' || c == '-' || c == ':' || c == '.' || c >= 0x80 ); c = Peek() )
+		{
+			out.push_back( (char)Get() );
+		}
+		return !out.empty();
+	}
+
+	bool XmlMapReader::ReadEntity( std::string& out )
+	{
+		char name[ 12 ];
+		int len = 0;
+		for ( int c = Get(); c != ';'; c = Get() )
+		{
+			if ( c == EOF || len == sizeof( name ) - 1 )
+				return false;
+			name[ len++ ] = (char)c;
+		}
+		name[ len ] = '\0';
+
+		if ( strcmp( name, "lt" ) == 0 ) 		out.push_back( '<' );
+		else if ( strcmp( name, "gt" ) == 0 ) 	out.push_back( '>' );
+		else if ( strcmp( name, "amp" ) == 0 ) 	out.push_back( '&' );
+		else if ( strcmp( name, "quot" ) == 0 ) out.push_back( '"' );
+		else if ( strcmp( name, "apos" ) == 0 ) out.push_back( '\'' );
+		else if ( name[ 0 ] == '#' )
+		{
+			char* end = NULL;
+			const unsigned long code = ( name[ 1 ] == 'x' ) ? strtoul( name + 2, &end, 16 ) : strtoul( name + 1, &end, 10 );
+			if ( *end != '\0' || code == 0 || code > 0x10FFFF )
+				return false;
+			AppendUtf8( out, code );
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	}
+
+} /* namespace Procyon */
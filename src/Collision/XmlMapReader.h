@@ -0,0 +1,129 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _XML_MAP_READER_H
+#define _XML_MAP_READER_H
+
+#include "ProcyonCommon.h"
+#include "World.h"
+
+#define XML_MAP_READER_BUFFER_SIZE 65536
+
+namespace Procyon {
+
+	/*
+	================
+	XmlMapReader
+
+	Streams an xml map file through a fixed size buffer, handing tiles out as
+	<Tile> elements are scanned. No document is ever built, so a map costs
+	only what the subclass stores. Elements outside of <TileSet> and <Tiles>
+	are passed through OnStartElement()/OnEndElement() untouched.
+
+		<Map>
+			<TileSet> <TileDef filepath="" type=""/> ... </TileSet>
+			<Tiles width="" height="">
+				<TileRow index="x"> <Tile index="y">id</Tile> ... </TileRow>
+			</Tiles>
+		</Map>
+	================
+	*/
+	class XmlMapReader
+	{
+	public:
+		struct Attribute
+		{
+			const char* name;
+			const char* value;
+		};
+
+							XmlMapReader();
+		virtual 			~XmlMapReader() { }
+
+		// Returns false if the file is missing, malformed or a callback
+		// aborted the read.
+		bool 				Read( const std::string& filePath );
+
+		static const char* 	FindAttribute( const Attribute* attrs, int count, const char* name );
+
+	protected:
+		virtual void 		OnTileDef( const TileDef& def ) { }
+		// Called once before any OnTile(), return false to abort.
+		virtual bool 		OnTilesBegin( const glm::ivec2& size ) { return true; }
+		virtual void 		OnTile( int x, int y, TileId tile ) { }
+
+		// Any other element below <Map>. text is the element's own character
+		// data, only valid during the call.
+		virtual void 		OnStartElement( const char* name, const Attribute* attrs, int count ) { }
+		virtual void 		OnEndElement( const char* name, const char* text ) { }
+
+	private:
+		enum ElementKind
+		{
+			ELEMENT_OTHER,
+			ELEMENT_MAP,
+			ELEMENT_TILESET,
+			ELEMENT_TILEDEF,
+			ELEMENT_TILES,
+			ELEMENT_TILEROW,
+			ELEMENT_TILE
+		};
+
+		bool 				Parse();
+		bool 				StartElement();
+		bool 				EndElement();
+
+		int 				Peek();
+		int 				Get();
+		bool 				Match( const char* str );
+		bool 				SkipPast( const char* terminator, std::string* out );
+		void 				SkipSpace();
+		bool 				ReadName( std::string& out );
+		bool 				ReadEntity( std::string& out );
+
+		std::ifstream 					mStream;
+		char 							mBuffer[ XML_MAP_READER_BUFFER_SIZE ];
+		int 							mPos;
+		int 							mEnd;
+		int 							mLine;
+
+		// Element stack, strings are reused between elements.
+		std::string 					mName;
+		std::string 					mText;
+		std::vector< std::string > 		mStack;
+		std::vector< ElementKind > 		mKinds;
+		int 							mDepth;
+		std::vector< std::string > 		mAttrNames;
+		std::vector< std::string > 		mAttrValues;
+		std::vector< Attribute > 		mAttrs;
+		int 							mAttrCount;
+
+		glm::ivec2 						mSize;
+		glm::ivec2 						mTile;
+		bool 							mTilesSeen;
+	};
+
+} /* namespace Procyon */
+
+#endif /* _XML_MAP_READER_H */
@@ -496,6 +496,11 @@ namespace Procyon {
             sDebugLines = !sDebugLines;
             Console_PrintLine( std::string( "line debugging " ) + ( ( sDebugLines ) ? "enabled": "disabled" ), sSystemColor );
 		}
+		else if ( cmd == "gpu_polylines")
+		{
+            sGpuPolyLines = !sGpuPolyLines;
+            Console_PrintLine( std::string( "gpu polylines " ) + ( ( sGpuPolyLines ) ? "enabled": "disabled" ), sSystemColor );
+		}
         else
         {
             Console_PrintLine( "Unknown command!",  sErrorColor );
@@ -41,6 +41,13 @@ AnimatedSprite::AnimatedSprite( Texture* texture )
 {
 }
 
+AnimatedSprite::AnimatedSprite( const AtlasRegion& region )
+    : Sprite( region )
+    , mLifespan( 0.0f )
+	, mPlaying( false )
+{
+}
+
 void AnimatedSprite::Play()
 {
 	mPlaying = true;
@@ -37,6 +37,7 @@ namespace Procyon
     public:
 		AnimatedSprite();
         AnimatedSprite( Procyon::Texture* texture );
+        AnimatedSprite( const Procyon::AtlasRegion& region );
 
         void Process( Procyon::FrameTime t );
     	void Play();
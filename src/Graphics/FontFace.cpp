@@ -104,6 +104,7 @@ namespace Procyon {
 		, atlas( NULL )
 	{
 		memset( (void*)glyphs, 0, sizeof( atlas ) );
+		memset( (void*)kerning, 0, sizeof( kerning ) );
 
         PROCYON_DEBUG( "FontFace", "CachedFontSize size %i", fontsize );
 
@@ -121,6 +122,8 @@ namespace Procyon {
         if ( !CacheGlyphMetrics( face ) )
             return;
 
+        CacheKerning( face );
+
         /* compute glyph locations in the atlas- retry with larger dimensions upon failed pack */
         glm::ivec2 dims = glm::ivec2( DEFAULT_FONT_IMG_X, DEFAULT_FONT_IMG_Y );
         while ( !ComputeAtlasPacking( dims ) )
@@ -170,6 +173,34 @@ namespace Procyon {
         return true; // success
     }
 
+    void CachedFontSize::CacheKerning( FT_Face face )
+    {
+        if ( !FT_HAS_KERNING( face ) )
+            return;
+
+        FT_UInt indices[ GLYPH_COUNT ];
+        for ( int i = 0; i < GLYPH_COUNT; ++i )
+        {
+            indices[ i ] = FT_Get_Char_Index( face, i + 32 );
+        }
+
+        /* expects the face already set to this pixel size */
+        for ( int left = 0; left < GLYPH_COUNT; ++left )
+        {
+            for ( int right = 0; right < GLYPH_COUNT; ++right )
+            {
+                FT_Vector kern;
+                if ( FT_Get_Kerning( face, indices[ left ], indices[ right ], FT_KERNING_DEFAULT, &kern ) != FT_Err_Ok )
+                {
+                    PROCYON_DEBUG( "FontFace", "Kern Error" );
+                    continue;
+                }
+
+                kerning[ left ][ right ] = (short)( kern.x >> 6 );
+            }
+        }
+    }
+
     bool CachedFontSize::ComputeAtlasPacking( glm::ivec2 dims )
     {
         assert( dims.x <= FONT_IMG_DIM_MAX && dims.y <= FONT_IMG_DIM_MAX );
@@ -253,7 +284,9 @@ namespace Procyon {
             //    , code + 32, g.uvoff.x, g.uvoff.y, g.uvsize.x, g.uvsize.y );
         }
 
-	    atlas = Texture::Allocate( img );
+	    // Sizes can be cached mid frame, e.g. by a pipelined MainLoop's
+	    // worker, so the upload waits for the atlas to be drawn.
+	    atlas = Texture::AllocateDeferred( img );
 	    atlas->SetMinMagFilter( FILTER_LINEAR, FILTER_LINEAR);
         return true; // success
     }
@@ -345,22 +378,14 @@ namespace Procyon {
 
 	int FontFace::GetKerning( unsigned int fontsize, unsigned int cb1, unsigned int cb2 ) const
 	{
-        if ( !mFace || !FT_HAS_KERNING( mFace ) )
-            return 0;
-
-        FT_Set_Pixel_Sizes( mFace, 0, fontsize );
+		if ( cb1 < 32 || cb1 >= (32 + GLYPH_COUNT) || cb2 < 32 || cb2 >= (32 + GLYPH_COUNT) )
+			return 0;
 
-        FT_UInt idx1 = FT_Get_Char_Index( mFace, cb1 );
-        FT_UInt idx2 = FT_Get_Char_Index( mFace, cb2 );
-
-        FT_Vector kern;
-        if ( FT_Get_Kerning( mFace, idx1, idx2, FT_KERNING_DEFAULT, &kern  ) != FT_Err_Ok )
-        {
-            PROCYON_DEBUG( "FontFace", "Kern Error" );
-            return 0;
-        }
+		auto search = mCache.find( fontsize );
+		if ( search == mCache.end() )
+			return 0;
 
-		return kern.x >> 6;
+		return search->second->kerning[ cb1 - 32 ][ cb2 - 32 ];
 	}
 
 	FontMetrics FontFace::GetMetrics( unsigned int fontsize ) const
@@ -69,10 +69,16 @@ namespace Procyon {
     	Texture*   	 atlas;
         FontMetrics             metrics;
 
+        // Pixel kerning of every supported glyph pair, [left][right] offset
+        // by the first supported character. Read instead of FreeType so
+        // drawing text never touches the shared FT_Face.
+        short                   kerning[ GLYPH_COUNT ][ GLYPH_COUNT ];
+
 		CachedFontSize( unsigned int fontsize, FT_Face face );
 
     protected:
         bool  CacheGlyphMetrics( FT_Face face );
+        void  CacheKerning( FT_Face face );
         bool ComputeAtlasPacking( glm::ivec2 dims );
         bool Rasterize( FT_Face face, glm::ivec2 dims );
 	};
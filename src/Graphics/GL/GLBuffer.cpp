@@ -23,6 +23,7 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 ===========================================================================
 */
 #include "GLBuffer.h"
+#include "GLStateCache.h"
 
 namespace Procyon {
 
@@ -30,6 +31,7 @@ namespace GL {
 
 	GLBuffer::GLBuffer()
 		: mAllocated( false )
+		, mSize( 0 )
 	{
 		glGenBuffers( 1, &mBufferId );
 	}
@@ -38,6 +40,7 @@ namespace GL {
 	GLBuffer::GLBuffer( GLsizeiptr size, const void* data
 		, GLenum usage /* = GL_STATIC_DRAW */ )
 		: mAllocated( false )
+		, mSize( 0 )
 	{
 		glGenBuffers( 1, &mBufferId );
 		SetData( size, data, usage );
@@ -45,17 +48,19 @@ namespace GL {
 
 	GLBuffer::~GLBuffer()
 	{
+		GLStateCache::Get().BufferDeleted( mBufferId );
 		glDeleteBuffers( 1, &mBufferId );
 	}
 
 	void GLBuffer::SetData( GLsizeiptr size, const void* data
 		, GLenum usage /* = GL_STATIC_DRAW */ )
 	{
-	    glBindBuffer( GL_ARRAY_BUFFER, mBufferId );
+	    GLStateCache::Get().BindBuffer( GL_ARRAY_BUFFER, mBufferId );
 
-	    if ( !mAllocated )
+	    if ( !mAllocated || size > mSize )
 	    {
 	    	glBufferData( GL_ARRAY_BUFFER, size, data, usage );
+	    	mSize = size;
 	    }
 	    else
 	    {
@@ -71,7 +76,7 @@ namespace GL {
 
 	void GLBuffer::Bind( GLenum target )
 	{
-	    glBindBuffer( target, mBufferId );
+	    GLStateCache::Get().BindBuffer( target, mBufferId );
 	}
 
 } /* namespace GL */
@@ -40,10 +40,12 @@ namespace GL {
 
 		void 	SetData( GLsizeiptr size, const void* data, GLenum usage = GL_STATIC_DRAW );
 		void 	Bind( GLenum target );
+		GLuint 	GetId() const { return mBufferId; }
 
 	protected:
-		bool 	mAllocated;
-		GLuint 	mBufferId;
+		bool 		mAllocated;
+		GLsizeiptr 	mSize;
+		GLuint 		mBufferId;
 	};
 
 	typedef std::shared_ptr<GLBuffer> GLBufferPtr;
@@ -23,6 +23,7 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 ===========================================================================
 */
 #include "GLGeometry.h"
+#include "GLStateCache.h"
 #include "GLBuffer.h"
 #include "GLProgram.h"
 
@@ -40,12 +41,13 @@ namespace GL {
 
 	GLGeometry::~GLGeometry()
 	{
+		GLStateCache::Get().VertexArrayDeleted( mVaoId );
 		glDeleteVertexArrays( 1, &mVaoId );
 	}
 
 	void GLGeometry::Bind( const GLProgram* program ) const
 	{
-        glBindVertexArray( mVaoId );
+        GLStateCache::Get().BindVertexArray( mVaoId );
 
         if ( mIndices )
         	mIndices->Bind( GL_ELEMENT_ARRAY_BUFFER );
@@ -69,7 +71,7 @@ namespace GL {
 
 	void GLGeometry::Unbind()
 	{
-        glBindVertexArray( 0 );
+        GLStateCache::Get().BindVertexArray( 0 );
 	}
 
 	void GLGeometry::SetIndexBuffer( const GLBufferPtr& buf, int indexCount
@@ -23,6 +23,7 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 ===========================================================================
 */
 #include "GLMaterial.h"
+#include "GLStateCache.h"
 #include "GLTexture.h"
 #include "GLProgram.h"
 
@@ -42,6 +43,7 @@ namespace GL {
 
 	void GLMaterial::Bind() const
 	{
+		GLStateCache& cache = GLStateCache::Get();
 		mProgram->Bind();
 
 		int i = 0;
@@ -49,8 +51,8 @@ namespace GL {
 		{
 			if ( sampler.location != -1 )
 			{
-				glUniform1i( sampler.location, i );
-				glActiveTexture( GL_TEXTURE0 +  i );
+				cache.UniformInts( sampler.location, 1, &i );
+				cache.ActiveTexture( i );
 				sampler.texture->Bind();
 				i++;
 			}
@@ -65,61 +67,19 @@ namespace GL {
 				switch ( uniform.type )
 				{
 				case UNIFORM_FLOAT:
-					switch( uniform.components)
-					{
-					case 1:
-						glUniform1fv( uniform.location, 1, &uniform.f[0] );
-						break;
-					case 2:
-						glUniform2fv( uniform.location, 1, &uniform.f[0] );
-						break;
-					case 3:
-						glUniform3fv( uniform.location, 1, &uniform.f[0] );
-						break;
-					case 4:
-						glUniform4fv( uniform.location, 1, &uniform.f[0] );
-						break;
-					}
+					cache.UniformFloats( uniform.location, uniform.components, &uniform.f[0] );
 					break;
 				case UNIFORM_INT:
-					switch( uniform.components)
-					{
-					case 1:
-						glUniform1iv( uniform.location, 1, &uniform.i[0] );
-						break;
-					case 2:
-						glUniform2iv( uniform.location, 1, &uniform.i[0] );
-						break;
-					case 3:
-						glUniform3iv( uniform.location, 1, &uniform.i[0] );
-						break;
-					case 4:
-						glUniform4iv( uniform.location, 1, &uniform.i[0] );
-						break;
-					}
+					cache.UniformInts( uniform.location, uniform.components, &uniform.i[0] );
 					break;
 				case UNIFORM_UINT:
-					switch( uniform.components)
-					{
-					case 1:
-						glUniform1uiv( uniform.location, 1, &uniform.u[0] );
-						break;
-					case 2:
-						glUniform2uiv( uniform.location, 1, &uniform.u[0] );
-						break;
-					case 3:
-						glUniform3uiv( uniform.location, 1, &uniform.u[0] );
-						break;
-					case 4:
-						glUniform4uiv( uniform.location, 1, &uniform.u[0] );
-						break;
-					}
+					cache.UniformUInts( uniform.location, uniform.components, &uniform.u[0] );
 					break;
 				case UNIFORM_MAT_3_3:
-					glUniformMatrix3fv( uniform.location, 1, false, &uniform.m3[0][0] );
+					cache.UniformMatrix3( uniform.location, &uniform.m3[0][0] );
 					break;
 				case UNIFORM_MAT_4_4:
-					glUniformMatrix4fv( uniform.location, 1, false, &uniform.m4[0][0] );
+					cache.UniformMatrix4( uniform.location, &uniform.m4[0][0] );
 					break;
 				}
 			}
@@ -23,15 +23,58 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 ===========================================================================
 */
 #include "GLProgram.h"
+#include "GLStateCache.h"
 #include "GLShader.h"
 
 namespace Procyon {
 
 namespace GL {
 
+struct LayoutBinding
+{
+	const char* 			name;
+	GLint GLProgramLayout::* location;
+	bool 					uniform;
+};
+
+// Every GLProgramLayout member must appear at least once. When several names
+// share a member the first one found in the program wins.
+static const LayoutBinding sLayoutBindings[] =
+{
+	{ "screenSpaceTransform", 	&GLProgramLayout::screenSpaceTransform, true },
+	{ "modelViewMat", 			&GLProgramLayout::modelView, 			true },
+	{ "u_mv_matrix", 			&GLProgramLayout::modelView, 			true },
+	{ "projectionMat", 			&GLProgramLayout::projection, 			true },
+	{ "u_p_matrix", 			&GLProgramLayout::projection, 			true },
+	{ "tex", 					&GLProgramLayout::tex, 					true },
+	{ "color", 					&GLProgramLayout::color, 				true },
+	{ "u_linewidth", 			&GLProgramLayout::lineWidth, 			true },
+	{ "feather", 				&GLProgramLayout::feather, 				true },
+	{ "u_miterlimit", 			&GLProgramLayout::miterLimit, 			true },
+	{ "u_join", 				&GLProgramLayout::joinMode, 			true },
+	{ "u_cap", 					&GLProgramLayout::capMode, 				true },
+	{ "vertPosition", 			&GLProgramLayout::vertPosition, 		false },
+	{ "vertNormal", 			&GLProgramLayout::vertNormal, 			false },
+	{ "vertColor", 				&GLProgramLayout::vertColor, 			false },
+	{ "vertLine", 				&GLProgramLayout::vertLine, 			false },
+	{ "uv", 					&GLProgramLayout::uv, 					false },
+	{ "quadPos", 				&GLProgramLayout::quadPos, 				false },
+	{ "quadSize", 				&GLProgramLayout::quadSize, 			false },
+	{ "quadRotRads", 			&GLProgramLayout::quadRotRads, 			false },
+	{ "quadTint", 				&GLProgramLayout::quadTint, 			false },
+	{ "quadOrigin", 			&GLProgramLayout::quadOrigin, 			false },
+	{ "quadUVOffset", 			&GLProgramLayout::quadUVOffset, 		false },
+	{ "quadUVSize", 			&GLProgramLayout::quadUVSize, 			false },
+	{ "pointPrev", 				&GLProgramLayout::pointPrev, 			false },
+	{ "pointStart", 			&GLProgramLayout::pointStart, 			false },
+	{ "pointEnd", 				&GLProgramLayout::pointEnd, 			false },
+	{ "pointNext", 				&GLProgramLayout::pointNext, 			false }
+};
+
 GLProgram::GLProgram()
 {
 	mProgramId = glCreateProgram();
+	ResolveLayout();
 }
 
 GLProgram::GLProgram( const std::string& vertFilename, const std::string& fragFileName )
@@ -60,6 +103,7 @@ GLProgram::GLProgram( const std::string& vertFilename, const std::string& fragFi
 
 GLProgram::~GLProgram()
 {
+	GLStateCache::Get().ProgramDeleted( mProgramId );
 	glDeleteProgram( mProgramId );
 }
 
@@ -71,11 +115,41 @@ void GLProgram::Link( GLShader* shader[], int count )
 	}
 
 	glLinkProgram( mProgramId );
+	GLStateCache::Get().ProgramLinked( mProgramId );
+	ResolveLayout();
+}
+
+void GLProgram::ResolveLayout()
+{
+	for ( const LayoutBinding& binding : sLayoutBindings )
+	{
+		mLayout.*binding.location = -1;
+	}
+
+	GLint linked = GL_FALSE;
+	glGetProgramiv( mProgramId, GL_LINK_STATUS, &linked );
+	if ( linked != GL_TRUE )
+		return;
+
+	for ( const LayoutBinding& binding : sLayoutBindings )
+	{
+		if ( mLayout.*binding.location != -1 )
+			continue;
+
+		mLayout.*binding.location = ( binding.uniform )
+			? glGetUniformLocation( mProgramId, binding.name )
+			: glGetAttribLocation( mProgramId, binding.name );
+	}
+}
+
+const GLProgramLayout& GLProgram::GetLayout() const
+{
+	return mLayout;
 }
 
 void GLProgram::Bind() const
 {
-    glUseProgram( mProgramId );
+    GLStateCache::Get().UseProgram( mProgramId );
 }
 
 
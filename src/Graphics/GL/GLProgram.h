@@ -33,6 +33,47 @@ namespace GL {
 
 	class GLShader;
 
+	/*
+	================
+	GLProgramLayout
+
+	Uniform and attribute locations resolved once at link time. Locations the
+	program does not use are -1, which GL silently ignores.
+	================
+	*/
+	struct GLProgramLayout
+	{
+		// uniforms
+		GLint 	screenSpaceTransform;
+		GLint 	modelView; 			// modelViewMat or u_mv_matrix
+		GLint 	projection; 		// projectionMat or u_p_matrix
+		GLint 	tex;
+		GLint 	color;
+		GLint 	lineWidth;
+		GLint 	feather;
+		GLint 	miterLimit;
+		GLint 	joinMode;
+		GLint 	capMode;
+
+		// attributes
+		GLint 	vertPosition;
+		GLint 	vertNormal;
+		GLint 	vertColor;
+		GLint 	vertLine; 			// AA line width, feather
+		GLint 	uv;
+		GLint 	quadPos;
+		GLint 	quadSize;
+		GLint 	quadRotRads;
+		GLint 	quadTint;
+		GLint 	quadOrigin;
+		GLint 	quadUVOffset;
+		GLint 	quadUVSize;
+		GLint 	pointPrev;
+		GLint 	pointStart;
+		GLint 	pointEnd;
+		GLint 	pointNext;
+	};
+
 	class GLProgram
 	{
 	public:
@@ -47,7 +88,14 @@ namespace GL {
 		GLuint 	GetUniformLocation( const std::string& str ) const;
 		GLuint 	GetAttributeLocation( const std::string& str ) const;
 
+		const GLProgramLayout& GetLayout() const;
+
 		GLuint mProgramId;
+
+	protected:
+		void 	ResolveLayout();
+
+		GLProgramLayout mLayout;
 	};
 
 } /* namespace GL */
@@ -22,35 +22,17 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 
 ===========================================================================
 */
-#ifndef _PROCYON_VASER_H
-#define _PROCYON_VASER_H
-
-#include "ProcyonGL.h"
-
-struct VaseVec2 { double x,y;};
-struct VaseColor { float r,g,b,a;};
-
-inline VaseVec2 GlmToVaseVec2( const glm::vec2& v )
-{
-	VaseVec2 ret;
-	ret.x = (double)v.x;
-	ret.y = (double)v.y;
-	return ret;
-}
-
-inline VaseColor GlmToVaseColor( const glm::vec4& v )
-{
-	VaseColor ret;
-	ret.r = v.r;
-	ret.g = v.g;
-	ret.b = v.b;
-	ret.a = v.a;
-	return ret;
-}
-
-typedef VaseVec2 Vec2;
-typedef VaseColor Color;
-
-#include "vaser.h"
-
-#endif /* _PROCYON_VASER_H */
+#include "GLQuadBuffer.h"
+
+namespace Procyon {
+
+namespace GL {
+
+	void GLQuadBuffer::Upload( const void* data, int bytes )
+	{
+		mBuffer.SetData( bytes, data, GL_STATIC_DRAW );
+	}
+
+} /* namespace GL */
+
+} /* namespace Procyon */
@@ -0,0 +1,58 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _GL_QUAD_BUFFER_H
+#define _GL_QUAD_BUFFER_H
+
+#include "ProcyonGL.h"
+#include "Graphics/QuadBuffer.h"
+#include "GLBuffer.h"
+
+namespace Procyon {
+
+namespace GL {
+
+	/*
+	================
+	GLQuadBuffer
+
+	QuadBuffer stored in a GL_STATIC_DRAW buffer object.
+	================
+	*/
+	class GLQuadBuffer : public QuadBuffer
+	{
+	public:
+		GLuint 			GetId() const { return mBuffer.GetId(); }
+
+	protected:
+		virtual void 	Upload( const void* data, int bytes );
+
+		GLBuffer 		mBuffer;
+	};
+
+} /* namespace GL */
+
+} /* namespace Procyon */
+
+#endif /* _GL_QUAD_BUFFER_H */
@@ -26,7 +26,11 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 #include "GLTexture.h"
 #include "GLProgram.h"
 #include "GLBuffer.h"
+#include "GLQuadBuffer.h"
+#include "GLStreamBuffer.h"
+#include "GLStateCache.h"
 #include "Graphics/Camera.h"
+#include "Graphics/NullRenderCore.h"
 
 using namespace Procyon::GL;
 
@@ -44,32 +48,16 @@ static unsigned short indices[] =
     2, 3, 0
 };
 
-// 30 MB
-#define MAX_VERTEX_ATTRIB_BYTES 1024 * 1024 * 30
 #define BATCH_STRIDE sizeof( BatchedQuad )
 
+// Vertex stream segments, one is consumed per flush. Triple buffered so the
+// CPU rarely waits on a fence.
+#define STREAM_SEGMENT_BYTES 1024 * 1024 * 8
+#define STREAM_SEGMENT_COUNT 3
+
 namespace Procyon {
 namespace GL {
 
-	static unsigned char 	gVertexAttribData[ MAX_VERTEX_ATTRIB_BYTES ];
-	static int				gVertexDataWriteOffset 		= 0;
-
-	bool operator==( const RenderCommand& rc1, const RenderCommand& rc2 )
-	{
-		if ( rc1.op == rc2.op && rc1.flags == rc2.flags)
-		{
-			switch ( rc1.op )
-			{
-			case RENDER_OP_QUAD: return rc1.texture == rc2.texture;
-			case RENDER_OP_PRIMITIVE: return rc1.primmode == rc2.primmode && memcmp( rc1.color, rc2.color, 16 ) == 0;
-			case RENDER_OP_POLYGON:
-			case RENDER_OP_AA_LINE:
-			default: false;
-			}
-		}
-		return false;
-	}
-
 	static GLenum TranslatePrimitiveMode( PrimitiveMode pm )
 	{
 		switch ( pm )
@@ -80,378 +68,395 @@ namespace GL {
 		return GL_INVALID_ENUM;
 	}
 
+	static void EnableAttribute( GLint location, GLint components, GLenum type, GLboolean normalize
+		, GLsizei stride, GLintptr offset, GLuint divisor )
+	{
+		if ( location == -1 )
+			return;
+
+		glVertexAttribPointer( location, components, type, normalize, stride, (const void*)offset );
+		glVertexAttribDivisor( location, divisor );
+		glEnableVertexAttribArray( location );
+	}
+
+	static void EnableAttribute( GLint location, GLint components, GLsizei stride, GLintptr offset, GLuint divisor = 0 )
+	{
+		EnableAttribute( location, components, GL_FLOAT, GL_FALSE, stride, offset, divisor );
+	}
+
+	static std::vector< std::string > CompactQuadDefines( bool textured )
+	{
+		std::vector< std::string > defines;
+		if ( textured )
+		{
+			defines.push_back( "UV0_ENABLED" );
+			defines.push_back( "TEXTURE0_ENABLED" );
+		}
+		defines.push_back( "COMPACT_QUAD" );
+		defines.push_back( "COMPACT_QUAD_POSITION_SCALE " + std::to_string( COMPACT_QUAD_POSITION_SCALE ) );
+		defines.push_back( "COMPACT_QUAD_ORIGIN_SCALE " + std::to_string( COMPACT_QUAD_ORIGIN_SCALE ) );
+		return defines;
+	}
+
+	static void SetTransformUniforms( const GLProgramLayout& layout, const RenderCommand& rc, const Camera2D& camera )
+	{
+		glm::mat3 mv = ( rc.flags & RENDER_SCREEN_SPACE ) ? glm::mat3() : camera.GetView();
+		glm::mat3 p = camera.GetProjection();
+		GLStateCache& cache = GLStateCache::Get();
+		cache.UniformMatrix3( layout.modelView, glm::value_ptr( mv ) );
+		cache.UniformMatrix3( layout.projection, glm::value_ptr( p ) );
+	}
+
 	GLRenderCore::GLRenderCore()
-		: mRenderCommandCount( 0 )
+		: mStreamBase( 0 )
+		, mBaseInstance( GLEW_ARB_base_instance != 0 )
 	{
 		mQuadBuffer 	= new GLBuffer( sizeof( data ), data );
 		mQuadIndices 	= new GLBuffer( sizeof( indices ), indices );
 
-		mBuffer 		= new GLBuffer( sizeof(gVertexAttribData), gVertexAttribData, GL_STREAM_DRAW );
-		mOffBuffer 		= new GLBuffer( sizeof(gVertexAttribData), gVertexAttribData, GL_STREAM_DRAW );
+		mStream 		= new GLStreamBuffer( STREAM_SEGMENT_BYTES, STREAM_SEGMENT_COUNT );
+
+		// A flush never sources more than one segment of lines.
+		const int maxLines = STREAM_SEGMENT_BYTES / ( sizeof( AALineVertex ) * 4 );
+		std::vector< GLuint > lineIndices( maxLines * 6 );
+		for ( int i = 0; i < maxLines; i++ )
+		{
+			const GLuint base = i * 4;
+			GLuint* tri = &lineIndices[ i * 6 ];
+			tri[ 0 ] = base; 		tri[ 1 ] = base + 1; 	tri[ 2 ] = base + 2;
+			tri[ 3 ] = base + 2; 	tri[ 4 ] = base + 1; 	tri[ 5 ] = base + 3;
+		}
+		mLineIndices 	= new GLBuffer( lineIndices.size() * sizeof( GLuint ), lineIndices.data() );
 
    		mDefaultProg    = new GLProgram( "shaders/quadbatch.vert", "shaders/quadbatch.frag", { "UV0_ENABLED", "TEXTURE0_ENABLED" } );
 		mTexturelessProg    = new GLProgram( "shaders/quadbatch.vert", "shaders/quadbatch.frag" );
+		mCompactProg 		= new GLProgram( "shaders/quadbatch.vert", "shaders/quadbatch.frag", CompactQuadDefines( true ) );
+		mCompactTexturelessProg = new GLProgram( "shaders/quadbatch.vert", "shaders/quadbatch.frag", CompactQuadDefines( false ) );
    		mDefaultPrimitiveProg = new GLProgram( "shaders/primitive.vert", "shaders/primitive.frag" );
    		mDefaultPolygonProg = new GLProgram( "shaders/polygon.vert", "shaders/polygon.frag" );
 		mDefaultLineProg = new GLProgram( "shaders/line.vert", "shaders/line.frag" );
+		mPolyLineProg = new GLProgram( "shaders/polyline.vert", "shaders/polyline.frag" );
 
-		ResetStats();
+		CreateVertexFormats();
 	}
 
 	GLRenderCore::~GLRenderCore()
 	{
+		for ( int i = 0; i < FORMAT_COUNT; i++ )
+		{
+			GLStateCache::Get().VertexArrayDeleted( mVaos[ i ] );
+		}
+		glDeleteVertexArrays( FORMAT_COUNT, mVaos );
+
 		delete mDefaultPolygonProg;
 		delete mDefaultLineProg;
+		delete mPolyLineProg;
 		delete mDefaultPrimitiveProg;
 		delete mDefaultProg;
 		delete mTexturelessProg;
-		delete mOffBuffer;
-		delete mBuffer;
+		delete mCompactProg;
+		delete mCompactTexturelessProg;
+		delete mStream;
 		delete mQuadIndices;
+		delete mLineIndices;
 		delete mQuadBuffer;
 	}
 
-	bool GLRenderCore::PushData( const unsigned char* data, int size )
+	void GLRenderCore::CreateVertexFormats()
 	{
-		if ( gVertexDataWriteOffset + size >= MAX_VERTEX_ATTRIB_BYTES )
+		glGenVertexArrays( FORMAT_COUNT, mVaos );
+		for ( int i = 0; i < FORMAT_COUNT; i++ )
 		{
-			PROCYON_WARN( "GLRenderCore", "MAX_VERTEX_ATTRIB_BYTES(%i) overflow, some quads will not be drawn!"
-				, MAX_VERTEX_ATTRIB_BYTES);
-			return false;
+			mVaoBuffer[ i ] = 0;
+			mVaoStreamBase[ i ] = -1;
 		}
+		mVaoBufferDeletions = GLStateCache::Get().GetBufferDeletions();
 
-		memcpy( gVertexAttribData + gVertexDataWriteOffset, data, size );
-		gVertexDataWriteOffset += size;
+		// The immutable quad corners and indices never change, bind them for good.
+		const VertexFormat quadFormats[] = { FORMAT_QUAD, FORMAT_TEXTURED_QUAD, FORMAT_COMPACT_QUAD, FORMAT_TEXTURED_COMPACT_QUAD };
+		for ( VertexFormat format : quadFormats )
+		{
+			const GLProgramLayout& layout = QuadProgram( format )->GetLayout();
 
-		return true;
+			GLStateCache::Get().BindVertexArray( mVaos[ format ] );
+			mQuadIndices->Bind( GL_ELEMENT_ARRAY_BUFFER );
+			mQuadBuffer->Bind( GL_ARRAY_BUFFER );
+			EnableAttribute( layout.vertPosition, 2, sizeof(float) * 4, 0 );
+			EnableAttribute( layout.uv, 2, sizeof(float) * 4, sizeof(float) * 2 );
+		}
+
+		GLStateCache::Get().BindVertexArray( mVaos[ FORMAT_AA_LINE ] );
+		mLineIndices->Bind( GL_ELEMENT_ARRAY_BUFFER );
+
+		GLStateCache::Get().BindVertexArray( 0 );
 	}
 
-	bool GLRenderCore::PushCommandData( const RenderCommand& rc )
+	void GLRenderCore::BindVertexFormat( VertexFormat format, GLintptr streamBase )
 	{
-		switch ( rc.op )
-		{
-			case RENDER_OP_QUAD:
-				return PushData( (const unsigned char*)rc.quaddata, rc.instancecount * sizeof( BatchedQuad ) );
-			case RENDER_OP_PRIMITIVE:
-				return PushData( (const unsigned char*)rc.verts, rc.vertcount * sizeof( PrimitiveVertex ) );
-			case RENDER_OP_POLYGON:
-				return PushData( (const unsigned char*)rc.colorverts, rc.colorvertcount * sizeof( ColorVertex ) );
-			case RENDER_OP_AA_LINE:
-				return PushData( (const unsigned char*)rc.lineverts, rc.linevertcount * sizeof( AALineVertex ) );
-		}
-
-		return false;
+		BindVertexFormat( format, mStream->GetId(), streamBase );
 	}
 
-	void GLRenderCore::AddCommand( const RenderCommand& cmd )
+	void GLRenderCore::BindVertexFormat( VertexFormat format, GLuint buffer, GLintptr streamBase )
 	{
-		if ( mRenderCommandCount >= MAX_RENDER_CMDS - 1 )
+		GLStateCache::Get().BindVertexArray( mVaos[ format ] );
+
+		// A buffer was deleted since the pointers were set, its name may now
+		// belong to a different buffer.
+		const unsigned int deletions = GLStateCache::Get().GetBufferDeletions();
+		if ( mVaoBufferDeletions != deletions )
 		{
-			PROCYON_WARN( "GLRenderCore", "MAX_RENDER_CMDS(%i) overflow, some quads will not be drawn!"
-				, MAX_RENDER_CMDS);
-			return;
+			for ( int i = 0; i < FORMAT_COUNT; i++ )
+			{
+				mVaoBuffer[ i ] = 0;
+			}
+			mVaoBufferDeletions = deletions;
 		}
 
-		RenderCommand& rc = mCmdBuffer[ mRenderCommandCount ];
-		rc = cmd;
-		rc.offset = gVertexDataWriteOffset;
+		if ( mVaoBuffer[ format ] == buffer && mVaoStreamBase[ format ] == streamBase )
+			return;
 
-		if ( PushCommandData( cmd ) )
-		{
-			mRenderCommandCount++;
-		}
-	}
+		mVaoBuffer[ format ] = buffer;
+		mVaoStreamBase[ format ] = streamBase;
+		GLStateCache::Get().BindBuffer( GL_ARRAY_BUFFER, buffer );
 
-	void GLRenderCore::AddOrAppendCommand( const RenderCommand& cmd )
-	{
-		if ( cmd.op == RENDER_OP_QUAD && mRenderCommandCount > 0 )
+		switch ( format )
 		{
-			RenderCommand& prev = mCmdBuffer[ mRenderCommandCount - 1 ];
-			if ( prev == cmd )
+			case FORMAT_QUAD:
+			case FORMAT_TEXTURED_QUAD:
 			{
-				// append
-				if ( PushCommandData( cmd ) )
-				{
-					prev.instancecount += cmd.instancecount;
-				}
-				return;
+				const GLProgramLayout& layout = QuadProgram( format )->GetLayout();
+				EnableAttribute( layout.quadPos, 2, BATCH_STRIDE, streamBase + offsetof( BatchedQuad, position ), 1 );
+				EnableAttribute( layout.quadSize, 2, BATCH_STRIDE, streamBase + offsetof( BatchedQuad, size ), 1 );
+				EnableAttribute( layout.quadRotRads, 1, BATCH_STRIDE, streamBase + offsetof( BatchedQuad, rotation ), 1 );
+				EnableAttribute( layout.quadUVOffset, 2, BATCH_STRIDE, streamBase + offsetof( BatchedQuad, uvoffset ), 1 );
+				EnableAttribute( layout.quadUVSize, 2, BATCH_STRIDE, streamBase + offsetof( BatchedQuad, uvsize ), 1 );
+				EnableAttribute( layout.quadTint, 4, BATCH_STRIDE, streamBase + offsetof( BatchedQuad, color ), 1 );
+				EnableAttribute( layout.quadOrigin, 2, BATCH_STRIDE, streamBase + offsetof( BatchedQuad, origin ), 1 );
+				break;
 			}
-		}
-		else if ( cmd.op == RENDER_OP_PRIMITIVE && mRenderCommandCount > 0 )
-		{
-
-			RenderCommand& prev = mCmdBuffer[ mRenderCommandCount - 1 ];
-			if ( prev == cmd )
+			case FORMAT_COMPACT_QUAD:
+			case FORMAT_TEXTURED_COMPACT_QUAD:
 			{
-				// append
-				if ( PushCommandData( cmd ) )
-				{
-					prev.vertcount += cmd.vertcount;
-				}
-				return;
+				const GLsizei stride = sizeof( CompactQuad );
+				const GLProgramLayout& layout = QuadProgram( format )->GetLayout();
+				EnableAttribute( layout.quadPos, 2, GL_SHORT, GL_FALSE, stride, streamBase + offsetof( CompactQuad, position ), 1 );
+				EnableAttribute( layout.quadSize, 2, GL_HALF_FLOAT, GL_FALSE, stride, streamBase + offsetof( CompactQuad, size ), 1 );
+				EnableAttribute( layout.quadRotRads, 1, GL_SHORT, GL_TRUE, stride, streamBase + offsetof( CompactQuad, rotation ), 1 );
+				EnableAttribute( layout.quadUVOffset, 2, GL_UNSIGNED_SHORT, GL_FALSE, stride, streamBase + offsetof( CompactQuad, uvoffset ), 1 );
+				EnableAttribute( layout.quadUVSize, 2, GL_UNSIGNED_SHORT, GL_FALSE, stride, streamBase + offsetof( CompactQuad, uvsize ), 1 );
+				EnableAttribute( layout.quadTint, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, streamBase + offsetof( CompactQuad, color ), 1 );
+				EnableAttribute( layout.quadOrigin, 2, GL_BYTE, GL_FALSE, stride, streamBase + offsetof( CompactQuad, origin ), 1 );
+				break;
+			}
+			case FORMAT_PRIMITIVE:
+			{
+				const GLProgramLayout& layout = mDefaultPrimitiveProg->GetLayout();
+				EnableAttribute( layout.vertPosition, 2, sizeof( PrimitiveVertex ), streamBase );
+				break;
+			}
+			case FORMAT_POLYGON:
+			{
+				const GLProgramLayout& layout = mDefaultPolygonProg->GetLayout();
+				EnableAttribute( layout.vertPosition, 2, sizeof( ColorVertex ), streamBase + offsetof( ColorVertex, position ) );
+				EnableAttribute( layout.vertColor, 4, sizeof( ColorVertex ), streamBase + offsetof( ColorVertex, color ) );
+				break;
+			}
+			case FORMAT_AA_LINE:
+			{
+				const GLProgramLayout& layout = mDefaultLineProg->GetLayout();
+				EnableAttribute( layout.vertPosition, 2, sizeof( AALineVertex ), streamBase + offsetof( AALineVertex, position ) );
+				EnableAttribute( layout.vertNormal, 2, sizeof( AALineVertex ), streamBase + offsetof( AALineVertex, normal ) );
+				EnableAttribute( layout.vertColor, 4, sizeof( AALineVertex ), streamBase + offsetof( AALineVertex, color ) );
+				EnableAttribute( layout.vertLine, 2, sizeof( AALineVertex ), streamBase + offsetof( AALineVertex, width ) );
+				break;
+			}
+			case FORMAT_POLYLINE:
+			{
+				// Instance i sees points i to i + 3, the segment and either neighbour.
+				const GLsizei stride = sizeof( PolyLinePoint );
+				const GLProgramLayout& layout = mPolyLineProg->GetLayout();
+				EnableAttribute( layout.pointPrev, 2, stride, streamBase, 1 );
+				EnableAttribute( layout.pointStart, 2, stride, streamBase + stride, 1 );
+				EnableAttribute( layout.pointEnd, 2, stride, streamBase + stride * 2, 1 );
+				EnableAttribute( layout.pointNext, 2, stride, streamBase + stride * 3, 1 );
+				break;
 			}
+			default: break;
 		}
-
-		// fallback to just adding
-		AddCommand( cmd );
 	}
 
-	void GLRenderCore::RenderQuadBatch( const RenderCommand& rc, const Camera2D& camera  )
+	const GLProgram* GLRenderCore::QuadProgram( VertexFormat format ) const
 	{
-		const GLProgram* program = ( rc.texture ) ? mDefaultProg : mTexturelessProg;
-		program->Bind();
-
-		GLint sstLoc = program->GetUniformLocation( "screenSpaceTransform" );
-		if ( rc.flags & RENDER_SCREEN_SPACE )
+		switch ( format )
 		{
-			glm::mat3 p = camera.GetProjection();
-			glUniformMatrix3fv( sstLoc, 1, false, glm::value_ptr( p ) );
+			case FORMAT_TEXTURED_QUAD: 			return mDefaultProg;
+			case FORMAT_COMPACT_QUAD: 			return mCompactTexturelessProg;
+			case FORMAT_TEXTURED_COMPACT_QUAD: 	return mCompactProg;
+			default: 							return mTexturelessProg;
 		}
+	}
+
+	void GLRenderCore::RenderQuadBatch( const RenderCommand& rc, const Camera2D& camera  )
+	{
+		// The layout is picked per batch by the producer side, see AddOrAppendQuad().
+		VertexFormat format;
+		if ( rc.flags & RENDER_QUAD_COMPACT )
+			format = ( rc.texture ) ? FORMAT_TEXTURED_COMPACT_QUAD : FORMAT_COMPACT_QUAD;
 		else
-		{
-			glm::mat3 vp = camera.GetViewProjection();
-			glUniformMatrix3fv( sstLoc, 1, false, glm::value_ptr( vp ) );
-		}
+			format = ( rc.texture ) ? FORMAT_TEXTURED_QUAD : FORMAT_QUAD;
+
+		const GLProgram* program = QuadProgram( format );
+		const GLProgramLayout& layout = program->GetLayout();
+		program->Bind();
 
-		// Bind the screen dimensions
-	    GLint dimsLoc = program->GetUniformLocation( "screenDims" );
-		glm::vec2 screenDims = glm::vec2( camera.GetWidth(), camera.GetHeight() );
-		glUniform2f( dimsLoc, screenDims.x, screenDims.y );
+		GLStateCache& cache = GLStateCache::Get();
+		glm::mat3 sst = ( rc.flags & RENDER_SCREEN_SPACE ) ? camera.GetProjection() : camera.GetViewProjection();
+		cache.UniformMatrix3( layout.screenSpaceTransform, glm::value_ptr( sst ) );
 
 		// Bind the texture
 		if ( rc.texture )
 		{
-			GLint texLoc = program->GetUniformLocation( "tex" );
-			glUniform1i( texLoc, 0 );
-			//glActiveTexture( GL_TEXTURE0 );
+			const GLint unit = 0;
+			cache.UniformInts( layout.tex, 1, &unit );
+			cache.ActiveTexture( unit );
 			rc.texture->Bind();
 		}
 
-		// Bind the immuatable quad position data
-		mQuadIndices->Bind( GL_ELEMENT_ARRAY_BUFFER );
-		mQuadBuffer->Bind( GL_ARRAY_BUFFER );
-	    GLint vertPosLoc = program->GetAttributeLocation( "vertPosition" );
-    	glVertexAttribPointer( vertPosLoc, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 4, 0 );
-	    glEnableVertexAttribArray( vertPosLoc );
-
-		if ( rc.texture )
-		{
-			GLint uvLoc = program->GetAttributeLocation( "uv" );
-    		glVertexAttribPointer( uvLoc, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 4, (const void*)(sizeof(float) * 2)  );
-			glEnableVertexAttribArray( uvLoc );
-		}
-
-		mBuffer->Bind( GL_ARRAY_BUFFER );
-
-	    // Bind the quadbatch positions
-	    GLint quadPosLoc = program->GetAttributeLocation( "quadPos" );
-    	glVertexAttribPointer( quadPosLoc, 2, GL_FLOAT, GL_FALSE, BATCH_STRIDE, (const void*)(long)rc.offset );
-    	glVertexAttribDivisor( quadPosLoc, 1 );
-	    glEnableVertexAttribArray( quadPosLoc );
-
-	    // Bind the quadbatch sizes
-	    GLint quadSizeLoc = program->GetAttributeLocation( "quadSize" );
-    	glVertexAttribPointer( quadSizeLoc, 2, GL_FLOAT, GL_FALSE, BATCH_STRIDE, (const void*)(sizeof(float) * 2 + rc.offset) );
-    	glVertexAttribDivisor( quadSizeLoc, 1 );
-	    glEnableVertexAttribArray( quadSizeLoc );
-
-	    // Bind the quadbatch sizes
-	    GLint quadRotLoc = program->GetAttributeLocation( "quadRotRads" );
-    	glVertexAttribPointer( quadRotLoc, 1, GL_FLOAT, GL_FALSE, BATCH_STRIDE, (const void*)(sizeof(float) * 4 + rc.offset) );
-    	glVertexAttribDivisor( quadRotLoc, 1 );
-	    glEnableVertexAttribArray( quadRotLoc );
-
-		GLint quadUVOffsetLoc = program->GetAttributeLocation( "quadUVOffset" );
-		GLint quadUVSizeLoc = program->GetAttributeLocation( "quadUVSize" );
-		if ( rc.texture )
+		if ( rc.flags & RENDER_QUAD_STATIC )
 		{
-			// Bind the quadbatch uv position
-			glVertexAttribPointer( quadUVOffsetLoc, 2, GL_FLOAT, GL_FALSE, BATCH_STRIDE, (const void*)(sizeof(float) * 5 + rc.offset) );
-			glVertexAttribDivisor( quadUVOffsetLoc, 1 );
-			glEnableVertexAttribArray( quadUVOffsetLoc );
-
-			// Bind the quadbatch uv sizes
-			glVertexAttribPointer( quadUVSizeLoc, 2, GL_FLOAT, GL_FALSE, BATCH_STRIDE, (const void*)(sizeof(float) * 7 + rc.offset) );
-			glVertexAttribDivisor( quadUVSizeLoc, 1 );
-			glEnableVertexAttribArray( quadUVSizeLoc );
+			// Instances live in their own buffer, always from its start.
+			BindVertexFormat( format, static_cast< const GLQuadBuffer* >( rc.quadbuffer )->GetId(), 0 );
+			glDrawElementsInstanced( GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0, rc.instancecount );
 		}
-
-	    // Bind the quadbatch tint
-	    GLint quadTintLoc = program->GetAttributeLocation( "quadTint" );
-    	glVertexAttribPointer( quadTintLoc, 4, GL_FLOAT, GL_FALSE, BATCH_STRIDE, (const void*)(sizeof(float) * 9 + rc.offset) );
-    	glVertexAttribDivisor( quadTintLoc, 1 );
-	    glEnableVertexAttribArray( quadTintLoc );
-
-	    // Bind the quadbatch positions
-	    GLint quadOriginLoc = program->GetAttributeLocation( "quadOrigin" );
-    	glVertexAttribPointer( quadOriginLoc, 2, GL_FLOAT, GL_FALSE, BATCH_STRIDE, (const void*)(sizeof(float) * 13 + rc.offset) );
-    	glVertexAttribDivisor( quadOriginLoc, 1 );
-	    glEnableVertexAttribArray( quadOriginLoc );
-
-		glDrawElementsInstanced( GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0, rc.instancecount );
-
-        glVertexAttribDivisor( quadPosLoc, 0 );
-        glVertexAttribDivisor( quadSizeLoc, 0 );
-        glVertexAttribDivisor( quadRotLoc, 0 );
-        glVertexAttribDivisor( quadTintLoc, 0 );
-		glVertexAttribDivisor( quadOriginLoc, 0 );
-        if ( rc.texture )
-        {
-            glVertexAttribDivisor( quadUVOffsetLoc, 0 );
-            glVertexAttribDivisor( quadUVSizeLoc, 0 );
-        }
-
-		mFrameStats.batches++;
-		mFrameStats.totalquads += rc.instancecount;
-		if ( mFrameStats.batchmin != 0 )
+		else if ( mBaseInstance )
 		{
-			mFrameStats.batchmin = glm::min( mFrameStats.batchmin, rc.instancecount );
+			BindVertexFormat( format, mStreamBase );
+			glDrawElementsInstancedBaseInstance( GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0, rc.instancecount
+				, rc.offset / CommandDataStride( rc ) );
 		}
 		else
 		{
-			mFrameStats.batchmin = rc.instancecount;
+			// The instanced pointers have to follow every batch instead.
+			BindVertexFormat( format, mStreamBase + rc.offset );
+			glDrawElementsInstanced( GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0, rc.instancecount );
 		}
-		mFrameStats.batchmax = glm::max( mFrameStats.batchmax, rc.instancecount );
+
+		AddBatchStats( rc );
 	}
 
 	void GLRenderCore::RenderPrimitive( const RenderCommand& rc, const Camera2D& camera  )
 	{
 		const GLProgram* program = mDefaultPrimitiveProg;
+		const GLProgramLayout& layout = program->GetLayout();
 		program->Bind();
 
-		GLint mvMatLoc = program->GetUniformLocation( "modelViewMat" );
-		GLint projLoc = program->GetUniformLocation( "projectionMat" );
-		if ( rc.flags & RENDER_SCREEN_SPACE )
-		{
-			glm::mat3 identity;
-			glUniformMatrix3fv( mvMatLoc, 1, false, glm::value_ptr( identity ) );
-
-			glm::mat3 p = camera.GetProjection();
-			glUniformMatrix3fv( projLoc, 1, false, glm::value_ptr( p ) );
-		}
-		else
-		{
-			glm::mat3 mv = camera.GetView();
-			glUniformMatrix3fv( mvMatLoc, 1, false, glm::value_ptr( mv ) );
-
-			glm::mat3 p = camera.GetProjection();
-			glUniformMatrix3fv( projLoc, 1, false, glm::value_ptr( p ) );
-		}
-
-		GLint colorLoc = program->GetUniformLocation( "color" );
-		glUniform4fv( colorLoc, 1, rc.color );
+		SetTransformUniforms( layout, rc, camera );
+		GLStateCache::Get().UniformFloats( layout.color, 4, rc.color );
 
-		mBuffer->Bind( GL_ARRAY_BUFFER );
-	    GLint vertPosLoc = program->GetAttributeLocation( "vertPosition" );
-    	glVertexAttribPointer( vertPosLoc, 2, GL_FLOAT, GL_FALSE, 0, (const void*)(long)rc.offset );
-	    glEnableVertexAttribArray( vertPosLoc );
-    	glDrawArrays( TranslatePrimitiveMode( rc.primmode ), 0, rc.vertcount );
+		BindVertexFormat( FORMAT_PRIMITIVE, mStreamBase );
+		glDrawArrays( TranslatePrimitiveMode( rc.primmode ), rc.offset / sizeof( PrimitiveVertex ), rc.vertcount );
 
-    	mFrameStats.batches++;
-		mFrameStats.totalprimitives++;
+		AddBatchStats( rc );
 	}
 
 	void GLRenderCore::RenderPolygon( const RenderCommand& rc, const Camera2D& camera  )
 	{
 		const GLProgram* program = mDefaultPolygonProg;
+		const GLProgramLayout& layout = program->GetLayout();
 		program->Bind();
 
-		GLint mvMatLoc = program->GetUniformLocation( "u_mv_matrix" );
-		GLint projLoc = program->GetUniformLocation( "u_p_matrix" );
-		if ( rc.flags & RENDER_SCREEN_SPACE )
-		{
-			glm::mat3 identity;
-			glUniformMatrix3fv( mvMatLoc, 1, false, glm::value_ptr( identity ) );
-
-			glm::mat3 p = camera.GetProjection();
-			glUniformMatrix3fv( projLoc, 1, false, glm::value_ptr( p ) );
-		}
-		else
-		{
-			glm::mat3 mv = camera.GetView();
-			glUniformMatrix3fv( mvMatLoc, 1, false, glm::value_ptr( mv ) );
-
-			glm::mat3 p = camera.GetProjection();
-			glUniformMatrix3fv( projLoc, 1, false, glm::value_ptr( p ) );
-		}
-
-		mBuffer->Bind( GL_ARRAY_BUFFER );
-	    GLint vertPosLoc = program->GetAttributeLocation( "vertPosition" );
-    	glVertexAttribPointer( vertPosLoc, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 6, (const void*)(long)rc.offset );
-	    glEnableVertexAttribArray( vertPosLoc );
-	    GLint colorLoc = program->GetAttributeLocation( "vertColor" );
-    	glVertexAttribPointer( colorLoc, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 6, (const void*)(sizeof(float) * 2 + rc.offset) );
-	    glEnableVertexAttribArray( colorLoc );
+		SetTransformUniforms( layout, rc, camera );
 
-    	glDrawArrays( GL_TRIANGLES, 0, rc.colorvertcount );
+		BindVertexFormat( FORMAT_POLYGON, mStreamBase );
+		glDrawArrays( GL_TRIANGLES, rc.offset / sizeof( ColorVertex ), rc.colorvertcount );
 
-		mFrameStats.batches++;
+		AddBatchStats( rc );
 	}
 
 	void GLRenderCore::RenderAntiAliasedLine( const RenderCommand& rc, const Camera2D& camera  )
 	{
 		const GLProgram* program = mDefaultLineProg;
+		const GLProgramLayout& layout = program->GetLayout();
 		program->Bind();
 
-		GLint widthLoc = program->GetUniformLocation( "u_linewidth" );
-		GLint mvLoc = program->GetUniformLocation( "u_mv_matrix" );
-		GLint projLoc = program->GetUniformLocation( "u_p_matrix" );
-		GLint colorLoc = program->GetUniformLocation( "color" );
-		GLint featherLoc = program->GetUniformLocation( "feather" );
+		SetTransformUniforms( layout, rc, camera );
 
-		if ( rc.flags & RENDER_SCREEN_SPACE )
-		{
-			glm::mat3 identity;
-			glUniformMatrix3fv( mvLoc, 1, false, glm::value_ptr( identity ) );
+		// The shared indices always start at vertex 0, so point the
+		// attributes at this batch.
+		BindVertexFormat( FORMAT_AA_LINE, mStreamBase + rc.offset );
+		glDrawElements( GL_TRIANGLES, ( rc.linevertcount / 4 ) * 6, GL_UNSIGNED_INT, 0 );
+
+		AddBatchStats( rc );
+	}
 
-			glm::mat3 p = camera.GetProjection();
-			glUniformMatrix3fv( projLoc, 1, false, glm::value_ptr( p ) );
+	void GLRenderCore::RenderPolyLine( const RenderCommand& rc, const Camera2D& camera )
+	{
+		const GLProgram* program = mPolyLineProg;
+		const GLProgramLayout& layout = program->GetLayout();
+		program->Bind();
+
+		SetTransformUniforms( layout, rc, camera );
+		GLStateCache& cache = GLStateCache::Get();
+		const GLint join = (GLint)rc.polyjoin;
+		const GLint cap = (GLint)rc.polycap;
+		cache.UniformFloats( layout.lineWidth, 1, &rc.polywidth );
+		cache.UniformFloats( layout.feather, 1, &rc.polyfeather );
+		cache.UniformFloats( layout.miterLimit, 1, &rc.polymiterlimit );
+		cache.UniformInts( layout.joinMode, 1, &join );
+		cache.UniformInts( layout.capMode, 1, &cap );
+		cache.UniformFloats( layout.color, 4, rc.polycolor );
+
+		// One instanced quad per window of four points, windows touching a
+		// break collapse in the shader.
+		const GLsizei segments = rc.polypointcount - 3;
+		if ( mBaseInstance )
+		{
+			BindVertexFormat( FORMAT_POLYLINE, mStreamBase );
+			glDrawArraysInstancedBaseInstance( GL_TRIANGLE_STRIP, 0, 4, segments, rc.offset / sizeof( PolyLinePoint ) );
 		}
 		else
 		{
-			glm::mat3 mv = camera.GetView();
-			glUniformMatrix3fv( mvLoc, 1, false, glm::value_ptr( mv ) );
-
-			glm::mat3 p = camera.GetProjection();
-			glUniformMatrix3fv( projLoc, 1, false, glm::value_ptr( p ) );
+			BindVertexFormat( FORMAT_POLYLINE, mStreamBase + rc.offset );
+			glDrawArraysInstanced( GL_TRIANGLE_STRIP, 0, 4, segments );
 		}
-		glUniform1fv( widthLoc, 1, &rc.linewidth );
-		glUniform1fv( featherLoc, 1, &rc.feather );
-		glUniform4fv( colorLoc, 1, rc.linecolor );
-
-		mBuffer->Bind( GL_ARRAY_BUFFER );
-	    GLint vertPosLoc = program->GetAttributeLocation( "vertPosition" );
-    	glVertexAttribPointer( vertPosLoc, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 4, (const void*)(long)rc.offset );
-	    glEnableVertexAttribArray( vertPosLoc );
-	    GLint normloc = program->GetAttributeLocation( "vertNormal" );
-    	glVertexAttribPointer( normloc, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 4, (const void*)(sizeof(float) * 2 + rc.offset) );
-	    glEnableVertexAttribArray( normloc );
 
-    	glDrawArrays( GL_TRIANGLE_STRIP, 0, rc.vertcount );
+		AddBatchStats( rc );
+	}
 
-		mFrameStats.batches++;
+	QuadBuffer* GLRenderCore::AllocateQuadBuffer()
+	{
+		return new GLQuadBuffer();
 	}
 
-	bool GLRenderCore::RenderCommandsPending() const
+	unsigned char* GLRenderCore::BeginVertexStream( int* capacity )
 	{
-		return mRenderCommandCount != 0;
+		*capacity = (int)mStream->GetSegmentSize();
+		return mStream->BeginSegment();
 	}
 
-	void GLRenderCore::Flush( const Camera2D& camera )
+	void GLRenderCore::EndVertexStream()
 	{
-		// early out if nothng is queued.
-		if ( !RenderCommandsPending() )
-			return;
+		mStream->FenceSegment();
+	}
 
+	void GLRenderCore::FlushCommands( const Camera2D& camera, const RenderCommand* cmds, int count
+		, const unsigned char* vertexData, int vertexBytes )
+	{
 		//glEnable(GL_DEPTH_TEST);
 		//glDepthFunc(GL_LESS);
 
-		// Upload the data
-		mBuffer->SetData( gVertexDataWriteOffset, gVertexAttribData, GL_STREAM_DRAW );
+		GLStateCache& cache = GLStateCache::Get();
+		const unsigned int issued = cache.GetIssuedCalls();
+		const unsigned int skipped = cache.GetSkippedCalls();
+
+		// The vertex data was written in place, publish it.
+		mStream->EndSegment();
+		mStreamBase = mStream->GetSegmentOffset();
 
-		for ( int i = 0; i < mRenderCommandCount; i++ )
+		// vertexData already lives in the current stream segment.
+		for ( int i = 0; i < count; i++ )
 		{
-			RenderCommand& rc = mCmdBuffer[ i ];
+			const RenderCommand& rc = cmds[ i ];
 
 			switch( rc.op )
 			{
@@ -475,35 +480,29 @@ namespace GL {
 					RenderAntiAliasedLine( rc, camera );
 					break;
 				}
+				case RENDER_OP_POLYLINE:
+				{
+					RenderPolyLine( rc, camera );
+					break;
+				}
 			}
 		}
 
-		mRenderCommandCount = 0;
-		gVertexDataWriteOffset = 0;
-
-		std::swap( mBuffer, mOffBuffer );
-
+		cache.BindVertexArray( 0 );
 		glDisable(GL_DEPTH_TEST);
-	}
-
-	void GLRenderCore::ResetStats()
-	{
-		mFrameStats.batches 		= 0;
-		mFrameStats.batchmax 		= 0;
-		mFrameStats.batchmin 		= 0;
-		mFrameStats.totalquads 		= 0;
-		mFrameStats.totalprimitives = 0;
-	}
 
-	const RenderFrameStats& GLRenderCore::GetFrameStats() const
-	{
-		return mFrameStats;
+		mFrameStats.statecallsissued += (int)( cache.GetIssuedCalls() - issued );
+		mFrameStats.statecallsskipped += (int)( cache.GetSkippedCalls() - skipped );
 	}
 
 } /* namespace GL
 
-	/*static*/ RenderCore* RenderCore::Allocate()
+	/*static*/ RenderCore* RenderCore::Allocate( RenderCoreType type /*= RENDER_CORE_DEFAULT*/ )
 	{
+		if ( type == RENDER_CORE_NULL )
+		{
+			return new NullRenderCore();
+		}
 		return new GL::GLRenderCore();
 	}
 
@@ -26,62 +26,89 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 #define _GL_RENDER_CORE_H
 
 #include "ProcyonGL.h"
-#include "Graphics/RenderCore.h"
-
-#define MAX_RENDER_CMDS 10002
+#include "Graphics/RenderCoreBase.h"
 
 namespace Procyon {
 
 namespace GL {
 
 	class GLBuffer;
+	class GLStreamBuffer;
 	class GLProgram;
 
-	class GLRenderCore : public RenderCore
+	class GLRenderCore : public RenderCoreBase
 	{
+		// One VAO per program/vertex format.
+		enum VertexFormat
+		{
+			FORMAT_QUAD,
+			FORMAT_TEXTURED_QUAD,
+			FORMAT_COMPACT_QUAD,
+			FORMAT_TEXTURED_COMPACT_QUAD,
+			FORMAT_PRIMITIVE,
+			FORMAT_POLYGON,
+			FORMAT_AA_LINE,
+			FORMAT_POLYLINE,
+			FORMAT_COUNT
+		};
+
 	public:
 										GLRenderCore();
 		virtual  						~GLRenderCore();
 
-		virtual void 					AddCommand( const RenderCommand& cmd );
-		virtual void 					AddOrAppendCommand( const RenderCommand& cmd );
-
-		virtual bool 					RenderCommandsPending() const;
-
-		virtual void 					Flush( const Camera2D& camera );
-
-		virtual void 					ResetStats();
-		virtual const RenderFrameStats& GetFrameStats() const;
+		virtual QuadBuffer* 			AllocateQuadBuffer();
 
 	protected:
-		bool 				PushData( const unsigned char* data, int size );
-		bool 				PushCommandData( const RenderCommand& cmd );
+		virtual void 		FlushCommands( const Camera2D& camera, const RenderCommand* cmds, int count
+								, const unsigned char* vertexData, int vertexBytes );
+
+		virtual unsigned char* 	BeginVertexStream( int* capacity );
+		virtual void 			EndVertexStream();
 
 		void 				RenderQuadBatch( const RenderCommand& rc, const Camera2D& camera );
 		void 				RenderPrimitive( const RenderCommand& rc, const Camera2D& camera );
 		void 				RenderPolygon( const RenderCommand& rc, const Camera2D& camera );
 		void 				RenderAntiAliasedLine( const RenderCommand& rc, const Camera2D& camera  );
+		void 				RenderPolyLine( const RenderCommand& rc, const Camera2D& camera );
+
+		void 				CreateVertexFormats();
+		const GLProgram* 	QuadProgram( VertexFormat format ) const;
+
+		// Bind the VAO for format, re-pointing its per vertex (or instance)
+		// attributes at base in buffer if they were set up for another source.
+		void 				BindVertexFormat( VertexFormat format, GLuint buffer, GLintptr base );
+		void 				BindVertexFormat( VertexFormat format, GLintptr streamBase );
 
+		// Producers write vertex data straight into this.
+		GLStreamBuffer* 	mStream;
 
-		// The buffer of render commands- cleared each frame.
-		RenderCommand 		mCmdBuffer[ MAX_RENDER_CMDS ];
+		// Buffer offset of the segment being flushed.
+		GLintptr 			mStreamBase;
 
-		// Current size of mCmdBuffer.
-		int 				mRenderCommandCount;
+		GLuint 				mVaos[ FORMAT_COUNT ];
+		GLuint 				mVaoBuffer[ FORMAT_COUNT ];
+		GLintptr 			mVaoStreamBase[ FORMAT_COUNT ];
 
-		RenderFrameStats	mFrameStats;
+		// GLStateCache::GetBufferDeletions() when mVaoBuffer was last trusted,
+		// e.g. a deleted chunk QuadBuffer's name can come back for a new one.
+		unsigned int 		mVaoBufferDeletions;
 
-		GLBuffer* 			mBuffer;
-		GLBuffer* 			mOffBuffer;
+		// ARB_base_instance lets quad batches share one set of instanced
+		// attribute pointers per stream segment.
+		bool 				mBaseInstance;
 
 		GLBuffer* 			mQuadBuffer;
 		GLBuffer* 			mQuadIndices;
+		GLBuffer* 			mLineIndices; 	// two triangles per AA line, enough for a stream segment
 
 		GLProgram* 			mDefaultProg;
 		GLProgram* 			mTexturelessProg;
+		GLProgram* 			mCompactProg;
+		GLProgram* 			mCompactTexturelessProg;
 		GLProgram* 			mDefaultPrimitiveProg;
 		GLProgram* 			mDefaultPolygonProg;
 		GLProgram* 			mDefaultLineProg;
+		GLProgram* 			mPolyLineProg;
 	};
 
 } // namespace GL
@@ -0,0 +1,327 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "GLStateCache.h"
+
+namespace Procyon {
+
+namespace GL {
+
+	/*static*/ GLStateCache& GLStateCache::Get()
+	{
+		// Every context is driven from the render thread.
+		static GLStateCache sCache;
+		return sCache;
+	}
+
+	GLStateCache::GLStateCache()
+		: mProgramUniforms( NULL )
+		, mIssued( 0 )
+		, mSkipped( 0 )
+		, mBufferDeletions( 0 )
+	{
+		Invalidate();
+	}
+
+	void GLStateCache::Invalidate()
+	{
+		mProgram 			= GL_STATE_UNKNOWN;
+		mArrayBuffer 		= GL_STATE_UNKNOWN;
+		mElementArrayBuffer = GL_STATE_UNKNOWN;
+		mVertexArray 		= GL_STATE_UNKNOWN;
+		mActiveUnit 		= GL_STATE_UNKNOWN;
+		mBlendEnabled 		= GL_STATE_UNKNOWN;
+		mBlendSrc 			= GL_STATE_UNKNOWN;
+		mBlendDst 			= GL_STATE_UNKNOWN;
+		for ( int i = 0; i < GL_STATE_TEXTURE_UNITS; i++ )
+		{
+			mTextures[ i ] = GL_STATE_UNKNOWN;
+		}
+		mProgramUniforms = NULL;
+	}
+
+	bool GLStateCache::Changed( GLuint& cached, GLuint value )
+	{
+		if ( cached == value )
+		{
+			mSkipped++;
+			return false;
+		}
+
+		cached = value;
+		mIssued++;
+		return true;
+	}
+
+	void GLStateCache::UseProgram( GLuint program )
+	{
+		if ( Changed( mProgram, program ) )
+		{
+			glUseProgram( program );
+			mProgramUniforms = &mUniforms[ program ];
+		}
+	}
+
+	GLuint* GLStateCache::BufferSlot( GLenum target )
+	{
+		switch ( target )
+		{
+			case GL_ARRAY_BUFFER: 			return &mArrayBuffer;
+			case GL_ELEMENT_ARRAY_BUFFER: 	return &mElementArrayBuffer;
+			default: 						return NULL;
+		}
+	}
+
+	void GLStateCache::BindBuffer( GLenum target, GLuint buffer )
+	{
+		GLuint* slot = BufferSlot( target );
+		if ( !slot )
+		{
+			mIssued++;
+			glBindBuffer( target, buffer );
+		}
+		else if ( Changed( *slot, buffer ) )
+		{
+			glBindBuffer( target, buffer );
+		}
+	}
+
+	void GLStateCache::BindVertexArray( GLuint vao )
+	{
+		if ( Changed( mVertexArray, vao ) )
+		{
+			glBindVertexArray( vao );
+
+			// The element array binding came along with the VAO.
+			mElementArrayBuffer = GL_STATE_UNKNOWN;
+		}
+	}
+
+	void GLStateCache::ActiveTexture( GLuint unit )
+	{
+		if ( Changed( mActiveUnit, unit ) )
+		{
+			glActiveTexture( GL_TEXTURE0 + unit );
+		}
+	}
+
+	void GLStateCache::BindTexture( GLenum target, GLuint texture )
+	{
+		if ( target != GL_TEXTURE_2D || mActiveUnit >= GL_STATE_TEXTURE_UNITS )
+		{
+			mIssued++;
+			glBindTexture( target, texture );
+		}
+		else if ( Changed( mTextures[ mActiveUnit ], texture ) )
+		{
+			glBindTexture( target, texture );
+		}
+	}
+
+	void GLStateCache::SetBlend( bool enabled, GLenum src /*= GL_SRC_ALPHA*/, GLenum dst /*= GL_ONE_MINUS_SRC_ALPHA*/ )
+	{
+		if ( Changed( mBlendEnabled, enabled ? 1 : 0 ) )
+		{
+			if ( enabled )
+				glEnable( GL_BLEND );
+			else
+				glDisable( GL_BLEND );
+		}
+
+		if ( !enabled )
+			return;
+
+		if ( mBlendSrc != src || mBlendDst != dst )
+		{
+			mBlendSrc = src;
+			mBlendDst = dst;
+			mIssued++;
+			glBlendFunc( src, dst );
+		}
+		else
+		{
+			mSkipped++;
+		}
+	}
+
+	bool GLStateCache::UniformChanged( GLint location, const void* value, int size )
+	{
+		if ( location < 0 )
+		{
+			// GL ignores -1 anyway.
+			mSkipped++;
+			return false;
+		}
+
+		if ( !mProgramUniforms || location >= GL_STATE_MAX_UNIFORM_LOCATION )
+		{
+			mIssued++;
+			return true;
+		}
+
+		UniformSlots& slots = *mProgramUniforms;
+		if ( (size_t)location >= slots.size() )
+		{
+			UniformSlot unknown;
+			unknown.size = 0;
+			slots.resize( location + 1, unknown );
+		}
+
+		UniformSlot& slot = slots[ location ];
+		if ( slot.size == size && memcmp( slot.data, value, size ) == 0 )
+		{
+			mSkipped++;
+			return false;
+		}
+
+		slot.size = (unsigned char)size;
+		memcpy( slot.data, value, size );
+		mIssued++;
+		return true;
+	}
+
+	void GLStateCache::UniformFloats( GLint location, int components, const GLfloat* value )
+	{
+		if ( !UniformChanged( location, value, components * sizeof( GLfloat ) ) )
+			return;
+
+		switch ( components )
+		{
+			case 1: glUniform1fv( location, 1, value ); break;
+			case 2: glUniform2fv( location, 1, value ); break;
+			case 3: glUniform3fv( location, 1, value ); break;
+			case 4: glUniform4fv( location, 1, value ); break;
+		}
+	}
+
+	void GLStateCache::UniformInts( GLint location, int components, const GLint* value )
+	{
+		if ( !UniformChanged( location, value, components * sizeof( GLint ) ) )
+			return;
+
+		switch ( components )
+		{
+			case 1: glUniform1iv( location, 1, value ); break;
+			case 2: glUniform2iv( location, 1, value ); break;
+			case 3: glUniform3iv( location, 1, value ); break;
+			case 4: glUniform4iv( location, 1, value ); break;
+		}
+	}
+
+	void GLStateCache::UniformUInts( GLint location, int components, const GLuint* value )
+	{
+		if ( !UniformChanged( location, value, components * sizeof( GLuint ) ) )
+			return;
+
+		switch ( components )
+		{
+			case 1: glUniform1uiv( location, 1, value ); break;
+			case 2: glUniform2uiv( location, 1, value ); break;
+			case 3: glUniform3uiv( location, 1, value ); break;
+			case 4: glUniform4uiv( location, 1, value ); break;
+		}
+	}
+
+	void GLStateCache::UniformMatrix3( GLint location, const GLfloat* value )
+	{
+		if ( UniformChanged( location, value, 9 * sizeof( GLfloat ) ) )
+		{
+			glUniformMatrix3fv( location, 1, false, value );
+		}
+	}
+
+	void GLStateCache::UniformMatrix4( GLint location, const GLfloat* value )
+	{
+		if ( UniformChanged( location, value, 16 * sizeof( GLfloat ) ) )
+		{
+			glUniformMatrix4fv( location, 1, false, value );
+		}
+	}
+
+	void GLStateCache::ProgramLinked( GLuint program )
+	{
+		// Linking resets every uniform to its default.
+		auto search = mUniforms.find( program );
+		if ( search != mUniforms.end() )
+		{
+			search->second.clear();
+		}
+	}
+
+	void GLStateCache::ProgramDeleted( GLuint program )
+	{
+		if ( mProgram == program )
+		{
+			mProgram = GL_STATE_UNKNOWN;
+			mProgramUniforms = NULL;
+		}
+		mUniforms.erase( program );
+	}
+
+	void GLStateCache::BufferDeleted( GLuint buffer )
+	{
+		// Deleting a bound buffer reverts the binding to 0.
+		if ( mArrayBuffer == buffer )
+			mArrayBuffer = 0;
+		if ( mElementArrayBuffer == buffer )
+			mElementArrayBuffer = 0;
+		mBufferDeletions++;
+	}
+
+	void GLStateCache::VertexArrayDeleted( GLuint vao )
+	{
+		if ( mVertexArray == vao )
+		{
+			mVertexArray = 0;
+			mElementArrayBuffer = GL_STATE_UNKNOWN;
+		}
+	}
+
+	void GLStateCache::TextureDeleted( GLuint texture )
+	{
+		for ( int i = 0; i < GL_STATE_TEXTURE_UNITS; i++ )
+		{
+			if ( mTextures[ i ] == texture )
+				mTextures[ i ] = 0;
+		}
+	}
+
+	unsigned int GLStateCache::GetIssuedCalls() const
+	{
+		return mIssued;
+	}
+
+	unsigned int GLStateCache::GetSkippedCalls() const
+	{
+		return mSkipped;
+	}
+
+	unsigned int GLStateCache::GetBufferDeletions() const
+	{
+		return mBufferDeletions;
+	}
+
+} /* namespace GL */
+
+} /* namespace Procyon */
@@ -0,0 +1,123 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _GL_STATE_CACHE_H
+#define _GL_STATE_CACHE_H
+
+#include "ProcyonGL.h"
+
+#define GL_STATE_UNKNOWN 				0xFFFFFFFF
+#define GL_STATE_TEXTURE_UNITS 			16
+#define GL_STATE_MAX_UNIFORM_LOCATION 	256
+
+namespace Procyon {
+
+namespace GL {
+
+	/*
+	================
+	GLStateCache
+
+	Shadows the GL state every GL:: class touches and drops calls that would
+	not change it. Anything bound or set behind its back must be followed by
+	Invalidate(). GL objects must be reported before deletion so a recycled
+	name is never mistaken for the bound one.
+	================
+	*/
+	class GLStateCache
+	{
+	public:
+		static GLStateCache& Get();
+
+				GLStateCache();
+
+		// Forget all tracked bindings, e.g. after foreign GL code ran on the
+		// context. Uniform values live in the programs and are kept.
+		void 	Invalidate();
+
+		void 	UseProgram( GLuint program );
+		void 	BindBuffer( GLenum target, GLuint buffer );
+		void 	BindVertexArray( GLuint vao );
+		void 	ActiveTexture( GLuint unit ); // index, not GL_TEXTURE0 + unit
+		void 	BindTexture( GLenum target, GLuint texture );
+		void 	SetBlend( bool enabled, GLenum src = GL_SRC_ALPHA, GLenum dst = GL_ONE_MINUS_SRC_ALPHA );
+
+		// Apply to the current program.
+		void 	UniformFloats( GLint location, int components, const GLfloat* value );
+		void 	UniformInts( GLint location, int components, const GLint* value );
+		void 	UniformUInts( GLint location, int components, const GLuint* value );
+		void 	UniformMatrix3( GLint location, const GLfloat* value );
+		void 	UniformMatrix4( GLint location, const GLfloat* value );
+
+		void 	ProgramLinked( GLuint program );
+		void 	ProgramDeleted( GLuint program );
+		void 	BufferDeleted( GLuint buffer );
+		void 	VertexArrayDeleted( GLuint vao );
+		void 	TextureDeleted( GLuint texture );
+
+		// Running totals, callers diff them around the work they measure.
+		unsigned int GetIssuedCalls() const;
+		unsigned int GetSkippedCalls() const;
+
+		// Bumped by BufferDeleted(), anything caching buffer names outside the
+		// cache drops them when it changes since the name may be recycled.
+		unsigned int GetBufferDeletions() const;
+
+	protected:
+		struct UniformSlot
+		{
+			unsigned char 	size; // 0 when unknown
+			unsigned char 	data[ 64 ];
+		};
+		typedef std::vector< UniformSlot > UniformSlots;
+
+		// True if the call must be issued, also does the bookkeeping.
+		bool 	Changed( GLuint& cached, GLuint value );
+		bool 	UniformChanged( GLint location, const void* value, int size );
+
+		GLuint* BufferSlot( GLenum target );
+
+		GLuint 	mProgram;
+		GLuint 	mArrayBuffer;
+		GLuint 	mElementArrayBuffer; // part of the bound VAO
+		GLuint 	mVertexArray;
+		GLuint 	mActiveUnit;
+		GLuint 	mTextures[ GL_STATE_TEXTURE_UNITS ]; // GL_TEXTURE_2D only
+		GLuint 	mBlendEnabled;
+		GLuint 	mBlendSrc;
+		GLuint 	mBlendDst;
+
+		std::unordered_map< GLuint, UniformSlots > 	mUniforms;
+		UniformSlots* 								mProgramUniforms;
+
+		unsigned int 	mIssued;
+		unsigned int 	mSkipped;
+		unsigned int 	mBufferDeletions;
+	};
+
+} /* namespace GL */
+
+} /* namespace Procyon */
+
+#endif /* _GL_STATE_CACHE_H */
@@ -0,0 +1,164 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "GLStreamBuffer.h"
+#include "GLStateCache.h"
+
+// Nanoseconds per glClientWaitSync call before logging a stall.
+#define STREAM_FENCE_TIMEOUT 1000000
+
+namespace Procyon {
+
+namespace GL {
+
+	GLStreamBuffer::GLStreamBuffer( GLsizeiptr segmentSize, int segmentCount )
+		: mSegmentSize( segmentSize )
+		, mSegmentCount( segmentCount )
+		, mSegment( 0 )
+		, mPersistentMap( NULL )
+		, mMapped( NULL )
+	{
+		glGenBuffers( 1, &mBufferId );
+		GLStateCache::Get().BindBuffer( GL_ARRAY_BUFFER, mBufferId );
+
+		if ( GLEW_ARB_buffer_storage )
+		{
+			const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			const GLsizeiptr size = mSegmentSize * mSegmentCount;
+
+			glBufferStorage( GL_ARRAY_BUFFER, size, NULL, flags );
+			mPersistentMap = (unsigned char*)glMapBufferRange( GL_ARRAY_BUFFER, 0, size, flags );
+			if ( !mPersistentMap )
+			{
+				PROCYON_WARN( "GL", "Persistent stream mapping failed, falling back to orphaning." );
+				GLStateCache::Get().BufferDeleted( mBufferId );
+				glDeleteBuffers( 1, &mBufferId );
+				glGenBuffers( 1, &mBufferId );
+				GLStateCache::Get().BindBuffer( GL_ARRAY_BUFFER, mBufferId );
+			}
+		}
+
+		if ( !mPersistentMap )
+		{
+			// Orphaning never shares storage with an in-flight draw, so a
+			// single segment is enough.
+			mSegmentCount = 1;
+			glBufferData( GL_ARRAY_BUFFER, mSegmentSize, NULL, GL_STREAM_DRAW );
+		}
+
+		mFences.resize( mSegmentCount, 0 );
+	}
+
+	GLStreamBuffer::~GLStreamBuffer()
+	{
+		for ( GLsync fence : mFences )
+		{
+			if ( fence )
+			{
+				glDeleteSync( fence );
+			}
+		}
+
+		if ( mPersistentMap || mMapped )
+		{
+			GLStateCache::Get().BindBuffer( GL_ARRAY_BUFFER, mBufferId );
+			glUnmapBuffer( GL_ARRAY_BUFFER );
+		}
+
+		GLStateCache::Get().BufferDeleted( mBufferId );
+		glDeleteBuffers( 1, &mBufferId );
+	}
+
+	unsigned char* GLStreamBuffer::BeginSegment()
+	{
+		if ( mPersistentMap )
+		{
+			GLsync& fence = mFences[ mSegment ];
+			if ( fence )
+			{
+				GLenum result = glClientWaitSync( fence, GL_SYNC_FLUSH_COMMANDS_BIT, STREAM_FENCE_TIMEOUT );
+				while ( result == GL_TIMEOUT_EXPIRED )
+				{
+					PROCYON_DEBUG( "GL", "Stream segment %i still in use by the GPU, waiting.", mSegment );
+					result = glClientWaitSync( fence, 0, STREAM_FENCE_TIMEOUT );
+				}
+				glDeleteSync( fence );
+				fence = 0;
+			}
+			return mPersistentMap + GetSegmentOffset();
+		}
+
+		if ( !mMapped )
+		{
+			GLStateCache::Get().BindBuffer( GL_ARRAY_BUFFER, mBufferId );
+			glBufferData( GL_ARRAY_BUFFER, mSegmentSize, NULL, GL_STREAM_DRAW );
+			mMapped = (unsigned char*)glMapBufferRange( GL_ARRAY_BUFFER, 0, mSegmentSize
+				, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT );
+		}
+		return mMapped;
+	}
+
+	void GLStreamBuffer::EndSegment()
+	{
+		// Coherent persistent writes need no explicit flush.
+		if ( mMapped )
+		{
+			GLStateCache::Get().BindBuffer( GL_ARRAY_BUFFER, mBufferId );
+			glUnmapBuffer( GL_ARRAY_BUFFER );
+			mMapped = NULL;
+		}
+	}
+
+	void GLStreamBuffer::FenceSegment()
+	{
+		if ( mPersistentMap )
+		{
+			mFences[ mSegment ] = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+		}
+		mSegment = ( mSegment + 1 ) % mSegmentCount;
+	}
+
+	GLintptr GLStreamBuffer::GetSegmentOffset() const
+	{
+		return mSegment * mSegmentSize;
+	}
+
+	GLsizeiptr GLStreamBuffer::GetSegmentSize() const
+	{
+		return mSegmentSize;
+	}
+
+	bool GLStreamBuffer::IsPersistent() const
+	{
+		return mPersistentMap != NULL;
+	}
+
+	void GLStreamBuffer::Bind( GLenum target )
+	{
+		GLStateCache::Get().BindBuffer( target, mBufferId );
+	}
+
+} /* namespace GL */
+
+} /* namespace Procyon */
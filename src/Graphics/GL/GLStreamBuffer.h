@@ -0,0 +1,88 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _GL_STREAM_BUFFER_H
+#define _GL_STREAM_BUFFER_H
+
+#include "ProcyonGL.h"
+
+namespace Procyon {
+
+namespace GL {
+
+	/*
+	================
+	GLStreamBuffer
+
+	Write-only vertex ring split into equally sized segments, one per flush.
+	With ARB_buffer_storage the whole ring is mapped once, persistent and
+	coherent, and a fence per segment keeps the CPU from overwriting data
+	the GPU has yet to consume. Without it a single segment is orphaned and
+	mapped for every flush instead.
+	================
+	*/
+	class GLStreamBuffer
+	{
+	public:
+							GLStreamBuffer( GLsizeiptr segmentSize, int segmentCount );
+							~GLStreamBuffer();
+
+		// Writable storage for the current segment, waiting on its fence if
+		// the GPU may still be reading it.
+		unsigned char* 		BeginSegment();
+
+		// Make the segment written since BeginSegment() visible to draws.
+		void 				EndSegment();
+
+		// Call after every draw sourcing the segment, moves to the next one.
+		void 				FenceSegment();
+
+		// Buffer offset of the current segment's first byte.
+		GLintptr 			GetSegmentOffset() const;
+		GLsizeiptr 			GetSegmentSize() const;
+		bool 				IsPersistent() const;
+
+		void 				Bind( GLenum target );
+		GLuint 				GetId() const { return mBufferId; }
+
+	protected:
+		GLuint 					mBufferId;
+		GLsizeiptr 				mSegmentSize;
+		int 					mSegmentCount;
+		int 					mSegment;
+
+		// Persistent mapping of the whole ring, NULL for the orphaning path.
+		unsigned char* 			mPersistentMap;
+
+		// Orphaning path mapping, only valid between Begin/EndSegment().
+		unsigned char* 			mMapped;
+
+		std::vector< GLsync > 	mFences;
+	};
+
+} /* namespace GL */
+
+} /* namespace Procyon */
+
+#endif /* _GL_STREAM_BUFFER_H */
@@ -23,6 +23,7 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 ===========================================================================
 */
 #include "GLTexture.h"
+#include "GLStateCache.h"
 #include "Image.h"
 
 namespace Procyon {
@@ -32,6 +33,7 @@ namespace GL {
 	GLTexture::GLTexture()
 		: mTextureId( -1 )
 		, mTarget( GL_TEXTURE_2D )
+		, mPending( NULL )
 	{
 	    glGenTextures( 1, &mTextureId );
 	}
@@ -39,6 +41,7 @@ namespace GL {
 	GLTexture::GLTexture( const std::string& filepath, int mipLevel /* = 0 */ )
 		: mTextureId( -1 )
 		, mTarget( GL_TEXTURE_2D )
+		, mPending( NULL )
 	{
 	    glGenTextures( 1, &mTextureId );
 
@@ -49,19 +52,66 @@ namespace GL {
 	GLTexture::GLTexture( const IImage& img, int mipLevel /* = 0 */ )
 		: mTextureId( -1 )
 		, mTarget( GL_TEXTURE_2D )
+		, mPending( NULL )
 	{
 	    glGenTextures( 1, &mTextureId );
 	    SetData( img, mipLevel );
 	}
 
+	GLTexture::GLTexture( const IImage& img, bool deferUpload )
+		: mTextureId( -1 )
+		, mTarget( GL_TEXTURE_2D )
+		, mPending( NULL )
+		, mPendingMin( FILTER_NEAREST )
+		, mPendingMag( FILTER_NEAREST )
+		, mPendingMipmap( false )
+	{
+		if ( !deferUpload )
+		{
+		    glGenTextures( 1, &mTextureId );
+		    SetData( img );
+		    return;
+		}
+
+		mPending = new MutableImage( img, img.Components() );
+		mDimensions = glm::ivec2( img.GetWidth(), img.GetHeight() );
+	}
+
 	GLTexture::~GLTexture()
 	{
+		if ( mPending )
+		{
+			delete mPending; // never reached the GL
+			return;
+		}
+
+		GLStateCache::Get().TextureDeleted( mTextureId );
 		glDeleteTextures( 1, &mTextureId );
 	}
 
 	void GLTexture::Bind() const
 	{
-		glBindTexture( mTarget, mTextureId );
+		if ( mPending )
+		{
+			Upload();
+		}
+		GLStateCache::Get().BindTexture( mTarget, mTextureId );
+	}
+
+	void GLTexture::Upload() const
+	{
+		MutableImage* img = mPending;
+		mPending = NULL;
+
+		GLTexture* self = const_cast< GLTexture* >( this );
+		glGenTextures( 1, &mTextureId );
+		self->SetData( *img );
+		self->SetMinMagFilter( mPendingMin, mPendingMag );
+		if ( mPendingMipmap )
+		{
+			self->GenerateMipmap();
+		}
+		delete img;
 	}
 
 	void GLTexture::SetData( const IImage& img, int mipLevel /* = 0 */ )
@@ -86,7 +136,7 @@ namespace GL {
 		glTexImage2D( mTarget, mipLevel, format, img.GetWidth(), img.GetHeight(), 0, format, GL_UNSIGNED_BYTE, img.Data() );
 
 	    mDimensions = glm::ivec2( img.GetWidth(), img.GetHeight() );
-        glBindTexture( mTarget, 0 );
+        GLStateCache::Get().BindTexture( mTarget, 0 );
 	}
 
 	void GLTexture::SetMinFilter( TextureFilterMode min )
@@ -103,7 +153,13 @@ namespace GL {
 			default: filter = GL_LINEAR; break;
 		}
 
-		glBindTexture( mTarget, mTextureId );
+		if ( mPending )
+		{
+			mPendingMin = min;
+			return;
+		}
+
+		GLStateCache::Get().BindTexture( mTarget, mTextureId );
 	    glTexParameteri( mTarget, GL_TEXTURE_MIN_FILTER, filter );
 	}
 
@@ -117,7 +173,13 @@ namespace GL {
 			default: filter = GL_LINEAR; break;
 		}
 
-		glBindTexture( mTarget, mTextureId );
+		if ( mPending )
+		{
+			mPendingMag = mag;
+			return;
+		}
+
+		GLStateCache::Get().BindTexture( mTarget, mTextureId );
 	    glTexParameteri( mTarget, GL_TEXTURE_MAG_FILTER, filter );
 	}
 
@@ -129,7 +191,13 @@ namespace GL {
 
 	void GLTexture::GenerateMipmap()
 	{
-		glBindTexture( mTarget, mTextureId );
+		if ( mPending )
+		{
+			mPendingMipmap = true;
+			return;
+		}
+
+		GLStateCache::Get().BindTexture( mTarget, mTextureId );
 		glGenerateMipmap( mTarget );
 	}
 
@@ -145,4 +213,9 @@ namespace GL {
 		return new GL::GLTexture(img, mipLevel);
 	}
 
+	/*static*/ Texture* Texture::AllocateDeferred( const IImage& img )
+	{
+		return new GL::GLTexture( img, true );
+	}
+
 } /* namespace Procyon */
@@ -38,6 +38,8 @@ namespace GL {
 						GLTexture();
 						GLTexture( const std::string& filepath, int mipLevel = 0 );
 						GLTexture( const IImage& img, int mipLevel = 0 );
+						// Deferred, see Texture::AllocateDeferred().
+						GLTexture( const IImage& img, bool deferUpload );
 		virtual			~GLTexture();
 
 		virtual void	Bind() const;
@@ -49,9 +51,16 @@ namespace GL {
 
 	protected:
 		void 		SetData(const IImage& img, int mipLevel = 0);
+		void 		Upload() const;
 
-		GLuint 		mTextureId;
-		GLenum 		mTarget;
+		mutable GLuint 		mTextureId;
+		GLenum 				mTarget;
+
+		// Deferred upload state, cleared by Upload().
+		mutable MutableImage* 	mPending;
+		TextureFilterMode 		mPendingMin;
+		TextureFilterMode 		mPendingMag;
+		bool 					mPendingMipmap;
 	};
 
 } /* namespace GL */
@@ -1,3 +0,0 @@
-#include "ProcyonVaser.h"
-
-#include "vaser.cpp"
@@ -0,0 +1,156 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "NullRenderCore.h"
+
+namespace Procyon {
+
+	static const char* RenderOpToString( RenderCommandOp op )
+	{
+		switch ( op )
+		{
+			case RENDER_OP_QUAD: return "quad";
+			case RENDER_OP_PRIMITIVE: return "primitive";
+			case RENDER_OP_POLYGON: return "polygon";
+			case RENDER_OP_AA_LINE: return "aaline";
+			case RENDER_OP_POLYLINE: return "polyline";
+			default: return "unknown";
+		}
+	}
+
+	// FNV-1a
+	static uint32_t HashBytes( const unsigned char* data, int size )
+	{
+		uint32_t hash = 2166136261u;
+		for ( int i = 0; i < size; i++ )
+		{
+			hash ^= data[ i ];
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	NullRenderCore::NullRenderCore()
+		: mRecordedFlushCount( 0 )
+	{
+	}
+
+	NullRenderCore::~NullRenderCore()
+	{
+	}
+
+	void NullRenderCore::FlushCommands( const Camera2D& camera, const RenderCommand* cmds, int count
+		, const unsigned char* vertexData, int vertexBytes )
+	{
+		const int base = (int)mRecordedVertexData.size();
+		mRecordedVertexData.insert( mRecordedVertexData.end(), vertexData, vertexData + vertexBytes );
+
+		for ( int i = 0; i < count; i++ )
+		{
+			RenderCommand rc = cmds[ i ];
+			rc.offset += base;
+
+			// Producer owned memory is gone by now, never let it escape.
+			switch ( rc.op )
+			{
+				case RENDER_OP_QUAD: if ( !( rc.flags & RENDER_QUAD_STATIC ) ) rc.quaddata = NULL; break;
+				case RENDER_OP_PRIMITIVE: rc.verts = NULL; break;
+				case RENDER_OP_POLYGON: rc.colorverts = NULL; break;
+				case RENDER_OP_AA_LINE: rc.lineverts = NULL; break;
+				case RENDER_OP_POLYLINE: rc.polypoints = NULL; break;
+			}
+
+			mRecordedCommands.push_back( rc );
+			AddBatchStats( rc );
+		}
+
+		mRecordedFlushCount++;
+	}
+
+	void NullRenderCore::ResetStats()
+	{
+		RenderCoreBase::ResetStats();
+
+		mRecordedCommands.clear();
+		mRecordedVertexData.clear();
+		mRecordedFlushCount = 0;
+	}
+
+	const std::vector< RenderCommand >& NullRenderCore::GetRecordedCommands() const
+	{
+		return mRecordedCommands;
+	}
+
+	const std::vector< unsigned char >& NullRenderCore::GetRecordedVertexData() const
+	{
+		return mRecordedVertexData;
+	}
+
+	int NullRenderCore::GetRecordedFlushCount() const
+	{
+		return mRecordedFlushCount;
+	}
+
+	void NullRenderCore::WriteFrame( std::ostream& out ) const
+	{
+		// Textures are numbered by first use so the output is stable between runs.
+		std::unordered_map< const Texture*, int > textureIds;
+
+		out << "flushes " << mRecordedFlushCount
+			<< " commands " << mRecordedCommands.size()
+			<< " bytes " << mRecordedVertexData.size() << "\n";
+
+		for ( const RenderCommand& rc : mRecordedCommands )
+		{
+			const int size = CommandDataSize( rc );
+			out << RenderOpToString( rc.op ) << " flags " << (int)rc.flags;
+
+			switch ( rc.op )
+			{
+				case RENDER_OP_QUAD:
+				{
+					int texId = -1;
+					if ( rc.texture )
+					{
+						auto search = textureIds.find( rc.texture );
+						if ( search == textureIds.end() )
+						{
+							search = textureIds.insert( std::make_pair( rc.texture, (int)textureIds.size() ) ).first;
+						}
+						texId = search->second;
+					}
+					out << " texture " << texId << " instances " << rc.instancecount;
+					break;
+				}
+				case RENDER_OP_PRIMITIVE: out << " mode " << (int)rc.primmode << " verts " << rc.vertcount; break;
+				case RENDER_OP_POLYGON: out << " verts " << rc.colorvertcount; break;
+				case RENDER_OP_AA_LINE: out << " verts " << rc.linevertcount; break;
+				case RENDER_OP_POLYLINE: out << " points " << rc.polypointcount; break;
+			}
+
+			out << " hash " << std::hex << HashBytes( mRecordedVertexData.data() + rc.offset, size ) << std::dec << "\n";
+		}
+	}
+
+} /* namespace Procyon */
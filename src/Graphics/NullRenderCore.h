@@ -0,0 +1,70 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _NULL_RENDER_CORE_H
+#define _NULL_RENDER_CORE_H
+
+#include "RenderCoreBase.h"
+
+namespace Procyon {
+
+	/*
+	================
+	NullRenderCore
+
+	Headless RenderCore. Batches exactly like the GL backend but records the
+	flushed command stream and vertex bytes in memory instead of drawing.
+	The recording is cleared along with the frame stats in ResetStats().
+	================
+	*/
+	class NullRenderCore : public RenderCoreBase
+	{
+	public:
+										NullRenderCore();
+		virtual  						~NullRenderCore();
+
+		virtual void 					ResetStats();
+
+		// Commands flushed this frame. Data pointers are cleared, offset is
+		// relative to GetRecordedVertexData().
+		const std::vector< RenderCommand >& 	GetRecordedCommands() const;
+		const std::vector< unsigned char >& 	GetRecordedVertexData() const;
+		int 							GetRecordedFlushCount() const;
+
+		// Write a deterministic, line based description of the recorded frame
+		// suitable for diffing.
+		void 							WriteFrame( std::ostream& out ) const;
+
+	protected:
+		virtual void 					FlushCommands( const Camera2D& camera, const RenderCommand* cmds, int count
+											, const unsigned char* vertexData, int vertexBytes );
+
+		std::vector< RenderCommand > 	mRecordedCommands;
+		std::vector< unsigned char > 	mRecordedVertexData;
+		int 							mRecordedFlushCount;
+	};
+
+} /* namespace Procyon */
+
+#endif /* _NULL_RENDER_CORE_H */
@@ -0,0 +1,220 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "PolyLineTessellator.h"
+
+#define POLYLINE_EPSILON 1e-4f
+
+namespace Procyon {
+
+	static glm::vec2 Perp( const glm::vec2& d )
+	{
+		return glm::vec2( -d.y, d.x );
+	}
+
+	static int NextDistinct( const glm::vec2* points, int count, int i )
+	{
+		int next = i + 1;
+		while ( next < count && glm::length( points[ next ] - points[ i ] ) <= POLYLINE_EPSILON )
+		{
+			next++;
+		}
+		return next;
+	}
+
+	void PolyLineTessellator::AddVertex( const glm::vec2& p, const glm::vec4& color )
+	{
+		ColorVertex v = { p.x, p.y, color.x, color.y, color.z, color.w };
+		mVerts.push_back( v );
+	}
+
+	// a and d get ca, b and c get cb.
+	void PolyLineTessellator::AddQuad( const glm::vec2& a, const glm::vec2& b, const glm::vec2& c, const glm::vec2& d
+		, const glm::vec4& ca, const glm::vec4& cb )
+	{
+		AddVertex( a, ca );
+		AddVertex( b, cb );
+		AddVertex( c, cb );
+		AddVertex( a, ca );
+		AddVertex( c, cb );
+		AddVertex( d, ca );
+	}
+
+	void PolyLineTessellator::AddSegment( const Section& s0, const Section& s1 )
+	{
+		const glm::vec2 l0 = s0.p + s0.left * mInnerHalfWidth;
+		const glm::vec2 r0 = s0.p + s0.right * mInnerHalfWidth;
+		const glm::vec2 l1 = s1.p + s1.left * mInnerHalfWidth;
+		const glm::vec2 r1 = s1.p + s1.right * mInnerHalfWidth;
+		AddQuad( l0, r0, r1, l1, mColor, mColor );
+
+		if ( mHalfWidth > mInnerHalfWidth )
+		{
+			AddQuad( l0, s0.p + s0.left * mHalfWidth, s1.p + s1.left * mHalfWidth, l1, mColor, mBorder );
+			AddQuad( r0, s0.p + s0.right * mHalfWidth, s1.p + s1.right * mHalfWidth, r1, mColor, mBorder );
+		}
+	}
+
+	// Fill the arc around p starting at unit direction from and turning by
+	// angle, as steps chords fanned from apex. One step is a bevel.
+	void PolyLineTessellator::AddWedge( const glm::vec2& p, const glm::vec2& apex, const glm::vec2& from, float angle, int steps )
+	{
+		const float c = cos( angle / (float)steps );
+		const float s = sin( angle / (float)steps );
+		const bool feathered = mHalfWidth > mInnerHalfWidth;
+
+		glm::vec2 d0 = from;
+		for ( int i = 0; i < steps; i++ )
+		{
+			const glm::vec2 d1( d0.x * c - d0.y * s, d0.x * s + d0.y * c );
+			const glm::vec2 i0 = p + d0 * mInnerHalfWidth;
+			const glm::vec2 i1 = p + d1 * mInnerHalfWidth;
+
+			AddVertex( apex, mColor );
+			AddVertex( i0, mColor );
+			AddVertex( i1, mColor );
+			if ( feathered )
+			{
+				AddQuad( i0, p + d0 * mHalfWidth, p + d1 * mHalfWidth, i1, mColor, mBorder );
+			}
+			d0 = d1;
+		}
+	}
+
+	int PolyLineTessellator::Tessellate( const glm::vec2* points, int count, const PolyLineStyle& style )
+	{
+		const int startCount = (int)mVerts.size();
+
+		int cur = NextDistinct( points, count, 0 );
+		if ( count < 2 || cur >= count || style.width <= 0.0f )
+			return 0;
+
+		mColor = style.color;
+		mBorder = glm::vec4( style.color.x, style.color.y, style.color.z, 0.0f );
+		mHalfWidth = style.width * 0.5f;
+		mInnerHalfWidth = mHalfWidth * ( 1.0f - glm::clamp( style.feather, 0.0f, 1.0f ) );
+
+		glm::vec2 d0 = points[ cur ] - points[ 0 ];
+		float len0 = glm::length( d0 );
+		d0 /= len0;
+		glm::vec2 n0 = Perp( d0 );
+
+		Section start = { points[ 0 ], n0, -n0 };
+		if ( style.cap == PolyLineCapMode::SQUARE )
+		{
+			start.p -= d0 * mHalfWidth;
+		}
+		else if ( style.cap == PolyLineCapMode::ROUND )
+		{
+			AddWedge( points[ 0 ], points[ 0 ], n0, (float)M_PI, (int)ceil( M_PI / POLYLINE_ROUND_STEP ) );
+		}
+
+		for ( ;; )
+		{
+			const glm::vec2& p = points[ cur ];
+			const int next = NextDistinct( points, count, cur );
+			if ( next >= count )
+			{
+				Section end = { p, n0, -n0 };
+				if ( style.cap == PolyLineCapMode::SQUARE )
+				{
+					end.p += d0 * mHalfWidth;
+				}
+				AddSegment( start, end );
+
+				if ( style.cap == PolyLineCapMode::ROUND )
+				{
+					AddWedge( p, p, -n0, (float)M_PI, (int)ceil( M_PI / POLYLINE_ROUND_STEP ) );
+				}
+				break;
+			}
+
+			glm::vec2 d1 = points[ next ] - p;
+			const float len1 = glm::length( d1 );
+			d1 /= len1;
+			const glm::vec2 n1 = Perp( d1 );
+
+			// Signed turn from d0 to d1, positive turns left.
+			const float turn = atan2( d0.x * d1.y - d0.y * d1.x, glm::dot( d0, d1 ) );
+
+			// Miter direction and its length per unit of half width. A full
+			// reversal has no miter, the wedge covers it instead.
+			glm::vec2 miter = n0 + n1;
+			float miterScale = 1.0f;
+			const float miterLen = glm::length( miter );
+			if ( miterLen > POLYLINE_EPSILON )
+			{
+				miter /= miterLen;
+				miterScale = 1.0f / glm::max( glm::dot( miter, n0 ), POLYLINE_EPSILON );
+			}
+			else
+			{
+				miter = n0;
+			}
+
+			if ( style.join == PolyLineJoinMode::MITER && miterScale <= style.miterLimit )
+			{
+				const Section joint = { p, miter * miterScale, -miter * miterScale };
+				AddSegment( start, joint );
+				start = joint;
+			}
+			else
+			{
+				// The inner side still meets at the miter point, as long as it
+				// doesn't reach past the end of either segment.
+				const float reach = glm::min( len0, len1 ) / mHalfWidth;
+				const glm::vec2 inner = miter * glm::min( miterScale, glm::sqrt( 1.0f + reach * reach ) );
+				const int steps = ( style.join == PolyLineJoinMode::ROUND )
+					? glm::max( 1, (int)ceil( fabs( turn ) / POLYLINE_ROUND_STEP ) ) : 1;
+
+				if ( turn > 0.0f )
+				{
+					const Section end = { p, inner, -n0 };
+					AddSegment( start, end );
+					AddWedge( p, p + inner * mInnerHalfWidth, -n0, turn, steps );
+					start.p = p;
+					start.left = inner;
+					start.right = -n1;
+				}
+				else
+				{
+					const Section end = { p, n0, -inner };
+					AddSegment( start, end );
+					AddWedge( p, p - inner * mInnerHalfWidth, n0, turn, steps );
+					start.p = p;
+					start.left = n1;
+					start.right = -inner;
+				}
+			}
+
+			d0 = d1;
+			n0 = n1;
+			len0 = len1;
+			cur = next;
+		}
+
+		return (int)mVerts.size() - startCount;
+	}
+
+} /* namespace Procyon */
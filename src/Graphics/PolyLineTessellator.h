@@ -0,0 +1,92 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _POLY_LINE_TESSELLATOR_H
+#define _POLY_LINE_TESSELLATOR_H
+
+#include "ProcyonCommon.h"
+#include "RenderCore.h"
+
+// Radians covered by each segment of a round join or cap.
+#define POLYLINE_ROUND_STEP ( (float)M_PI / 18.0f )
+
+namespace Procyon {
+
+	struct PolyLineStyle
+	{
+		glm::vec4 			color;
+		float 				width;
+		float 				feather; 	// fraction of width faded to transparent, [0, 1]
+		float 				miterLimit; // longest miter, over width, before MITER bevels
+		PolyLineJoinMode 	join;
+		PolyLineCapMode 	cap;
+	};
+
+	/*
+	================
+	PolyLineTessellator
+
+	Turns polylines into a triangle list of ColorVertex. Vertices accumulate
+	in one arena until Clear(), which keeps its storage, so tessellating the
+	same amount every frame stops allocating after the first.
+	================
+	*/
+	class PolyLineTessellator
+	{
+	public:
+		// Append the triangles for the line through points, consecutive
+		// duplicates are skipped. Returns the number of vertices added.
+		int 					Tessellate( const glm::vec2* points, int count, const PolyLineStyle& style );
+		void 					Clear() { mVerts.clear(); }
+
+		const ColorVertex* 		GetVertices() const { return mVerts.data(); }
+		int 					GetVertexCount() const { return (int)mVerts.size(); }
+
+	protected:
+		// Offsets for a line end at p, per unit of half width on either side.
+		struct Section
+		{
+			glm::vec2 p;
+			glm::vec2 left;
+			glm::vec2 right;
+		};
+
+		void 					AddVertex( const glm::vec2& p, const glm::vec4& color );
+		void 					AddQuad( const glm::vec2& a, const glm::vec2& b, const glm::vec2& c, const glm::vec2& d
+									, const glm::vec4& ca, const glm::vec4& cb );
+		void 					AddSegment( const Section& s0, const Section& s1 );
+		void 					AddWedge( const glm::vec2& p, const glm::vec2& apex, const glm::vec2& from, float angle, int steps );
+
+		std::vector< ColorVertex > 	mVerts;
+
+		// Per Tessellate() call
+		glm::vec4 				mColor;
+		glm::vec4 				mBorder;
+		float 					mHalfWidth;
+		float 					mInnerHalfWidth;
+	};
+
+} /* namespace Procyon */
+
+#endif /* _POLY_LINE_TESSELLATOR_H */
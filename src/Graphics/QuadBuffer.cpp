@@ -0,0 +1,67 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "QuadBuffer.h"
+#include "RenderCoreBase.h"
+
+namespace Procyon {
+
+	QuadBuffer::QuadBuffer()
+		: mQuadCount( 0 )
+		, mCompact( false )
+	{
+	}
+
+	QuadBuffer::~QuadBuffer()
+	{
+	}
+
+	void QuadBuffer::SetQuads( const BatchedQuad* quads, int count )
+	{
+		mPacked.resize( count );
+
+		mCompact = true;
+		for ( int i = 0; i < count && mCompact; i++ )
+		{
+			mCompact = PackCompactQuad( quads[ i ], &mPacked[ i ] );
+		}
+
+		mQuadCount = count;
+		if ( mCompact )
+		{
+			Upload( mPacked.data(), count * (int)sizeof( CompactQuad ) );
+		}
+		else
+		{
+			Upload( quads, count * (int)sizeof( BatchedQuad ) );
+		}
+	}
+
+	void CpuQuadBuffer::Upload( const void* data, int bytes )
+	{
+		const unsigned char* begin = (const unsigned char*)data;
+		mData.assign( begin, begin + bytes );
+	}
+
+} /* namespace Procyon */
@@ -0,0 +1,86 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _QUAD_BUFFER_H
+#define _QUAD_BUFFER_H
+
+#include "RenderCore.h"
+
+namespace Procyon {
+
+	/*
+	================
+	QuadBuffer
+
+	Quad instances that outlive a frame, e.g. a static chunk of tiles. Fill
+	it once with SetQuads() and draw it every frame with
+	RenderCore::AddQuadBuffer() without streaming the data again. Allocate
+	with RenderCore::AllocateQuadBuffer(), the owning core must outlive it.
+	================
+	*/
+	class QuadBuffer
+	{
+	public:
+								QuadBuffer();
+		virtual  				~QuadBuffer();
+
+		// Replace the contents. Stored as CompactQuads if every quad packs
+		// exactly, see PackCompactQuad().
+		void 					SetQuads( const BatchedQuad* quads, int count );
+
+		int 					GetQuadCount() const { return mQuadCount; }
+		bool 					IsCompact() const { return mCompact; }
+
+		// The quads in plain memory, NULL when they only live on the GPU.
+		virtual const unsigned char* 	GetData() const { return NULL; }
+
+	protected:
+		virtual void 			Upload( const void* data, int bytes ) = 0;
+
+		int 						mQuadCount;
+		bool 						mCompact;
+		std::vector< CompactQuad > 	mPacked;
+	};
+
+	/*
+	================
+	CpuQuadBuffer
+
+	QuadBuffer kept in plain memory, used by backends without GPU storage.
+	================
+	*/
+	class CpuQuadBuffer : public QuadBuffer
+	{
+	public:
+		virtual const unsigned char* 	GetData() const { return mData.data(); }
+
+	protected:
+		virtual void 			Upload( const void* data, int bytes );
+
+		std::vector< unsigned char > mData;
+	};
+
+} /* namespace Procyon */
+
+#endif /* _QUAD_BUFFER_H */
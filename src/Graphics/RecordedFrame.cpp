@@ -0,0 +1,189 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "RecordedFrame.h"
+#include "RenderCommandList.h"
+#include "QuadBuffer.h"
+
+namespace Procyon {
+
+	RecordedFrame::RecordedFrame()
+		: mPassCount( 0 )
+		, mSortMode( RENDER_SORT_SUBMISSION )
+	{
+	}
+
+	RecordedFrame::~RecordedFrame()
+	{
+		for ( Pass& pass : mPasses )
+		{
+			delete pass.list;
+		}
+	}
+
+	void RecordedFrame::Clear()
+	{
+		mPassCount = 0;
+	}
+
+	FrameRecorder::FrameRecorder()
+		: mFrame( NULL )
+		, mPassOpen( false )
+		, mSortMode( RENDER_SORT_SUBMISSION )
+		, mLayer( 0 )
+		, mDepth( 0 )
+	{
+		memset( &mStats, 0, sizeof( mStats ) );
+	}
+
+	void FrameRecorder::Begin( RecordedFrame* frame, const RenderFrameStats& stats )
+	{
+		mFrame = frame;
+		mFrame->Clear();
+		mPassOpen = false;
+		mStats = stats;
+	}
+
+	void FrameRecorder::End( const Camera2D& camera )
+	{
+		Flush( camera );
+		mFrame->mSortMode = mSortMode;
+		mFrame = NULL;
+	}
+
+	RenderCommandList* FrameRecorder::CurrentList()
+	{
+		if ( !mPassOpen )
+		{
+			std::vector< RecordedFrame::Pass >& passes = mFrame->mPasses;
+			if ( mFrame->mPassCount == (int)passes.size() )
+			{
+				RecordedFrame::Pass pass;
+				pass.list = new RenderCommandList();
+				passes.push_back( pass );
+			}
+
+			RenderCommandList* list = passes[ mFrame->mPassCount ].list;
+			list->Clear();
+			list->SetLayer( mLayer );
+			list->SetDepth( mDepth );
+			mPassOpen = true;
+		}
+		return mFrame->mPasses[ mFrame->mPassCount ].list;
+	}
+
+	void FrameRecorder::AddCommand( const RenderCommand& cmd )
+	{
+		CurrentList()->AddCommand( cmd );
+	}
+
+	void FrameRecorder::AddOrAppendCommand( const RenderCommand& cmd )
+	{
+		CurrentList()->AddOrAppendCommand( cmd );
+	}
+
+	void* FrameRecorder::AppendCommandData( const RenderCommand& cmd )
+	{
+		return CurrentList()->AppendCommandData( cmd );
+	}
+
+	void FrameRecorder::AddOrAppendQuad( const RenderCommand& cmd, const BatchedQuad& quad )
+	{
+		CurrentList()->AddOrAppendQuad( cmd, quad );
+	}
+
+	void FrameRecorder::AddQuadBuffer( const QuadBuffer* buffer, const Texture* texture, char flags /* = 0 */ )
+	{
+		if ( !buffer || buffer->GetQuadCount() == 0 )
+			return;
+
+		// Buffers from the real core can't be read back, allocate them from
+		// the recorder instead.
+		const unsigned char* data = buffer->GetData();
+		assert( data );
+		if ( !data )
+			return;
+
+		// Stream the quads, the render core can't draw a CpuQuadBuffer itself.
+		RenderCommand cmd;
+		cmd.op 				= RENDER_OP_QUAD;
+		cmd.flags 			= flags & ~( RENDER_QUAD_COMPACT | RENDER_QUAD_STATIC );
+		cmd.texture 		= texture;
+		cmd.instancecount 	= buffer->GetQuadCount();
+		cmd.quaddata 		= (const BatchedQuad*)data;
+		if ( buffer->IsCompact() )
+		{
+			cmd.flags |= RENDER_QUAD_COMPACT;
+		}
+		CurrentList()->AddOrAppendCommand( cmd );
+	}
+
+	QuadBuffer* FrameRecorder::AllocateQuadBuffer()
+	{
+		return new CpuQuadBuffer();
+	}
+
+	void FrameRecorder::Submit( const RenderCommandList& list )
+	{
+		CurrentList()->Submit( list );
+	}
+
+	bool FrameRecorder::RenderCommandsPending() const
+	{
+		return mPassOpen && mFrame->mPasses[ mFrame->mPassCount ].list->RenderCommandsPending();
+	}
+
+	void FrameRecorder::Flush( const Camera2D& camera )
+	{
+		if ( !mPassOpen )
+			return;
+
+		mFrame->mPasses[ mFrame->mPassCount++ ].camera = camera;
+		mPassOpen = false;
+	}
+
+	void FrameRecorder::SetSortMode( RenderSortMode mode )
+	{
+		mSortMode = mode;
+	}
+
+	void FrameRecorder::SetLayer( unsigned char layer )
+	{
+		mLayer = layer;
+		if ( mPassOpen )
+		{
+			CurrentList()->SetLayer( layer );
+		}
+	}
+
+	void FrameRecorder::SetDepth( unsigned short depth )
+	{
+		mDepth = depth;
+		if ( mPassOpen )
+		{
+			CurrentList()->SetDepth( depth );
+		}
+	}
+
+} /* namespace Procyon */
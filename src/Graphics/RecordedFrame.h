@@ -0,0 +1,125 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _RECORDED_FRAME_H
+#define _RECORDED_FRAME_H
+
+#include "RenderCore.h"
+#include "Camera.h"
+
+namespace Procyon {
+
+	class RenderCommandList;
+
+	/*
+	================
+	RecordedFrame
+
+	Everything a Renderer drew between BeginRecording() and EndRecording(),
+	as one RenderCommandList per camera. Replay it with Renderer::Playback()
+	on the render thread. Storage is kept between recordings.
+	================
+	*/
+	class RecordedFrame
+	{
+	public:
+										RecordedFrame();
+										~RecordedFrame();
+
+		void 							Clear();
+
+		// Pass i is drawn by submitting its list and flushing with its camera.
+		int 							GetPassCount() const { return mPassCount; }
+		const RenderCommandList& 		GetPassList( int i ) const { return *mPasses[ i ].list; }
+		const Camera2D& 				GetPassCamera( int i ) const { return mPasses[ i ].camera; }
+		RenderSortMode 					GetSortMode() const { return mSortMode; }
+
+	protected:
+		friend class FrameRecorder;
+
+		struct Pass
+		{
+			Camera2D 			camera;
+			RenderCommandList* 	list;
+		};
+
+		std::vector< Pass > 			mPasses;
+		int 							mPassCount;
+		RenderSortMode 					mSortMode;
+	};
+
+	/*
+	================
+	FrameRecorder
+
+	The RenderCore a Renderer hands out while recording. Commands go to the
+	RecordedFrame's current pass, Flush() closes the pass under camera.
+	Nothing touches the graphics API, so a frame can be recorded on another
+	thread while the previous one is drawn. Quad buffers it allocates live
+	in memory and are copied into the frame when added.
+	================
+	*/
+	class FrameRecorder : public RenderCore
+	{
+	public:
+										FrameRecorder();
+
+		void 							Begin( RecordedFrame* frame, const RenderFrameStats& stats );
+		void 							End( const Camera2D& camera );
+
+		virtual	void 					AddCommand( const RenderCommand& cmd );
+		virtual void 					AddOrAppendCommand( const RenderCommand& cmd );
+		virtual void* 					AppendCommandData( const RenderCommand& cmd );
+		virtual void 					AddOrAppendQuad( const RenderCommand& cmd, const BatchedQuad& quad );
+		virtual void 					AddQuadBuffer( const QuadBuffer* buffer, const Texture* texture, char flags = 0 );
+		virtual QuadBuffer* 			AllocateQuadBuffer();
+		virtual void 					Submit( const RenderCommandList& list );
+
+		virtual bool 					RenderCommandsPending() const;
+		virtual void 					Flush( const Camera2D& camera );
+		virtual void 					SetCamera( const Camera2D& camera ) { }
+
+		virtual void 					SetSortMode( RenderSortMode mode );
+		virtual RenderSortMode 			GetSortMode() const { return mSortMode; }
+		virtual void 					SetLayer( unsigned char layer );
+		virtual void 					SetDepth( unsigned short depth );
+
+		// Stats are those of the last frame played back when recording began.
+		virtual void 					ResetStats() { }
+		virtual const RenderFrameStats& GetFrameStats() const { return mStats; }
+
+	protected:
+		RenderCommandList* 				CurrentList();
+
+		RecordedFrame* 					mFrame;
+		bool 							mPassOpen;
+		RenderSortMode 					mSortMode;
+		unsigned char 					mLayer;
+		unsigned short 					mDepth;
+		RenderFrameStats 				mStats;
+	};
+
+} /* namespace Procyon */
+
+#endif /* _RECORDED_FRAME_H */
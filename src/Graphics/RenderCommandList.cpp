@@ -0,0 +1,60 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "RenderCommandList.h"
+
+namespace Procyon {
+
+	RenderCommandList::RenderCommandList()
+	{
+	}
+
+	RenderCommandList::~RenderCommandList()
+	{
+	}
+
+	void RenderCommandList::Flush( const Camera2D& camera )
+	{
+	}
+
+	void RenderCommandList::Clear()
+	{
+		mRenderCommandCount = 0;
+		mVertexData = NULL;
+		mVertexDataCapacity = 0;
+		mVertexDataWriteOffset = 0;
+	}
+
+	bool RenderCommandList::IsStaged() const
+	{
+		return true;
+	}
+
+	void RenderCommandList::FlushCommands( const Camera2D& camera, const RenderCommand* cmds, int count
+		, const unsigned char* vertexData, int vertexBytes )
+	{
+		assert( false ); // unreachable, see Flush()
+	}
+
+} /* namespace Procyon */
@@ -0,0 +1,67 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _RENDER_COMMAND_LIST_H
+#define _RENDER_COMMAND_LIST_H
+
+#include "RenderCoreBase.h"
+
+namespace Procyon {
+
+	/*
+	================
+	RenderCommandList
+
+	A RenderCore that only records. Producers fill it exactly like the real
+	core, batching included, but vertex data lands in the list's own
+	growable arena so each worker thread can own a list and record without
+	locking. Hand it to RenderCore::Submit() on the render thread, then
+	Clear() it for the next frame. Flush() does nothing, a list is never
+	drawn directly.
+	================
+	*/
+	class RenderCommandList : public RenderCoreBase
+	{
+	public:
+										RenderCommandList();
+		virtual  						~RenderCommandList();
+
+		virtual void 					Flush( const Camera2D& camera );
+
+		// Drop the recorded commands, keeping the storage for reuse.
+		void 							Clear();
+
+		int 							GetCommandCount() const { return mRenderCommandCount; }
+		const RenderCommand* 			GetCommands() const { return mCmdBuffer.data(); }
+		const unsigned char* 			GetVertexData() const { return mVertexData; }
+
+	protected:
+		virtual bool 					IsStaged() const;
+		virtual void 					FlushCommands( const Camera2D& camera, const RenderCommand* cmds, int count
+											, const unsigned char* vertexData, int vertexBytes );
+	};
+
+} /* namespace Procyon */
+
+#endif /* _RENDER_COMMAND_LIST_H */
@@ -31,6 +31,8 @@ namespace Procyon {
 
 	class Texture;
 	class Camera2D;
+	class RenderCommandList;
+	class QuadBuffer;
 
 	/*
 	================
@@ -44,7 +46,8 @@ namespace Procyon {
 		RENDER_OP_QUAD,
 		RENDER_OP_PRIMITIVE,
 		RENDER_OP_POLYGON,
-		RENDER_OP_AA_LINE
+		RENDER_OP_AA_LINE,
+		RENDER_OP_POLYLINE
 	};
 
 	enum PrimitiveMode
@@ -64,6 +67,29 @@ namespace Procyon {
 		float origin[2];
 	};
 
+	/*
+	================
+	CompactQuad
+
+	Quantized BatchedQuad, 24 bytes instead of 60. Only used when it is exact
+	for the quad's geometry, see PackCompactQuad(). Color and rotation are
+	always rounded to 8 and 16 bits.
+	================
+	*/
+	#define COMPACT_QUAD_POSITION_SCALE 	2.0f 	// steps per pixel
+	#define COMPACT_QUAD_ORIGIN_SCALE 		64.0f 	// steps per quad size
+
+	struct CompactQuad
+	{
+		int16_t 	position[2]; 	// fixed point, COMPACT_QUAD_POSITION_SCALE
+		uint16_t 	size[2]; 		// half float
+		uint16_t 	uvoffset[2]; 	// texels
+		uint16_t 	uvsize[2]; 		// texels
+		uint8_t 	color[4]; 		// RGBA8
+		int16_t 	rotation; 		// snorm16 of pi
+		int8_t 		origin[2]; 		// fixed point, COMPACT_QUAD_ORIGIN_SCALE
+	};
+
 	struct PrimitiveVertex
 	{
 		float position[2];
@@ -75,15 +101,81 @@ namespace Procyon {
 		float color[4];
 	};
 
+	// Four per line, start and end on either side, drawn as two triangles
+	// (0, 1, 2) and (2, 1, 3). Style is per vertex so any lines batch.
 	struct AALineVertex
 	{
 		float position[2];
-		float normal[2];
+		float normal[2]; 	// unit, scaled by width
+		float color[4];
+		float width;
+		float feather;
+	};
+
+	enum class PolyLineJoinMode
+	{
+		MITER,
+		BEVEL,
+		ROUND,
+	};
+
+	enum class PolyLineCapMode
+	{
+		BUTT,
+		ROUND,
+		SQUARE,
+	};
+
+	/*
+	================
+	PolyLinePoint
+
+	RENDER_OP_POLYLINE data is the line's points with a POLYLINE_BREAK point
+	before the first and after the last. The backend expands every segment
+	on the GPU, breaks keep lines batched into one command apart.
+	================
+	*/
+	#define POLYLINE_BREAK 3.0e38f
+
+	struct PolyLinePoint
+	{
+		float position[2];
 	};
 
 	enum RenderFlags
 	{
-		RENDER_SCREEN_SPACE = BIT( 0 )
+		RENDER_SCREEN_SPACE = BIT( 0 ),
+		RENDER_QUAD_COMPACT = BIT( 1 ), // RENDER_OP_QUAD data is CompactQuad, set by the core
+		RENDER_QUAD_STATIC 	= BIT( 2 ) 	// RENDER_OP_QUAD data is quadbuffer, set by the core
+	};
+
+	/*
+	================
+	RenderCoreType
+
+	Backend selection for RenderCore::Allocate().
+	================
+	*/
+	enum RenderCoreType
+	{
+		RENDER_CORE_DEFAULT,	// The compiled in graphics API (GL or DirectX).
+		RENDER_CORE_NULL		// Headless, records commands without issuing any API calls.
+	};
+
+	/*
+	================
+	RenderSortMode
+
+	RENDER_SORT_SUBMISSION draws commands in the order they were added.
+	RENDER_SORT_STATE sorts queued commands at Flush() by layer, then render
+	state, merging compatible runs. Order is preserved between layers and
+	between commands sharing identical state within a layer.
+	================
+	*/
+	enum RenderSortMode
+	{
+		RENDER_SORT_SUBMISSION,
+		RENDER_SORT_STATE
 	};
 
 	/*
@@ -100,12 +192,19 @@ namespace Procyon {
 
 		int 					offset;
 		char 					flags;
+		unsigned char 			layer; 	// stamped by the RenderCore, see RenderCore::SetLayer()
+		unsigned short 			depth; 	// stamped by the RenderCore, see RenderCore::SetDepth()
 
 		union
 		{
 			struct // RENDER_OP_QUAD
 			{
-				const BatchedQuad* 		quaddata;
+				union
+				{
+					const BatchedQuad* 	quaddata;
+					const CompactQuad* 	compactdata; // RENDER_QUAD_COMPACT
+					const QuadBuffer* 	quadbuffer;  // RENDER_QUAD_STATIC
+				};
 				int 					instancecount;
 				const Texture*			texture;
 			};
@@ -128,10 +227,19 @@ namespace Procyon {
 			struct// RENDER_OP_AA_LINE
 			{
 				const AALineVertex* 	lineverts;
-				int 					linevertcount;
-				float 					linewidth;
-				float 					feather;
-				float					linecolor[4]; // w: alpha
+				int 					linevertcount; 	// four per line
+			};
+
+			struct // RENDER_OP_POLYLINE
+			{
+				const PolyLinePoint* 	polypoints;
+				int 					polypointcount; // including the breaks
+				float 					polywidth;
+				float 					polyfeather; 	// fraction of width faded out, [0, 1]
+				float 					polymiterlimit;
+				PolyLineJoinMode 		polyjoin;
+				PolyLineCapMode 		polycap;
+				float 					polycolor[4];
 			};
 		};
 
@@ -151,6 +259,12 @@ namespace Procyon {
 		int batchmin;
 		int totalquads;
 		int totalprimitives;
+		int sortmerges; 	// commands folded into a neighbour by RENDER_SORT_STATE
+		int statecallsissued; 	// state changes that reached the driver
+		int statecallsskipped; 	// redundant state changes dropped by the backend
+		int autoflushes; 		// flushes forced by a full vertex chunk
+		int peakcommands; 		// most commands queued at once
+		int peakvertexbytes; 	// most vertex bytes queued at once
 	};
 
 	/*
@@ -165,13 +279,46 @@ namespace Procyon {
 
 		virtual	void 					AddCommand( const RenderCommand& cmd ) = 0;
 		virtual void 					AddOrAppendCommand( const RenderCommand& cmd ) = 0;
+
+		// Queue cmd exactly like AddOrAppendCommand() but hand back storage for
+		// its vertex data instead of copying it from cmd. The caller must fill
+		// all CommandDataSize( cmd ) bytes before the next call into the core.
+		// The storage may be GPU visible, so write it sequentially and never
+		// read it back. Returns NULL if the command was dropped.
+		virtual void* 					AppendCommandData( const RenderCommand& cmd ) = 0;
+
+		// Queue a single quad, stored as a CompactQuad when that is exact and
+		// does not split the batch being built.
+		virtual void 					AddOrAppendQuad( const RenderCommand& cmd, const BatchedQuad& quad ) = 0;
+
+		// Draw every quad in buffer as one batch, nothing is copied.
+		virtual void 					AddQuadBuffer( const QuadBuffer* buffer, const Texture* texture, char flags = 0 ) = 0;
+		virtual QuadBuffer* 			AllocateQuadBuffer() = 0;
+
+		// Queue every command recorded into list, in recording order. Lists
+		// are filled off the render thread, submit them from it in a fixed
+		// order to keep the frame deterministic.
+		virtual void 					Submit( const RenderCommandList& list ) = 0;
+
 		virtual bool 					RenderCommandsPending() const = 0;
 		virtual void 					Flush( const Camera2D& camera ) = 0;
 
+		// Camera for flushes the core has to make on its own, e.g. when its
+		// vertex storage fills mid-frame. Renderer keeps it in sync.
+		virtual void 					SetCamera( const Camera2D& camera ) = 0;
+
+		virtual void 					SetSortMode( RenderSortMode mode ) = 0;
+		virtual RenderSortMode 			GetSortMode() const = 0;
+
+		// Layer and depth applied to every command added after the call.
+		// Only meaningful with RENDER_SORT_STATE, lower layers draw first.
+		virtual void 					SetLayer( unsigned char layer ) = 0;
+		virtual void 					SetDepth( unsigned short depth ) = 0;
+
 		virtual void 					ResetStats() = 0;
 		virtual const RenderFrameStats& GetFrameStats() const = 0;
 
-		static RenderCore*				Allocate();
+		static RenderCore*				Allocate( RenderCoreType type = RENDER_CORE_DEFAULT );
 	};
 
 } /* namespace Procyon */
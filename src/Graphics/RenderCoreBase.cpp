@@ -0,0 +1,770 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "RenderCoreBase.h"
+#include "RenderCommandList.h"
+#include "QuadBuffer.h"
+
+namespace Procyon {
+
+	bool operator==( const RenderCommand& rc1, const RenderCommand& rc2 )
+	{
+		if ( rc1.op == rc2.op && rc1.flags == rc2.flags)
+		{
+			switch ( rc1.op )
+			{
+			case RENDER_OP_QUAD: return rc1.texture == rc2.texture;
+			case RENDER_OP_PRIMITIVE: return rc1.primmode == rc2.primmode && memcmp( rc1.color, rc2.color, 16 ) == 0;
+			case RENDER_OP_POLYLINE:
+				return rc1.polywidth == rc2.polywidth && rc1.polyfeather == rc2.polyfeather
+					&& rc1.polymiterlimit == rc2.polymiterlimit && rc1.polyjoin == rc2.polyjoin
+					&& rc1.polycap == rc2.polycap && memcmp( rc1.polycolor, rc2.polycolor, 16 ) == 0;
+			case RENDER_OP_POLYGON: return rc1.colorprimmode == rc2.colorprimmode;
+			case RENDER_OP_AA_LINE: return true; // all state is per vertex
+			default: return false;
+			}
+		}
+		return false;
+	}
+
+	bool CanAppendCommand( const RenderCommand& prev, const RenderCommand& cmd )
+	{
+		// Static quad buffers live outside the stream, everything else is
+		// contiguous once appended.
+		return !( cmd.op == RENDER_OP_QUAD && ( cmd.flags & RENDER_QUAD_STATIC ) ) && prev == cmd;
+	}
+
+	static void AppendCommand( RenderCommand& prev, const RenderCommand& cmd )
+	{
+		switch ( cmd.op )
+		{
+			case RENDER_OP_QUAD: prev.instancecount += cmd.instancecount; break;
+			case RENDER_OP_PRIMITIVE: prev.vertcount += cmd.vertcount; break;
+			case RENDER_OP_POLYGON: prev.colorvertcount += cmd.colorvertcount; break;
+			case RENDER_OP_AA_LINE: prev.linevertcount += cmd.linevertcount; break;
+			case RENDER_OP_POLYLINE: prev.polypointcount += cmd.polypointcount; break;
+			default: assert( false ); break;
+		}
+	}
+
+	int CommandDataSize( const RenderCommand& rc )
+	{
+		switch ( rc.op )
+		{
+			case RENDER_OP_QUAD: return ( rc.flags & RENDER_QUAD_STATIC ) ? 0 : rc.instancecount * CommandDataStride( rc );
+			case RENDER_OP_PRIMITIVE: return rc.vertcount * sizeof( PrimitiveVertex );
+			case RENDER_OP_POLYGON: return rc.colorvertcount * sizeof( ColorVertex );
+			case RENDER_OP_AA_LINE: return rc.linevertcount * sizeof( AALineVertex );
+			case RENDER_OP_POLYLINE: return rc.polypointcount * sizeof( PolyLinePoint );
+			default: return 0;
+		}
+	}
+
+	int CommandDataStride( const RenderCommand& rc )
+	{
+		switch ( rc.op )
+		{
+			case RENDER_OP_QUAD:
+			{
+				if ( rc.flags & RENDER_QUAD_STATIC )
+					return 1; // nothing in the stream, never pad for it
+				return ( rc.flags & RENDER_QUAD_COMPACT ) ? sizeof( CompactQuad ) : sizeof( BatchedQuad );
+			}
+			case RENDER_OP_PRIMITIVE: return sizeof( PrimitiveVertex );
+			case RENDER_OP_POLYGON: return sizeof( ColorVertex );
+			case RENDER_OP_AA_LINE: return sizeof( AALineVertex );
+			case RENDER_OP_POLYLINE: return sizeof( PolyLinePoint );
+			default: return 1;
+		}
+	}
+
+	static int AlignOffset( int offset, int stride )
+	{
+		return ( ( offset + stride - 1 ) / stride ) * stride;
+	}
+
+	// The vertex (instance for quads) count of rc.
+	static int& CommandCount( RenderCommand& rc )
+	{
+		switch ( rc.op )
+		{
+			case RENDER_OP_PRIMITIVE: return rc.vertcount;
+			case RENDER_OP_POLYGON: return rc.colorvertcount;
+			case RENDER_OP_AA_LINE: return rc.linevertcount;
+			case RENDER_OP_POLYLINE: return rc.polypointcount;
+			default: return rc.instancecount;
+		}
+	}
+
+	// Counts per whole quad, primitive or line, the points a command can be
+	// split between. 0 if it can't be split, polylines join across points.
+	static int CommandElementCount( const RenderCommand& rc )
+	{
+		switch ( rc.op )
+		{
+			case RENDER_OP_QUAD: return 1;
+			case RENDER_OP_PRIMITIVE: return ( rc.primmode == PRIMITIVE_LINE ) ? 2 : 3;
+			case RENDER_OP_POLYGON: return ( rc.colorprimmode == PRIMITIVE_LINE ) ? 2 : 3;
+			case RENDER_OP_AA_LINE: return 4;
+			default: return 0;
+		}
+	}
+
+	// How many counts of rc fit in bytes, in whole elements.
+	static int FitCommandCount( const RenderCommand& rc, int bytes )
+	{
+		const int element = CommandElementCount( rc );
+		if ( element == 0 || bytes <= 0 )
+			return 0;
+		return ( bytes / ( element * CommandDataStride( rc ) ) ) * element;
+	}
+
+	const void* CommandData( const RenderCommand& rc )
+	{
+		switch ( rc.op )
+		{
+			case RENDER_OP_QUAD: return ( rc.flags & RENDER_QUAD_STATIC ) ? NULL : rc.quaddata;
+			case RENDER_OP_PRIMITIVE: return rc.verts;
+			case RENDER_OP_POLYGON: return rc.colorverts;
+			case RENDER_OP_AA_LINE: return rc.lineverts;
+			case RENDER_OP_POLYLINE: return rc.polypoints;
+			default: return NULL;
+		}
+	}
+
+	static bool ToHalf( float f, uint16_t* out )
+	{
+		uint32_t bits;
+		memcpy( &bits, &f, sizeof( bits ) );
+
+		const uint16_t sign = (uint16_t)( ( bits >> 16 ) & 0x8000 );
+		const int exponent = (int)( ( bits >> 23 ) & 0xFF ) - 127;
+		const uint32_t mantissa = bits & 0x7FFFFF;
+		if ( ( bits & 0x7FFFFFFF ) == 0 )
+		{
+			*out = sign;
+			return true;
+		}
+
+		// Normal halves only, and only if no mantissa bits are lost.
+		if ( exponent < -14 || exponent > 15 || ( mantissa & 0x1FFF ) != 0 )
+			return false;
+
+		*out = (uint16_t)( sign | ( ( exponent + 15 ) << 10 ) | ( mantissa >> 13 ) );
+		return true;
+	}
+
+	template< typename T >
+	static bool ToFixed( float f, float scale, T* out )
+	{
+		const float scaled = f * scale;
+		if ( scaled < (float)std::numeric_limits< T >::min() || scaled > (float)std::numeric_limits< T >::max()
+			|| scaled != glm::floor( scaled ) )
+			return false;
+
+		*out = (T)scaled;
+		return true;
+	}
+
+	bool PackCompactQuad( const BatchedQuad& quad, CompactQuad* out )
+	{
+		for ( int i = 0; i < 2; i++ )
+		{
+			if ( !ToFixed( quad.position[ i ], COMPACT_QUAD_POSITION_SCALE, &out->position[ i ] )
+				|| !ToHalf( quad.size[ i ], &out->size[ i ] )
+				|| !ToFixed( quad.uvoffset[ i ], 1.0f, &out->uvoffset[ i ] )
+				|| !ToFixed( quad.uvsize[ i ], 1.0f, &out->uvsize[ i ] )
+				|| !ToFixed( quad.origin[ i ], COMPACT_QUAD_ORIGIN_SCALE, &out->origin[ i ] ) )
+				return false;
+		}
+
+		for ( int i = 0; i < 4; i++ )
+		{
+			if ( quad.color[ i ] < 0.0f || quad.color[ i ] > 1.0f )
+				return false;
+			out->color[ i ] = (uint8_t)( quad.color[ i ] * 255.0f + 0.5f );
+		}
+
+		const float pi = glm::pi< float >();
+		if ( quad.rotation < -pi || quad.rotation > pi )
+			return false;
+		out->rotation = (int16_t)glm::round( quad.rotation / pi * 32767.0f );
+
+		return true;
+	}
+
+	RenderCoreBase::RenderCoreBase()
+		: mRenderCommandCount( 0 )
+		, mVertexData( NULL )
+		, mVertexDataCapacity( 0 )
+		, mVertexDataWriteOffset( 0 )
+		, mSortMode( RENDER_SORT_SUBMISSION )
+		, mLayer( 0 )
+		, mDepth( 0 )
+	{
+		mCmdBuffer.resize( RENDER_CMDS_INITIAL );
+		ResetStats();
+	}
+
+	RenderCoreBase::~RenderCoreBase()
+	{
+	}
+
+	unsigned char* RenderCoreBase::BeginVertexStream( int* capacity )
+	{
+		mCpuVertexData.resize( RENDER_STREAM_CHUNK_BYTES );
+
+		*capacity = RENDER_STREAM_CHUNK_BYTES;
+		return mCpuVertexData.data();
+	}
+
+	void RenderCoreBase::EndVertexStream()
+	{
+	}
+
+	bool RenderCoreBase::IsStaged() const
+	{
+		return mSortMode == RENDER_SORT_STATE;
+	}
+
+	bool RenderCoreBase::MakeRoom( int size, int stride )
+	{
+		if ( !mVertexData )
+		{
+			if ( IsStaged() )
+			{
+				if ( mStagingData.empty() )
+				{
+					mStagingData.resize( RENDER_STAGING_INITIAL_BYTES );
+				}
+				mVertexData = mStagingData.data();
+				mVertexDataCapacity = (int)mStagingData.size();
+			}
+			else
+			{
+				mVertexData = BeginVertexStream( &mVertexDataCapacity );
+				if ( !mVertexData )
+					return false;
+			}
+		}
+
+		const int needed = AlignOffset( mVertexDataWriteOffset, stride ) + size;
+		if ( needed <= mVertexDataCapacity )
+			return true;
+
+		if ( IsStaged() )
+		{
+			// Staging is plain memory, grow it for the rest of the frame.
+			mStagingData.resize( glm::max( needed, mVertexDataCapacity * 2 ) );
+			mVertexData = mStagingData.data();
+			mVertexDataCapacity = (int)mStagingData.size();
+			return true;
+		}
+
+		// The stream chunk is full, draw what it holds and start a new one.
+		if ( RenderCommandsPending() )
+		{
+			Flush( mCamera );
+			mFrameStats.autoflushes++;
+			return MakeRoom( size, stride );
+		}
+
+		PROCYON_WARN( "RenderCore", "Command vertex data (%i bytes) exceeds the vertex chunk (%i bytes), dropping it."
+			, size, mVertexDataCapacity );
+		return false;
+	}
+
+	void RenderCoreBase::AlignData( int stride )
+	{
+		const int aligned = AlignOffset( mVertexDataWriteOffset, stride );
+		memset( mVertexData + mVertexDataWriteOffset, 0, aligned - mVertexDataWriteOffset );
+		mVertexDataWriteOffset = aligned;
+	}
+
+	unsigned char* RenderCoreBase::ReserveData( int size )
+	{
+		unsigned char* data = mVertexData + mVertexDataWriteOffset;
+		mVertexDataWriteOffset += size;
+		mFrameStats.peakvertexbytes = glm::max( mFrameStats.peakvertexbytes, mVertexDataWriteOffset );
+		return data;
+	}
+
+	void* RenderCoreBase::AddCommandData( const RenderCommand& cmd )
+	{
+		const int stride = CommandDataStride( cmd );
+		if ( !MakeRoom( CommandDataSize( cmd ), stride ) )
+			return NULL;
+
+		AlignData( stride );
+
+		if ( mRenderCommandCount == (int)mCmdBuffer.size() )
+		{
+			mCmdBuffer.resize( mCmdBuffer.size() * 2 );
+		}
+
+		RenderCommand& rc = mCmdBuffer[ mRenderCommandCount++ ];
+		rc = cmd;
+		rc.offset = mVertexDataWriteOffset;
+		rc.layer = mLayer;
+		rc.depth = mDepth;
+		mFrameStats.peakcommands = glm::max( mFrameStats.peakcommands, mRenderCommandCount );
+
+		return ReserveData( CommandDataSize( cmd ) );
+	}
+
+	void* RenderCoreBase::AppendCommandData( const RenderCommand& cmd )
+	{
+		if ( mRenderCommandCount > 0 )
+		{
+			RenderCommand& prev = mCmdBuffer[ mRenderCommandCount - 1 ];
+			if ( prev.layer == mLayer && prev.depth == mDepth && CanAppendCommand( prev, cmd ) )
+			{
+				const int size = CommandDataSize( cmd );
+				if ( !MakeRoom( size, 1 ) )
+					return NULL;
+
+				// append, unless making room flushed prev
+				if ( mRenderCommandCount > 0 )
+				{
+					AppendCommand( prev, cmd );
+					return ReserveData( size );
+				}
+			}
+		}
+
+		// fallback to just adding
+		return AddCommandData( cmd );
+	}
+
+	void RenderCoreBase::AddOrAppendQuad( const RenderCommand& cmd, const BatchedQuad& quad )
+	{
+		RenderCommand qc = cmd;
+		qc.op = RENDER_OP_QUAD;
+		qc.flags &= ~RENDER_QUAD_COMPACT;
+		qc.instancecount = 1;
+
+		CompactQuad compact;
+		bool packed = PackCompactQuad( quad, &compact );
+		if ( packed && mRenderCommandCount > 0 )
+		{
+			// Keep extending a full precision batch rather than splitting it.
+			const RenderCommand& prev = mCmdBuffer[ mRenderCommandCount - 1 ];
+			packed = !( prev.layer == mLayer && prev.depth == mDepth && CanAppendCommand( prev, qc ) );
+		}
+
+		if ( packed )
+		{
+			qc.flags |= RENDER_QUAD_COMPACT;
+		}
+
+		void* data = AppendCommandData( qc );
+		if ( data )
+		{
+			if ( packed )
+				memcpy( data, &compact, sizeof( compact ) );
+			else
+				memcpy( data, &quad, sizeof( quad ) );
+		}
+	}
+
+	void RenderCoreBase::Submit( const RenderCommandList& list )
+	{
+		const unsigned char layer = mLayer;
+		const unsigned short depth = mDepth;
+
+		// Replay through AppendCommandData() so runs merge across lists too.
+		const RenderCommand* cmds = list.GetCommands();
+		const unsigned char* vertexData = list.GetVertexData();
+		for ( int i = 0; i < list.GetCommandCount(); i++ )
+		{
+			const RenderCommand& rc = cmds[ i ];
+			mLayer = rc.layer;
+			mDepth = rc.depth;
+
+			CopyCommandData( rc, vertexData + rc.offset, true );
+		}
+
+		mLayer = layer;
+		mDepth = depth;
+	}
+
+	void RenderCoreBase::AddQuadBuffer( const QuadBuffer* buffer, const Texture* texture, char flags /* = 0 */ )
+	{
+		if ( !buffer || buffer->GetQuadCount() == 0 )
+			return;
+
+		RenderCommand cmd;
+		cmd.op 				= RENDER_OP_QUAD;
+		cmd.flags 			= ( flags & ~RENDER_QUAD_COMPACT ) | RENDER_QUAD_STATIC;
+		cmd.texture 		= texture;
+		cmd.instancecount 	= buffer->GetQuadCount();
+		cmd.quadbuffer 		= buffer;
+		if ( buffer->IsCompact() )
+		{
+			cmd.flags |= RENDER_QUAD_COMPACT;
+		}
+
+		// No vertex data to copy, the buffer already holds it.
+		AddCommandData( cmd );
+	}
+
+	QuadBuffer* RenderCoreBase::AllocateQuadBuffer()
+	{
+		return new CpuQuadBuffer();
+	}
+
+	void RenderCoreBase::AddCommand( const RenderCommand& cmd )
+	{
+		CopyCommandData( cmd, CommandData( cmd ), false );
+	}
+
+	void RenderCoreBase::AddOrAppendCommand( const RenderCommand& cmd )
+	{
+		CopyCommandData( cmd, CommandData( cmd ), true );
+	}
+
+	void RenderCoreBase::CopyCommandData( const RenderCommand& cmd, const void* data, bool append )
+	{
+		RenderCommand rest = cmd;
+		const unsigned char* src = (const unsigned char*)data;
+		do
+		{
+			RenderCommand part = rest;
+			if ( !IsStaged() && CommandDataSize( rest ) > 0 )
+			{
+				// Start the stream to learn its capacity.
+				if ( !mVertexData && !MakeRoom( 0, 1 ) )
+					return;
+
+				// A run longer than the chunk fills it with whole elements and
+				// continues in the next one.
+				const int room = mVertexDataCapacity - AlignOffset( mVertexDataWriteOffset, CommandDataStride( rest ) );
+				if ( CommandDataSize( rest ) > room )
+				{
+					int fit = FitCommandCount( rest, room );
+					if ( fit == 0 )
+					{
+						fit = FitCommandCount( rest, mVertexDataCapacity );
+					}
+					if ( fit > 0 && fit < CommandCount( rest ) )
+					{
+						CommandCount( part ) = fit;
+					}
+				}
+			}
+
+			const int size = CommandDataSize( part );
+			void* out = ( append ) ? AppendCommandData( part ) : AddCommandData( part );
+			if ( !out )
+				return;
+			memcpy( out, src, size );
+
+			src += size;
+			CommandCount( rest ) -= CommandCount( part );
+			append = true;
+		} while ( CommandCount( rest ) > 0 );
+	}
+
+	bool RenderCoreBase::RenderCommandsPending() const
+	{
+		return mRenderCommandCount != 0;
+	}
+
+	void RenderCoreBase::Flush( const Camera2D& camera )
+	{
+		// early out if nothng is queued.
+		if ( !RenderCommandsPending() )
+			return;
+
+		if ( mSortMode == RENDER_SORT_STATE )
+		{
+			FlushSorted( camera );
+		}
+		else
+		{
+			FlushCommands( camera, mCmdBuffer.data(), mRenderCommandCount, mVertexData, mVertexDataWriteOffset );
+			EndVertexStream();
+		}
+
+		mRenderCommandCount = 0;
+		mVertexData = NULL;
+		mVertexDataCapacity = 0;
+		mVertexDataWriteOffset = 0;
+	}
+
+	void RenderCoreBase::SetCamera( const Camera2D& camera )
+	{
+		mCamera = camera;
+	}
+
+	void RenderCoreBase::SetSortMode( RenderSortMode mode )
+	{
+		// Queued data already lives in the storage of the old mode.
+		if ( mVertexData && mode != mSortMode )
+		{
+			PROCYON_WARN( "RenderCore", "Sort mode changed with commands pending, ignoring until the next Flush()." );
+			return;
+		}
+		mSortMode = mode;
+	}
+
+	RenderSortMode RenderCoreBase::GetSortMode() const
+	{
+		return mSortMode;
+	}
+
+	void RenderCoreBase::SetLayer( unsigned char layer )
+	{
+		mLayer = layer;
+	}
+
+	void RenderCoreBase::SetDepth( unsigned short depth )
+	{
+		mDepth = depth;
+	}
+
+	/*
+	Sort key layout, most significant first:
+		[63-56] layer
+		[55]	RENDER_SCREEN_SPACE
+		[54-52] op
+		[51-48] program
+		[47-32] texture
+		[31-16] depth
+		[15-0]  unused
+	*/
+	uint64_t RenderCoreBase::MakeSortKey( const RenderCommand& rc )
+	{
+		uint64_t program = 0;
+		uint64_t texture = 0;
+		switch ( rc.op )
+		{
+			case RENDER_OP_QUAD:
+			{
+				program = ( ( rc.texture ) ? 1 : 0 ) | ( ( rc.flags & RENDER_QUAD_COMPACT ) ? 2 : 0 )
+					| ( ( rc.flags & RENDER_QUAD_STATIC ) ? 4 : 0 );
+				if ( rc.texture )
+				{
+					// Textures are numbered in order of first use this flush.
+					auto search = mTextureSortIds.find( rc.texture );
+					if ( search == mTextureSortIds.end() )
+					{
+						search = mTextureSortIds.insert( std::make_pair( rc.texture, (uint16_t)mTextureSortIds.size() ) ).first;
+					}
+					texture = search->second;
+				}
+				break;
+			}
+			case RENDER_OP_PRIMITIVE: program = (uint64_t)rc.primmode; break;
+			case RENDER_OP_POLYGON: program = (uint64_t)rc.colorprimmode; break;
+			case RENDER_OP_POLYLINE: program = (uint64_t)rc.polyjoin | ( (uint64_t)rc.polycap << 2 ); break;
+			default: break;
+		}
+
+		return ( (uint64_t)rc.layer << 56 )
+			| ( (uint64_t)( ( rc.flags & RENDER_SCREEN_SPACE ) ? 1 : 0 ) << 55 )
+			| ( ( (uint64_t)rc.op & 0x7 ) << 52 )
+			| ( ( program & 0xF ) << 48 )
+			| ( ( texture & 0xFFFF ) << 32 )
+			| ( (uint64_t)rc.depth << 16 );
+	}
+
+	// Stable LSD radix sort on 8 bit digits, passes where every key shares the
+	// digit are skipped. Result ends up in entries.
+	template< typename T >
+	static void RadixSort( std::vector< T >& entries, std::vector< T >& scratch )
+	{
+		const size_t count = entries.size();
+		scratch.resize( count );
+
+		T* src = entries.data();
+		T* dst = scratch.data();
+		for ( int shift = 0; shift < 64; shift += 8 )
+		{
+			size_t histogram[ 256 ] = { 0 };
+			for ( size_t i = 0; i < count; i++ )
+			{
+				histogram[ ( src[ i ].key >> shift ) & 0xFF ]++;
+			}
+
+			if ( histogram[ ( src[ 0 ].key >> shift ) & 0xFF ] == count )
+				continue; // constant digit
+
+			size_t sum = 0;
+			for ( int d = 0; d < 256; d++ )
+			{
+				size_t c = histogram[ d ];
+				histogram[ d ] = sum;
+				sum += c;
+			}
+
+			for ( size_t i = 0; i < count; i++ )
+			{
+				dst[ histogram[ ( src[ i ].key >> shift ) & 0xFF ]++ ] = src[ i ];
+			}
+			std::swap( src, dst );
+		}
+
+		if ( src != entries.data() )
+		{
+			std::copy( src, src + count, entries.data() );
+		}
+	}
+
+	void RenderCoreBase::FlushSorted( const Camera2D& camera )
+	{
+		const int count = mRenderCommandCount;
+
+		mTextureSortIds.clear();
+		mSortEntries.resize( count );
+		for ( int i = 0; i < count; i++ )
+		{
+			mSortEntries[ i ].key = MakeSortKey( mCmdBuffer[ i ] );
+			mSortEntries[ i ].index = i;
+		}
+
+		RadixSort( mSortEntries, mSortScratch );
+
+		// Gather vertex data in sorted order into the stream so merged runs
+		// are contiguous, flushing whenever a stream chunk fills up.
+		int capacity = 0;
+		unsigned char* stream = BeginVertexStream( &capacity );
+		mSortedCmds.resize( count );
+
+		int outCount = 0;
+		int writeOffset = 0;
+		for ( int i = 0; i < count && stream; i++ )
+		{
+			RenderCommand rc = mCmdBuffer[ mSortEntries[ i ].index ];
+			const unsigned char* src = mVertexData + rc.offset;
+
+			// Runs longer than what is left of the chunk are split between
+			// elements and continue in the next one.
+			while ( stream && CommandCount( rc ) > 0 )
+			{
+				RenderCommand* prev = ( outCount > 0 ) ? &mSortedCmds[ outCount - 1 ] : NULL;
+				const bool merge = prev && prev->layer == rc.layer && CanAppendCommand( *prev, rc );
+				const int offset = ( merge ) ? writeOffset : AlignOffset( writeOffset, CommandDataStride( rc ) );
+				const int fit = ( offset + CommandDataSize( rc ) <= capacity )
+					? CommandCount( rc ) : FitCommandCount( rc, capacity - offset );
+				if ( fit == 0 )
+				{
+					if ( outCount == 0 )
+					{
+						PROCYON_WARN( "RenderCore", "Command vertex data (%i bytes) exceeds the vertex chunk (%i bytes), dropping it."
+							, CommandDataSize( rc ), capacity );
+						break;
+					}
+
+					FlushCommands( camera, mSortedCmds.data(), outCount, stream, writeOffset );
+					EndVertexStream();
+					mFrameStats.autoflushes++;
+
+					stream = BeginVertexStream( &capacity );
+					outCount = 0;
+					writeOffset = 0;
+					continue;
+				}
+
+				RenderCommand part = rc;
+				CommandCount( part ) = fit;
+				const int size = CommandDataSize( part );
+				memset( stream + writeOffset, 0, offset - writeOffset );
+				memcpy( stream + offset, src, size );
+
+				if ( merge )
+				{
+					AppendCommand( *prev, part );
+					mFrameStats.sortmerges++;
+				}
+				else
+				{
+					RenderCommand& out = mSortedCmds[ outCount++ ];
+					out = part;
+					out.offset = offset;
+				}
+				writeOffset = offset + size;
+
+				src += size;
+				CommandCount( rc ) -= fit;
+			}
+		}
+
+		if ( outCount > 0 )
+		{
+			FlushCommands( camera, mSortedCmds.data(), outCount, stream, writeOffset );
+		}
+		EndVertexStream();
+	}
+
+	void RenderCoreBase::AddBatchStats( const RenderCommand& rc )
+	{
+		mFrameStats.batches++;
+
+		switch ( rc.op )
+		{
+			case RENDER_OP_QUAD:
+			{
+				mFrameStats.totalquads += rc.instancecount;
+				if ( mFrameStats.batchmin != 0 )
+				{
+					mFrameStats.batchmin = glm::min( mFrameStats.batchmin, rc.instancecount );
+				}
+				else
+				{
+					mFrameStats.batchmin = rc.instancecount;
+				}
+				mFrameStats.batchmax = glm::max( mFrameStats.batchmax, rc.instancecount );
+				break;
+			}
+			case RENDER_OP_PRIMITIVE:
+			{
+				mFrameStats.totalprimitives++;
+				break;
+			}
+			default: break;
+		}
+	}
+
+	void RenderCoreBase::ResetStats()
+	{
+		mFrameStats.batches 		= 0;
+		mFrameStats.batchmax 		= 0;
+		mFrameStats.batchmin 		= 0;
+		mFrameStats.totalquads 		= 0;
+		mFrameStats.totalprimitives = 0;
+		mFrameStats.sortmerges 		= 0;
+		mFrameStats.statecallsissued 	= 0;
+		mFrameStats.statecallsskipped 	= 0;
+		mFrameStats.autoflushes 		= 0;
+		mFrameStats.peakcommands 		= 0;
+		mFrameStats.peakvertexbytes 	= 0;
+	}
+
+	const RenderFrameStats& RenderCoreBase::GetFrameStats() const
+	{
+		return mFrameStats;
+	}
+
+} /* namespace Procyon */
@@ -0,0 +1,178 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _RENDER_CORE_BASE_H
+#define _RENDER_CORE_BASE_H
+
+#include "RenderCore.h"
+#include "Camera.h"
+
+// Starting sizes of the command buffer and the RENDER_SORT_STATE staging
+// arena. Both grow on demand and keep their size between frames.
+#define RENDER_CMDS_INITIAL 			1024
+#define RENDER_STAGING_INITIAL_BYTES 	1024 * 1024
+
+// Chunk size of the default CPU vertex stream.
+#define RENDER_STREAM_CHUNK_BYTES 		1024 * 1024 * 4
+
+namespace Procyon {
+
+	/*
+	================
+	RenderCoreBase
+
+	Backend independent command queue shared by every RenderCore. Owns the
+	command buffer and the frame stats. Vertex data is written straight into
+	chunks handed out by BeginVertexStream(), which backends may override to
+	point at GPU visible memory. A full chunk flushes the queue early using
+	the camera from SetCamera(). With RENDER_SORT_STATE it is staged in CPU
+	memory first and gathered into the stream in sorted order at Flush().
+	Backends only need to implement FlushCommands().
+	================
+	*/
+	class RenderCoreBase : public RenderCore
+	{
+	public:
+										RenderCoreBase();
+		virtual  						~RenderCoreBase();
+
+		virtual void 					AddCommand( const RenderCommand& cmd );
+		virtual void 					AddOrAppendCommand( const RenderCommand& cmd );
+		virtual void* 					AppendCommandData( const RenderCommand& cmd );
+		virtual void 					AddOrAppendQuad( const RenderCommand& cmd, const BatchedQuad& quad );
+		virtual void 					Submit( const RenderCommandList& list );
+		virtual void 					AddQuadBuffer( const QuadBuffer* buffer, const Texture* texture, char flags = 0 );
+		virtual QuadBuffer* 			AllocateQuadBuffer();
+
+		virtual bool 					RenderCommandsPending() const;
+
+		virtual void 					Flush( const Camera2D& camera );
+		virtual void 					SetCamera( const Camera2D& camera );
+
+		virtual void 					SetSortMode( RenderSortMode mode );
+		virtual RenderSortMode 			GetSortMode() const;
+		virtual void 					SetLayer( unsigned char layer );
+		virtual void 					SetDepth( unsigned short depth );
+
+		virtual void 					ResetStats();
+		virtual const RenderFrameStats& GetFrameStats() const;
+
+	protected:
+		// Draw cmds, their offsets index vertexData which is the chunk from the
+		// last BeginVertexStream().
+		virtual void 		FlushCommands( const Camera2D& camera, const RenderCommand* cmds, int count
+								, const unsigned char* vertexData, int vertexBytes ) = 0;
+
+		// Storage for the next chunk of vertex data, capacity in bytes. Called
+		// lazily on the first command after a flush. EndVertexStream() is called
+		// once FlushCommands() has issued every draw sourcing it.
+		virtual unsigned char* 	BeginVertexStream( int* capacity );
+		virtual void 			EndVertexStream();
+
+		// True if vertex data goes to the growable staging arena instead of
+		// the stream, e.g. for RENDER_SORT_STATE.
+		virtual bool 			IsStaged() const;
+
+		// Queue cmd and reserve its vertex data, NULL if it was dropped.
+		void* 				AddCommandData( const RenderCommand& cmd );
+
+		// Queue cmd, appending if allowed, and copy its vertex data from data.
+		// Runs longer than a stream chunk are split across auto flushes.
+		void 				CopyCommandData( const RenderCommand& cmd, const void* data, bool append );
+
+		// Ensure size bytes, aligned to stride, fit in mVertexData. Grows the
+		// staging arena or flushes a full stream chunk. False if it never fits.
+		bool 				MakeRoom( int size, int stride );
+		unsigned char* 		ReserveData( int size );
+
+		// Pad the write offset to a multiple of stride.
+		void 				AlignData( int stride );
+
+		// Reorder, merge and draw the queued commands for RENDER_SORT_STATE.
+		void 				FlushSorted( const Camera2D& camera );
+		uint64_t 			MakeSortKey( const RenderCommand& rc );
+
+		// Accumulate a single issued batch into mFrameStats.
+		void 				AddBatchStats( const RenderCommand& rc );
+
+		// The buffer of render commands- cleared each flush, grown on demand.
+		std::vector< RenderCommand > mCmdBuffer;
+
+		// Current size of mCmdBuffer.
+		int 				mRenderCommandCount;
+
+		// Vertex data for all queued commands, NULL until the first command
+		// after a flush. Points into the stream or mStagingData.
+		unsigned char* 		mVertexData;
+		int 				mVertexDataCapacity;
+		int 				mVertexDataWriteOffset;
+
+		// CPU memory behind the default BeginVertexStream().
+		std::vector< unsigned char > mCpuVertexData;
+
+		// RENDER_SORT_STATE staging, gathered into the stream at Flush().
+		std::vector< unsigned char > mStagingData;
+
+		// Used for flushes the core triggers itself.
+		Camera2D 			mCamera;
+
+		RenderFrameStats	mFrameStats;
+
+		RenderSortMode 		mSortMode;
+		unsigned char 		mLayer;
+		unsigned short 		mDepth;
+
+		// RENDER_SORT_STATE scratch, reused between flushes.
+		struct SortEntry
+		{
+			uint64_t 		key;
+			int 			index;
+		};
+		std::vector< SortEntry > 		mSortEntries;
+		std::vector< SortEntry > 		mSortScratch;
+		std::vector< RenderCommand > 	mSortedCmds;
+		std::unordered_map< const Texture*, uint16_t > mTextureSortIds;
+	};
+
+	bool operator==( const RenderCommand& rc1, const RenderCommand& rc2 );
+
+	// True if cmd can be folded into prev by adding its element count.
+	bool CanAppendCommand( const RenderCommand& prev, const RenderCommand& cmd );
+
+	// Size in bytes of the vertex data referenced by rc.
+	int CommandDataSize( const RenderCommand& rc );
+
+	// Size in bytes of a single vertex (or instance) of rc. Command offsets are
+	// always a multiple of it so backends can address the data by index.
+	int CommandDataStride( const RenderCommand& rc );
+
+	// The producer side vertex data pointer of rc.
+	const void* CommandData( const RenderCommand& rc );
+
+	// Quantize quad, false if position, size, uvs or origin would change.
+	bool PackCompactQuad( const BatchedQuad& quad, CompactQuad* out );
+
+} /* namespace Procyon */
+
+#endif /* _RENDER_CORE_BASE_H */
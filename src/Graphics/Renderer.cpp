@@ -24,29 +24,37 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "Renderer.h"
 #include "RenderCore.h"
+#include "RecordedFrame.h"
+#include "RenderCommandList.h"
 #include "Renderable.h"
 #include "Texture.h"
 #include "Platform/Window.h"
 #include "Graphics/GL/GLContext.h"
+#include "Graphics/GL/GLStateCache.h"
 
 namespace Procyon {
 
 	bool sDebugLines = false;
+	bool sGpuPolyLines = false;
 
-	Renderer::Renderer( IWindow* window )
+	Renderer::Renderer( IWindow* window, RenderCoreType coreType /*= RENDER_CORE_DEFAULT*/ )
 		: mWindow( window )
 		, mClearColor( 0.0f, 1.0f, 0.0f, 1.0f )
+		, mCoreType( coreType )
 	{
-		if ( mWindow )
+		if ( mWindow && !IsHeadless() )
 		{
 			mWindow->GetGLContext();
 		}
-		mRenderCore = RenderCore::Allocate();
+		mRenderCore = RenderCore::Allocate( mCoreType );
+		mTarget = mRenderCore;
+		mRecorder = new FrameRecorder();
 		ResetCameras();
 	}
 
 	Renderer::~Renderer()
 	{
+		delete mRecorder;
 		delete mRenderCore;
 	}
 
@@ -55,14 +63,15 @@ namespace Procyon {
 		//TODO: compare camera here and maybe prevent a flush?
 
 		// flush the pipeline
-		if ( mRenderCore->RenderCommandsPending() )
-			mRenderCore->Flush( mCameras.top() );
+		if ( mTarget->RenderCommandsPending() )
+			mTarget->Flush( mCameras.top() );
 	}
 
 	const Camera2D& Renderer::PushCamera()
 	{
 		Flush();
 		mCameras.push( mCameras.top() );
+		mTarget->SetCamera( mCameras.top() );
 		return mCameras.top();
 	}
 
@@ -70,6 +79,7 @@ namespace Procyon {
 	{
 		Flush();
 		mCameras.push( camera );
+		mTarget->SetCamera( mCameras.top() );
 		return mCameras.top();
 	}
 
@@ -77,6 +87,7 @@ namespace Procyon {
 	{
 		Flush();
 		mCameras.pop();
+		mTarget->SetCamera( mCameras.top() );
 	}
 
 	const Camera2D& Renderer::GetCamera()
@@ -91,6 +102,7 @@ namespace Procyon {
 			mCameras.pop();
 
 		mCameras.push( camera );
+		mTarget->SetCamera( mCameras.top() );
 	}
 
 	void Renderer::SetClearColor( const glm::vec4 color )
@@ -105,6 +117,11 @@ namespace Procyon {
 
 	void Renderer::BeginRender()
 	{
+		mRenderCore->ResetStats();
+
+		if ( IsHeadless() )
+			return;
+
 		if ( mWindow )
 		{
 			mWindow->GetGLContext()->MakeCurrent();
@@ -114,16 +131,17 @@ namespace Procyon {
 		glClearColor( mClearColor.r, mClearColor.g, mClearColor.b, mClearColor.a );
 		glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
 
-		glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
-		glEnable( GL_BLEND );
+		// Whatever ran on the context since the last frame (e.g. Qt in the
+		// editor) may have changed state behind the cache.
+		GL::GLStateCache& cache = GL::GLStateCache::Get();
+		cache.Invalidate();
+		cache.SetBlend( true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
 		glDisable( GL_MULTISAMPLE );
-
-		mRenderCore->ResetStats();
 	}
 
 	void Renderer::Draw( const Renderable* r )
 	{
-		r->PostRenderCommands( this, mRenderCore );
+		r->PostRenderCommands( this, mTarget );
 	}
 
     void Renderer::DrawWireframeRect( const Rect& rect, const glm::vec4& color, bool screenSpace )
@@ -147,21 +165,60 @@ namespace Procyon {
 	void Renderer::EndRender()
 	{
 		mRenderCore->Flush( mCameras.top() );
+		Present();
+	}
 
-		if ( mWindow )
+	void Renderer::Present()
+	{
+		if ( mWindow && !IsHeadless() )
 		{
 			mWindow->GetGLContext()->SwapBuffers();
 		}
 	}
 
+	void Renderer::BeginRecording( RecordedFrame* frame )
+	{
+		assert( mTarget == mRenderCore );
+		mRecorder->SetSortMode( mRenderCore->GetSortMode() );
+		mRecorder->Begin( frame, mRenderCore->GetFrameStats() );
+		mTarget = mRecorder;
+	}
+
+	void Renderer::EndRecording()
+	{
+		assert( mTarget == mRecorder );
+		mRecorder->End( mCameras.top() );
+		mTarget = mRenderCore;
+	}
+
+	void Renderer::Playback( const RecordedFrame& frame )
+	{
+		BeginRender();
+
+		mRenderCore->SetSortMode( frame.GetSortMode() );
+		for ( int i = 0; i < frame.GetPassCount(); i++ )
+		{
+			mRenderCore->SetCamera( frame.GetPassCamera( i ) );
+			mRenderCore->Submit( frame.GetPassList( i ) );
+			mRenderCore->Flush( frame.GetPassCamera( i ) );
+		}
+
+		Present();
+	}
+
 	const RenderCore* Renderer::GetRenderCore() const
 	{
-		return mRenderCore;
+		return mTarget;
 	}
 
 	RenderCore* Renderer::GetRenderCore()
 	{
-		return mRenderCore;
+		return mTarget;
+	}
+
+	bool Renderer::IsHeadless() const
+	{
+		return mCoreType == RENDER_CORE_NULL;
 	}
 
 	void Renderer::DrawLine( const glm::vec2& start, const glm::vec2& end, const glm::vec4& color )
@@ -182,7 +239,7 @@ namespace Procyon {
         cmd.color[1]         = color.y;
         cmd.color[2]         = color.z;
         cmd.color[3]         = color.w;
-        mRenderCore->AddOrAppendCommand( cmd );
+        mTarget->AddOrAppendCommand( cmd );
 	}
 
 	void Renderer::DrawAALine( const glm::vec2& start, const glm::vec2& end, float width, float feather, const glm::vec4& color )
@@ -191,370 +248,138 @@ namespace Procyon {
 		glm::vec2 norm1 = glm::vec2( -dir.y, dir.x );
 		glm::vec2 norm2 = glm::vec2( dir.y, -dir.x );
 
-        AALineVertex lineverts[] =
-        {
-			{ start.x, start.y, norm1.x, norm1.y },
-			{ start.x, start.y, norm2.x, norm2.y },
-			{ end.x, end.y, norm1.x, norm1.y },
-			{ end.x, end.y, norm2.x, norm2.y }
-        };
-
 		RenderCommand cmd;
 		cmd.op             	= RENDER_OP_AA_LINE;
 		cmd.flags           = 0;
-		cmd.lineverts		= &lineverts[0];
+		cmd.lineverts		= NULL;
 		cmd.linevertcount	= 4;
-		cmd.linewidth 		= width;
-		cmd.feather			= feather;
-		cmd.linecolor[0]    = color.x;
-		cmd.linecolor[1]    = color.y;
-		cmd.linecolor[2]	= color.z;
-		cmd.linecolor[3]	= color.w;
-        mRenderCore->AddOrAppendCommand( cmd );
-	}
-
-	static double SignedArea( const glm::vec2& P1, const glm::vec2& P2, const glm::vec2& P3 )
-	{
-	    return (P2.x-P1.x)*(P3.y-P1.y) - (P3.x-P1.x)*(P2.y-P1.y);
-	}
 
-	static glm::vec2 RayIntersection( const glm::vec2& A1, glm::vec2 A2
-		, const glm::vec2& B1, glm::vec2 B2 )
-	{
-		glm::vec2 D1 = glm::normalize( A2 - A1 );
-		glm::vec2 D2 = glm::normalize( B2 - B1 );
-		float u = (A1.y * D2.x + D2.y*B1.x - B1.y*D2.x - D2.y*A1.x ) / (D1.x*D2.y - D1.y*D2.x);
-		return A1 + D1 * u;
-	}
-
-	static std::vector< glm::vec2 > BasicArc( const glm::vec2& P, float r, float dangle, float angle1, float angle2 )
-	{
-		float mod_diff = std::fmod( angle2 - angle1, 2.0f * (float)M_PI );
-		float signed_dist = mod_diff;
-		if ( signed_dist > (float)M_PI )
-			signed_dist -= 2.0f * (float)M_PI;
-		else if ( signed_dist < (float)-M_PI )
-			signed_dist += 2.0f * (float)M_PI;
-
-		PROCYON_DEBUG( "PolyLine", "angle1 %f, angle2 %f, signed_dist %f"
-	 		, angle1, angle2, signed_dist );
-
-		angle2 = angle1 + signed_dist;
-		bool incremental = true;
-		if ( signed_dist < 0 ) {
-		    incremental = false; //means decremental
-		}
+		// Width, feather and color ride along in the vertices, so consecutive
+		// lines always append to the same batch.
+		AALineVertex* out = (AALineVertex*)mTarget->AppendCommandData( cmd );
+		if ( !out )
+			return;
 
-		std::vector< glm::vec2 > ret;
-		if ( incremental) {
-		    for ( float a=angle1; a < angle2; a+=dangle)
-		    {
-		        float x = cos(a);    float y = sin(a);
-				ret.push_back( glm::vec2( P.x + x * r, P.y + y * r ) );
-		    }
-		} else {
-		    for ( float a=angle1; a > angle2; a-=dangle)
-		    {
-		        float x=cos(a);    float y=sin(a);
-				ret.push_back( glm::vec2( P.x+x*r,P.y + y * r ) );
-		    }
-		}
-		return ret;
+		const AALineVertex lineverts[] =
+		{
+			{ start.x, start.y, norm1.x, norm1.y, color.x, color.y, color.z, color.w, width, feather },
+			{ start.x, start.y, norm2.x, norm2.y, color.x, color.y, color.z, color.w, width, feather },
+			{ end.x, end.y, norm1.x, norm1.y, color.x, color.y, color.z, color.w, width, feather },
+			{ end.x, end.y, norm2.x, norm2.y, color.x, color.y, color.z, color.w, width, feather }
+		};
+		memcpy( out, lineverts, sizeof( lineverts ) );
 	}
 
-	struct AnchorGeometry
+	void Renderer::DrawPolyLine( const std::vector< glm::vec2 >& points, const glm::vec4& color
+		, float width, PolyLineJoinMode joinMode, PolyLineCapMode capMode, float miterLimit /*= 4.0f */
+		, bool screenSpace /*= true */ )
 	{
-		void AddQuad( const glm::vec2& Q1, const glm::vec2& Q2, const glm::vec2& Q3
-			, const glm::vec2& Q4, const glm::vec4& color )
-		{
-			ColorVertex temp[] =
-			{
-				{ Q1.x, Q1.y, color.x, color.y, color.z, color.w },
-				{ Q2.x, Q2.y, color.x, color.y, color.z, color.w },
-				{ Q3.x, Q3.y, color.x, color.y, color.z, color.w },
-				{ Q1.x, Q1.y, color.x, color.y, color.z, color.w },
-				{ Q4.x, Q4.y, color.x, color.y, color.z, color.w },
-				{ Q3.x, Q3.y, color.x, color.y, color.z, color.w }
-			};
-			mVerts2.insert( mVerts2.end(), temp, std::end( temp ) );
-		}
-
-		void AddTri( const glm::vec2& Q1, const glm::vec2& Q2, const glm::vec2& Q3
-		 	,  const glm::vec4& color )
+		// Repeated points would read as caps in the middle of the line.
+		int count = 0;
+		for ( size_t i = 0; i < points.size(); ++i )
 		{
-			ColorVertex temp[] =
-			{
-				{ Q1.x, Q1.y, color.x, color.y, color.z, color.w },
-				{ Q2.x, Q2.y, color.x, color.y, color.z, color.w },
-				{ Q3.x, Q3.y, color.x, color.y, color.z, color.w },
-			};
-			mVerts2.insert( mVerts2.end(), temp, std::end( temp ) );
+			if ( i == 0 || points[ i ] != points[ i - 1 ] )
+				count++;
 		}
 
-		void AddQuad( const glm::vec2& Q1, const glm::vec4& C1
-			, const glm::vec2& Q2, const glm::vec4& C2
-			, const glm::vec2& Q3, const glm::vec4& C3
-			, const glm::vec2& Q4, const glm::vec4& C4 )
+		if ( count < 2 )
 		{
-			ColorVertex temp[] =
-			{
-				{ Q1.x, Q1.y, C1.x, C1.y, C1.z, C1.w },
-				{ Q2.x, Q2.y, C2.x, C2.y, C2.z, C2.w },
-				{ Q3.x, Q3.y, C3.x, C3.y, C3.z, C3.w },
-				{ Q1.x, Q1.y, C1.x, C1.y, C1.z, C1.w },
-				{ Q4.x, Q4.y, C4.x, C4.y, C4.z, C4.w },
-				{ Q3.x, Q3.y, C3.x, C3.y, C3.z, C3.w }
-			};
-			mVerts2.insert( mVerts2.end(), temp, std::end( temp ) );
-		}
-
-		std::vector< glm::vec2 > mVerts;
-		std::vector< glm::vec4 > mColors;
-		std::vector< ColorVertex > mVerts2;
-	};
-
-	struct AnchorMetrics
-	{
-		glm::vec2 P[ 3 ]; 	// Anchor points
-		float width, halfWidth;		// Line width
-		glm::vec2 Tn[ 2 ]; 	// Normals to P1-P0 and P2-P1
-		glm::vec2 T[ 2 ];	// Normals scaled to the inner half line width
-		glm::vec2 To[ 2 ];	// Normals scaled to the half line width
-		glm::vec2 vP, vPo;		//
-		PolyLineJoinMode join;
-		float miterLimit, feather;
-		float outerWidth, outerHWidth;
-		float innerWidth, innerHWidth;
-	};
-
-	static void ComputeAnchorMetrics( AnchorMetrics& m )
-	{
-		m.feather = glm::clamp( m.feather, 0.0f, 1.0f );
-
-		m.outerWidth = m.width * m.feather;
-		m.outerHWidth = m.outerWidth / 2.0f;
-		m.innerWidth = m.width - m.width * m.feather;
-		m.innerHWidth = m.innerWidth / 2.0f;
-		m.halfWidth = m.width / 2.0f;
-
-		glm::vec2 temp;
-		temp = m.P[ 1 ] - m.P[ 0 ];
-		m.Tn[ 0 ] = glm::normalize( glm::vec2( -temp.y, temp.x ) );
-		temp = m.P[ 2 ] - m.P[ 1 ];
-		m.Tn[ 1 ] = glm::normalize( glm::vec2( -temp.y, temp.x ) );
-		if ( SignedArea( m.P[ 0 ], m.P[ 1 ], m.P[ 2 ] ) > 0.0 )
-		{
-			m.Tn[ 0 ] = -m.Tn[ 0 ];
-			m.Tn[ 1 ] = -m.Tn[ 1 ];
-		}
-		m.T[ 0 ] = m.Tn[ 0 ] * m.innerHWidth;
-		m.T[ 1 ] = m.Tn[ 1 ] * m.innerHWidth;
-		m.To[ 0 ] = m.Tn[ 0 ] * m.halfWidth;
-		m.To[ 1 ] = m.Tn[ 1 ] * m.halfWidth;
-
-		glm::vec2 intersect = RayIntersection(
-			m.T[ 0 ] + m.P[ 0 ], m.T[ 0 ] + m.P[ 1 ],
-			m.T[ 1 ] + m.P[ 2 ], m.T[ 1 ] + m.P[ 1 ]
-		);
-		m.vP = intersect - m.P[ 1 ];
-
-		glm::vec2 intersect2 = RayIntersection(
-			m.To[ 0 ] + m.P[ 0 ], m.To[ 0 ] + m.P[ 1 ],
-			m.To[ 1 ] + m.P[ 2 ], m.To[ 1 ] + m.P[ 1 ]
-		);
-		m.vPo = intersect2 - m.P[ 1 ];
-
-		if( m.join == PolyLineJoinMode::MITER && glm::length( m.vP ) > ( m.miterLimit * 0.5f ) )
-		{
-			m.join = PolyLineJoinMode::BEVEL;
+			PROCYON_WARN( "PolyLine", "must provide at least two distinct points to draw DrawPolyLine");
+			return;
 		}
-	}
 
-	static void TesselateAnchor( AnchorMetrics& m, AnchorGeometry& out, glm::vec4 color )
-	{
-		if ( m.join == PolyLineJoinMode::BEVEL )
+		if ( !sGpuPolyLines )
 		{
-			out.AddQuad( m.T[ 0 ] + m.P[ 0 ], m.T[ 0 ] + m.P[ 1 ], m.P[ 1 ] - m.vP, m.P[ 0 ] - m.T[ 0 ], color );
-			out.AddQuad( m.T[ 1 ] + m.P[ 2 ], m.T[ 1 ] + m.P[ 1 ], m.P[ 1 ] - m.vP, m.P[ 2 ] - m.T[ 1 ], color );
-			out.AddTri( m.P[ 1 ] + m.T[ 0 ], m.P[ 1 ] + m.T[ 1 ], m.P[ 1 ] - m.vP, color );
+			PolyLineStyle style;
+			style.color 		= color;
+			style.width 		= width;
+			style.feather 		= 0.5f;
+			style.miterLimit 	= miterLimit;
+			style.join 			= joinMode;
+			style.cap 			= capMode;
+
+			// The whole line goes out as one command, the arena is only
+			// scratch space until the core has copied it.
+			mPolyLines.Clear();
+			if ( mPolyLines.Tessellate( points.data(), (int)points.size(), style ) == 0 )
+				return;
 
-			// Feather
-			glm::vec4 border( color.x, color.y, color.z, 0.0f );
-			if ( sDebugLines )
-			{
-				color = glm::vec4( 0.0f, 0.0f, 1.0f, 1.0f );
-				border = glm::vec4( color.x, color.y, color.z, 1.0f );
-			}
-			out.AddQuad(
-				m.To[ 0 ] + m.P[ 0 ], border,
-				m.T[ 0 ] + m.P[ 0 ], color,
-				m.T[ 0 ] + m.P[ 1 ], color,
-				m.To[ 0 ] + m.P[ 1 ], border );
-			out.AddQuad(
-				-m.To[ 0 ] + m.P[ 0 ], border,
-				-m.T[ 0 ] + m.P[ 0 ], color,
-				m.P[ 1 ] - m.vP, color,
-				m.P[ 1 ] - m.vPo, border );
-			if ( sDebugLines )
-			{
-				color = glm::vec4( 0.0f, 01.0f, 0.0f, 1.0f );
-				border = glm::vec4( color.x, color.y, color.z, border.w );
-			}
-			out.AddQuad(
-				m.To[ 1 ] + m.P[ 2 ], border,
-				m.T[ 1 ] + m.P[ 2 ], color,
-				m.T[ 1 ] + m.P[ 1 ], color,
-				m.To[ 1 ] + m.P[ 1 ], border );
-			out.AddQuad(
-				-m.To[ 1 ] + m.P[ 2 ], border,
-				-m.T[ 1 ] + m.P[ 2 ], color,
-				m.P[ 1 ] - m.vP, color,
-				m.P[ 1 ] - m.vPo, border );
+			RenderCommand cmd;
+			cmd.op               = RENDER_OP_POLYGON;
+			cmd.flags            = ( screenSpace ) ? RENDER_SCREEN_SPACE : 0;
+			cmd.colorprimmode    = PRIMITIVE_TRIANGLE;
+			cmd.colorverts       = mPolyLines.GetVertices();
+			cmd.colorvertcount   = mPolyLines.GetVertexCount();
+			mTarget->AddOrAppendCommand( cmd );
 
 			if ( sDebugLines )
 			{
-				color = glm::vec4( 1.0f, 0.0f, 0.0f, 1.0f );
-				border = glm::vec4( color.x, color.y, color.z, border.w );
-			}
-			out.AddQuad(
-				m.To[ 0 ] + m.P[ 1 ], border,
-				m.T[ 0 ] + m.P[ 1 ], color,
-				m.T[ 1 ] + m.P[ 1 ], color,
-				m.To[ 1 ] + m.P[ 1 ], border );
-
-		}
-		else if ( m.join == PolyLineJoinMode::MITER )
-		{
-			out.mVerts =
-			{
-				m.T[ 0 ] + m.P[ 0 ], m.T[ 0 ] + m.P[ 1 ], m.P[ 1 ] - m.vP,
-				m.T[ 0 ] + m.P[ 0 ], m.P[ 1 ] - m.vP, m.P[ 0 ] - m.T[ 0 ],
-				m.T[ 1 ] + m.P[ 2 ], m.T[ 1 ] + m.P[ 1 ], m.P[ 1 ] - m.vP,
-				m.P[ 2 ] + m.T[ 1 ], m.P[ 1 ] - m.vP, m.P[ 2 ] - m.T[ 1 ],
-				m.P[ 1 ] + m.T[ 0 ], m.P[ 1 ] + m.T[ 1 ], m.P[ 1 ] - m.vP,
-				m.P[ 1 ] + m.T[ 0 ], m.P[ 1 ] + m.T[ 1 ], m.P[ 1 ] + m.vP,
-			};
-		}
-		else if ( m.join == PolyLineJoinMode::ROUND )
-		{
-			out.mVerts =
-			{
-				m.T[ 0 ] + m.P[ 0 ], m.T[ 0 ] + m.P[ 1 ], m.P[ 1 ] - m.vP,
-				m.T[ 0 ] + m.P[ 0 ], m.P[ 1 ] - m.vP, m.P[ 0 ] - m.T[ 0 ],
-				m.T[ 1 ] + m.P[ 2 ], m.T[ 1 ] + m.P[ 1 ], m.P[ 1 ] - m.vP,
-				m.P[ 2 ] + m.T[ 1 ], m.P[ 1 ] - m.vP, m.P[ 2 ] - m.T[ 1 ],
-			};
-
-			glm::vec2 jointInner = m.P[ 1 ] - m.vP;
-			glm::vec2 arcStart = m.T[ 0 ] + m.P[ 1 ] - jointInner;
-			glm::vec2 arcEnd = m.T[ 1 ] + m.P[ 1 ] - jointInner;
-			float radius = glm::length( arcStart );
-			float angle1 = acos( glm::normalize( arcStart ).x );
-			float angle2 = acos( glm::normalize( arcEnd ).x );
-			if ( arcStart.y < 0.0f ) { angle1 = 2.0f * (float)M_PI - angle1; }
-			if ( arcEnd.y < 0.0f ) { angle2 = 2.0f * (float)M_PI - angle2; }
-			PROCYON_DEBUG( "PolyLine", "Angle1 %f, Angle2 %f", 180.0f * angle1 / (float)M_PI, 180.0f * angle2 / (float)M_PI );
-			std::vector< glm::vec2 > arc = BasicArc( jointInner, radius, (float)M_PI/36.0f, angle1, angle2 );
-			PROCYON_DEBUG( "PolyLine", "arc Size %i", arc.size() );
-			for ( size_t i = 0; i < arc.size(); ++i )
-			{
-				out.mVerts.push_back( jointInner );
-				out.mVerts.push_back( arc[ i ] );
-
-				if ( i + 1 == arc.size() )
+				const ColorVertex* v = mPolyLines.GetVertices();
+				const glm::vec4 wire( 0.0f, 0.0f, 1.0f, 1.0f );
+				for ( int i = 0; i + 2 < mPolyLines.GetVertexCount(); i += 3 )
 				{
-					out.mVerts.push_back( m.T[ 1 ] + m.P[ 1 ] );
-				}
-				else
-				{
-					out.mVerts.push_back( arc[ i + 1 ] );
+					const glm::vec2 a( v[ i ].position[ 0 ], v[ i ].position[ 1 ] );
+					const glm::vec2 b( v[ i + 1 ].position[ 0 ], v[ i + 1 ].position[ 1 ] );
+					const glm::vec2 c( v[ i + 2 ].position[ 0 ], v[ i + 2 ].position[ 1 ] );
+					if ( screenSpace )
+					{
+						DrawLine( a, b, wire );
+						DrawLine( b, c, wire );
+						DrawLine( c, a, wire );
+					}
+					else
+					{
+						DrawWorldLine( a, b, wire );
+						DrawWorldLine( b, c, wire );
+						DrawWorldLine( c, a, wire );
+					}
 				}
 			}
+			return;
 		}
-		else
-		{
-			assert( false );
-		}
-	}
 
-	void Renderer::DrawAnchor( const glm::vec2* P, const glm::vec4& color, float width,
-		PolyLineJoinMode joinMode, float miterLimit )
-	{
-		AnchorMetrics m;
-		m.width = width;
-		m.join = joinMode;
-		m.miterLimit = miterLimit;
-		m.feather = 0.5f;
-		glm::vec4 color2 = glm::vec4( 1.0f, 0.0f, 0.0f, 1.0f );
-		memcpy( &m.P, P, sizeof( glm::vec2 ) * 3 );
-		ComputeAnchorMetrics( m );
-
-		AnchorGeometry geometry;
-		TesselateAnchor( m, geometry, color2 );
-
-		PROCYON_DEBUG( "PolyLine", "DrawPolyLine <%f, %f> <%f, %f> <%f, %f>"
-			, P[ 0 ].x, P[ 0 ].y
-			, P[ 1 ].x, P[ 1 ].y
-			, P[ 2 ].x, P[ 2 ].y );
-
-		//PROCYON_DEBUG( "PolyLine", "T[ 0 ] <%f, %f> T[ 2 ] <%f, %f>", T[ 0 ].x, T[ 0 ].y, T[ 2 ].x, T[ 2 ].y );
-
-		if ( true )
-		{
-			RenderCommand cmd;
-	        cmd.op               = RENDER_OP_POLYGON;
-	        cmd.flags            = RENDER_SCREEN_SPACE;
-	        cmd.colorprimmode    = PRIMITIVE_TRIANGLE;
-	        cmd.colorverts       = (ColorVertex*) geometry.mVerts2.data();
-	        cmd.colorvertcount   = (int)geometry.mVerts2.size();
-	        mRenderCore->AddOrAppendCommand( cmd );
-		}
-		else
-		{
-		    RenderCommand cmd;
-	        cmd.flags			 = RENDER_SCREEN_SPACE;
-			cmd.op 				 = RENDER_OP_PRIMITIVE;
-			cmd.primmode 		 = PRIMITIVE_TRIANGLE;
+		RenderCommand cmd;
+		cmd.op 				= RENDER_OP_POLYLINE;
+		cmd.flags 			= ( screenSpace ) ? RENDER_SCREEN_SPACE : 0;
+		cmd.polypoints 		= NULL;
+		cmd.polypointcount 	= count + 2;
+		cmd.polywidth 		= width;
+		cmd.polyfeather 	= 0.5f;
+		cmd.polymiterlimit 	= miterLimit;
+		cmd.polyjoin 		= joinMode;
+		cmd.polycap 		= capMode;
+		cmd.polycolor[0] 	= color.x;
+		cmd.polycolor[1] 	= color.y;
+		cmd.polycolor[2] 	= color.z;
+		cmd.polycolor[3] 	= color.w;
+
+		// Only the points are streamed, the backend expands them.
+		PolyLinePoint* out = (PolyLinePoint*)mTarget->AppendCommandData( cmd );
+		if ( !out )
+			return;
 
-			const size_t triCount = geometry.mVerts.size() / 3;
-			for ( size_t i = 0; i < triCount; ++i )
+		const PolyLinePoint lineBreak = { POLYLINE_BREAK, POLYLINE_BREAK };
+		*out++ = lineBreak;
+		for ( size_t i = 0; i < points.size(); ++i )
+		{
+			if ( i == 0 || points[ i ] != points[ i - 1 ] )
 			{
-				cmd.verts = (PrimitiveVertex*)&geometry.mVerts[ i * 3 ];
-				cmd.vertcount = 3;
-		        cmd.color[0]  = color.x * (float)(i+1) / (float)triCount;
-		        cmd.color[1]  = color.y * (float)(i+1) / (float)triCount;
-		        cmd.color[2]  = color.z * (float)(i+1) / (float)triCount;
-				cmd.color[3]  = 1.0f;
-			    mRenderCore->AddOrAppendCommand( cmd );
+				const PolyLinePoint point = { points[ i ].x, points[ i ].y };
+				*out++ = point;
 			}
 		}
- 	}
-
-	void Renderer::DrawPolyLine( const std::vector< glm::vec2 >& points, const glm::vec4& color
-		, float width, PolyLineJoinMode joinMode, PolyLineCapMode capMode, float miterLimit /*= 1.0f */ )
-	{
-		if ( points.size() <= 2 )
-		{
-			PROCYON_WARN( "PolyLine", "must provide more than two points to draw DrawPolyLine");
-			return;
-		}
+		*out++ = lineBreak;
 
-		glm::vec2 anchor[3];
-		for ( size_t i = 0; i < points.size() - 2; ++i )
+		if ( sDebugLines )
 		{
-			anchor[ 0 ] = points[ i ];
-			if ( i != 0 )
-			{
-				anchor[ 0 ] += ( points[ i + 1 ] - points[ i ] ) / 2.0f;
-			}
-			anchor[ 1 ] = points[ i + 1 ];
-			anchor[ 2 ] = points[ i + 2 ];
-			if ( i + 3 != points.size() )
+			const glm::vec4 centre( 0.0f, 0.0f, 1.0f, 1.0f );
+			for ( size_t i = 1; i < points.size(); ++i )
 			{
-				anchor[ 2 ] += ( points[ i + 1 ] - points[ i + 2 ] ) / 2.0f;
+				if ( screenSpace )
+					DrawLine( points[ i - 1 ], points[ i ], centre );
+				else
+					DrawWorldLine( points[ i - 1 ], points[ i ], centre );
 			}
-
-			DrawAnchor( anchor, color, width, joinMode, miterLimit );
 		}
 	}
 
@@ -576,7 +401,7 @@ namespace Procyon {
         cmd.color[1]         = color.y;
         cmd.color[2]         = color.z;
         cmd.color[3]         = color.w;
-        mRenderCore->AddOrAppendCommand( cmd );
+        mTarget->AddOrAppendCommand( cmd );
 	}
 
 
@@ -604,8 +429,7 @@ namespace Procyon {
         cmd.flags            = 0;
         cmd.texture          = tex;
         cmd.instancecount    = 1;
-        cmd.quaddata         = &quaddata;
-        mRenderCore->AddOrAppendCommand( cmd );
+        mTarget->AddOrAppendQuad( cmd, quaddata );
 	}
 
     void Renderer::DrawFullscreenTexture( const Texture* tex )
@@ -632,8 +456,7 @@ namespace Procyon {
         cmd.flags            = RENDER_SCREEN_SPACE;
         cmd.texture          = tex;
         cmd.instancecount    = 1;
-        cmd.quaddata         = &quaddata;
-        mRenderCore->AddOrAppendCommand( cmd );
+        mTarget->AddOrAppendQuad( cmd, quaddata );
 
     }
 
@@ -661,8 +484,7 @@ namespace Procyon {
 		cmd.flags            = 0;
 		cmd.texture          = NULL;
 		cmd.instancecount    = 1;
-		cmd.quaddata         = &quaddata;
-		mRenderCore->AddOrAppendCommand( cmd );
+		mTarget->AddOrAppendQuad( cmd, quaddata );
 	}
 
 } /* namespace Procyon */
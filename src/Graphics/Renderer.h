@@ -27,6 +27,8 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "ProcyonCommon.h"
 #include "Camera.h"
+#include "RenderCore.h"
+#include "PolyLineTessellator.h"
 
 namespace Procyon {
 
@@ -35,25 +37,13 @@ namespace Procyon {
 	class Texture;
 	class Camera2D;
 	class IWindow;
-
-	enum class PolyLineJoinMode
-	{
-		MITER,
-		BEVEL,
-		ROUND,
-	};
-
-	enum class PolyLineCapMode
-	{
-		BUTT,
-		ROUND,
-		SQUARE,
-	};
+	class RecordedFrame;
+	class FrameRecorder;
 
 	class Renderer
 	{
 	public:
-	   						Renderer( IWindow* window );
+	   						Renderer( IWindow* window, RenderCoreType coreType = RENDER_CORE_DEFAULT );
 	   						~Renderer();
 
 		const Camera2D& 	PushCamera();
@@ -70,29 +60,51 @@ namespace Procyon {
         void                DrawWireframeRect( const Rect& rect, const glm::vec4& color, bool screenSpace );
 		void 				DrawLine( const glm::vec2& start, const glm::vec2& end, const glm::vec4& color );
 		void 				DrawAALine( const glm::vec2& start, const glm::vec2& end, float width, float feather, const glm::vec4& color );
-		void 				DrawAnchor( const glm::vec2* points, const glm::vec4& color, float width, PolyLineJoinMode joinMode, float miterLimit );
 		void 				DrawPolyLine( const std::vector< glm::vec2 >& points, const glm::vec4& color
-								, float width, PolyLineJoinMode joinMode, PolyLineCapMode capMode, float miterLimit = 1.0f );
+								, float width, PolyLineJoinMode joinMode, PolyLineCapMode capMode, float miterLimit = 4.0f
+								, bool screenSpace = true );
 		void				DrawWorldLine( const glm::vec2& start, const glm::vec2& end, const glm::vec4& color );
 		void 				DrawTexture( const Texture* tex, const glm::vec2& pos, const glm::vec2& dim, float orient, Rect textureRect = Rect() );
         void                DrawFullscreenTexture( const Texture* tex );
 		void 				DrawRectShape( const glm::vec2& pos, const glm::vec2& dim, float orient, const glm::vec4& color );
 		void 				EndRender();
 
+		// Record everything drawn until EndRecording() into frame instead of
+		// drawing it. GetRenderCore() returns the recorder in between, so draw
+		// code is unchanged as long as it makes no graphics API calls itself.
+		void 				BeginRecording( RecordedFrame* frame );
+		void 				EndRecording();
 
+		// Clear, draw a recorded frame and present it. Only touches the render
+		// core, not the camera stack or recorder, so it may run on the render
+		// thread while the next frame is recorded on another.
+		void 				Playback( const RecordedFrame& frame );
+
+		// The core draw calls go to, the recorder while recording.
 		const RenderCore* 	GetRenderCore() const;
 		RenderCore* 		GetRenderCore();
+		bool 				IsHeadless() const;
 
    	protected:
 		void 				Flush();
+		void 				Present();
 
 		std::stack< Camera2D > 	mCameras;
 		IWindow* 				mWindow;
 		glm::vec4				mClearColor;
+		RenderCoreType 			mCoreType;
 		RenderCore* 			mRenderCore;
+		RenderCore* 			mTarget; 	// mRenderCore or mRecorder
+		FrameRecorder* 			mRecorder;
+		PolyLineTessellator 	mPolyLines; 	// scratch for DrawPolyLine()
 	};
 
 	extern bool sDebugLines;
+
+	// DrawPolyLine() streams points for the backend to expand on the GPU
+	// instead of tessellating on the CPU. Off until the shader has been
+	// verified on every supported GL driver.
+	extern bool sGpuPolyLines;
 } /* namespace Procyon */
 
 #endif /* _RENDERER_H */
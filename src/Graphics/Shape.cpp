@@ -81,8 +81,7 @@ namespace Procyon {
         cmd.flags            = RENDER_SCREEN_SPACE;
         cmd.texture          = NULL;
         cmd.instancecount    = 1;
-        cmd.quaddata         = &quaddata;
-        rc->AddOrAppendCommand( cmd );
+        rc->AddOrAppendQuad( cmd, quaddata );
 	}
 
 } /* namespace Procyon */
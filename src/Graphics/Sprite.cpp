@@ -24,6 +24,7 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "Sprite.h"
 #include "Texture.h"
+#include "TextureAtlas.h"
 #include "Renderer.h"
 #include "RenderCore.h"
 
@@ -32,12 +33,14 @@ namespace Procyon {
 	Sprite::Sprite()
 		: mTexture( NULL )
 		, mTextureRect( glm::ivec2( 0 ), glm::ivec2( 1 ) )
+		, mTextureOffset( 0 )
 	{
 	}
 
 	Sprite::Sprite( const Texture* tex )
         : mTexture( tex )
 		, mTextureRect( glm::ivec2( 0 ), glm::ivec2( 1 ) )
+		, mTextureOffset( 0 )
 	{
 		if ( mTexture )
 		{
@@ -45,6 +48,13 @@ namespace Procyon {
 		}
 	}
 
+	Sprite::Sprite( const AtlasRegion& region )
+		: mTexture( region.texture )
+		, mTextureRect( glm::ivec2( 0 ), region.rect.GetDimensions() )
+		, mTextureOffset( region.rect.GetTopLeft() )
+	{
+	}
+
     void Sprite::SetTextureRect( const IntRect& texRect )
     {
         mTextureRect = texRect;
@@ -58,6 +68,13 @@ namespace Procyon {
 	void Sprite::SetTexture( const Texture* tex )
 	{
 		mTexture = tex;
+		mTextureOffset = glm::ivec2( 0 );
+	}
+
+	void Sprite::SetTexture( const AtlasRegion& region )
+	{
+		mTexture = region.texture;
+		mTextureOffset = region.rect.GetTopLeft();
 	}
 
     void Sprite::PostRenderCommands( Renderer* r, RenderCore* rc ) const
@@ -68,8 +85,8 @@ namespace Procyon {
         quaddata.size[0]     = mScale.x * mTextureRect.GetWidth();
         quaddata.size[1]     = mScale.y * mTextureRect.GetHeight();
         quaddata.rotation    = mOrientation;
-        quaddata.uvoffset[0] = (float)mTextureRect.GetTopLeft().x;
-        quaddata.uvoffset[1] = (float)mTextureRect.GetTopLeft().y;
+        quaddata.uvoffset[0] = (float)( mTextureOffset.x + mTextureRect.GetTopLeft().x );
+        quaddata.uvoffset[1] = (float)( mTextureOffset.y + mTextureRect.GetTopLeft().y );
         quaddata.uvsize[0]   = (float)mTextureRect.GetWidth();
         quaddata.uvsize[1]   = (float)mTextureRect.GetHeight();
         quaddata.color[0]    = 1.0f;
@@ -84,8 +101,7 @@ namespace Procyon {
         cmd.flags            = 0;
         cmd.texture          = mTexture;
         cmd.instancecount    = 1;
-        cmd.quaddata         = &quaddata;
-        rc->AddOrAppendCommand( cmd );
+        rc->AddOrAppendQuad( cmd, quaddata );
     }
 
 } /* namespace Procyon */
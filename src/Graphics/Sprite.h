@@ -32,21 +32,27 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 namespace Procyon {
 
 	class Texture;
+	struct AtlasRegion;
 
 	class Sprite : public Transformable, public Renderable
 	{
 	public:
 							Sprite();
 	    					Sprite( const Texture* tex );
+	    					Sprite( const AtlasRegion& region );
 
+		// Relative to the image the sprite was created from, atlas
+		// regions are offset into their page transparently.
    		void 				SetTextureRect( const IntRect& texRect );
     	const IntRect&  	GetTextureRect() const;
 		void				SetTexture( const Texture* tex );
+		void				SetTexture( const AtlasRegion& region );
 
     	virtual void 		PostRenderCommands( Renderer* r, RenderCore* rc ) const;
 	protected:
 	    const Texture*		mTexture;
 	    IntRect 			mTextureRect;
+	    glm::ivec2 			mTextureOffset; // region offset within mTexture
 	};
 
 } /* namespace Procyon */
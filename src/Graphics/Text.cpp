@@ -34,6 +34,9 @@ namespace Procyon {
 	Text::Text( const std::string& text, const FontFace* font, unsigned int fontsize /*= 32*/ )
 		: mFont( font )
 		, mFontSize( fontsize )
+		, mTexture( NULL )
+		, mPlacedOrientation( 0.0f )
+		, mPlacementDirty( true )
 	{
 		mFont->EnsureCached( mFontSize );
 		SetText( text );
@@ -42,8 +45,12 @@ namespace Procyon {
 	Text::Text( const FontFace* font, unsigned int fontsize /*= 32*/ )
 		: mFont( font )
 		, mFontSize( fontsize )
+		, mTexture( NULL )
+		, mPlacedOrientation( 0.0f )
+		, mPlacementDirty( true )
 	{
 		mFont->EnsureCached( mFontSize );
+		Layout();
 	}
 
 	Text::~Text()
@@ -58,7 +65,7 @@ namespace Procyon {
 	void Text::SetText( const std::string& str )
 	{
 		mText = str;
-		RecalculateDimensions();
+		Layout();
 	}
 
 	void Text::SetText( const char* format, ... )
@@ -69,19 +76,19 @@ namespace Procyon {
 		vsnprintf( dest, 1024, format, argptr );
 		va_end( argptr );
 		mText = dest;
-		RecalculateDimensions();
+		Layout();
 	}
 
 	void Text::Append( const std::string& str )
 	{
 		mText.append( str );
-		RecalculateDimensions();
+		Layout();
 	}
 
 	void Text::EraseBack( size_t count /* = 1 */ )
 	{
 		mText.erase( mText.end() - glm::min( mText.size(), (size_t)count ), mText.end() );
-		RecalculateDimensions();
+		Layout();
 	}
 
 	size_t Text::CharacterCount() const
@@ -99,12 +106,21 @@ namespace Procyon {
 	{
 		mFont = font;
 		mFont->EnsureCached( mFontSize );
-		RecalculateDimensions();
+		Layout();
 	}
 
 	void Text::SetColor( const glm::vec4& color )
 	{
 		mColor = color;
+
+		// Nothing moves, no need to lay out again.
+		for ( BatchedQuad& quad : mQuads )
+		{
+			quad.color[0] = color.x;
+			quad.color[1] = color.y;
+			quad.color[2] = color.z;
+			quad.color[3] = color.w;
+		}
 	}
 
 	const glm::vec4& Text::GetColor() const
@@ -116,7 +132,7 @@ namespace Procyon {
 	{
 		mFontSize = fontsize;
 		mFont->EnsureCached( fontsize );
-		RecalculateDimensions();
+		Layout();
 	}
 
 	unsigned int Text::GetFontSize() const
@@ -124,10 +140,13 @@ namespace Procyon {
 		return mFontSize;
 	}
 
-	void Text::RecalculateDimensions()
+	void Text::Layout()
 	{
         const FontMetrics metrics = mFont->GetMetrics( mFontSize );
 		mDims = glm::vec2( 0.0f, metrics.line_height );
+		mTexture = mFont->GetTexture( mFontSize );
+		mGlyphOffsets.clear();
+		mQuads.clear();
 
 		glm::vec2 		pen;
 		unsigned int 	prev = 0;
@@ -148,6 +167,7 @@ namespace Procyon {
     			{
     				// do something with tabs?
     			}
+    			//TODO: Spaces are handled as quads... probably wrong.
 
                 const Glyph* g = mFont->GetGlyph( mFontSize, c );
 
@@ -161,6 +181,21 @@ namespace Procyon {
                 	pen.x += mFont->GetKerning( mFontSize, prev, c );
                 }
 
+                mGlyphOffsets.push_back( pen + glm::vec2( 0.0f, -metrics.descender ) + g->center );
+
+    	        BatchedQuad quaddata;
+    	        quaddata.size[0]     = g->size.x;
+    	        quaddata.size[1]     = g->size.y;
+    	        quaddata.uvoffset[0] = (float)g->atlas_offset.s;
+    	        quaddata.uvoffset[1] = (float)g->atlas_offset.t;
+    	        quaddata.uvsize[0]   = (float)g->atlas_size.s;
+    	        quaddata.uvsize[1]   = (float)g->atlas_size.t;
+    	        quaddata.color[0] 	 = mColor.x;
+    	        quaddata.color[1] 	 = mColor.y;
+    	        quaddata.color[2] 	 = mColor.z;
+    			quaddata.color[3] 	 = mColor.w;
+    			mQuads.push_back( quaddata );
+
                 pen.x += g->advance;
                 prev = c;
 
@@ -171,6 +206,30 @@ namespace Procyon {
         {
             mDims.x = 5.0f;
         }
+
+        mPlacementDirty = true;
+        PlaceQuads();
+	}
+
+	void Text::PlaceQuads() const
+	{
+		if ( !mPlacementDirty && mPlacedPosition == mPosition && mPlacedOrigin == mOrigin && mPlacedOrientation == mOrientation )
+			return;
+
+		for ( size_t i = 0; i < mQuads.size(); ++i )
+		{
+			BatchedQuad& quaddata = mQuads[ i ];
+	        quaddata.position[0] = mPosition.x + mGlyphOffsets[ i ].x;
+	        quaddata.position[1] = mPosition.y + mGlyphOffsets[ i ].y;
+	        quaddata.rotation    = mOrientation;
+			quaddata.origin[0]	 = mOrigin.x;
+			quaddata.origin[1]	 = mOrigin.y;
+		}
+
+		mPlacedPosition = mPosition;
+		mPlacedOrigin = mOrigin;
+		mPlacedOrientation = mOrientation;
+		mPlacementDirty = false;
 	}
 
 	const glm::vec2	Text::GetTextDimensions() const
@@ -190,68 +249,19 @@ namespace Procyon {
             r->DrawWireframeRect( Rect( mPosition + glm::vec2(0.0f, 0.5f), glm::vec2( mDims.x, -mDims.y ) ), glm::vec4( 1.0f, 0.0f, 0.0f, 1.0f ), true );
         }
 
-		float x = 0.0f;
-		float y = (float)-metrics.descender;
+		if ( mQuads.empty() )
+			return;
 
-		unsigned int prev = 0;
+		// Static text costs a single copy of the cached quads.
+		PlaceQuads();
 
-		// Assumed ascii for now.
-		for( auto c : mText )
-		{
-			if ( c == '\n')
-			{
-				x = 0.0f;
-				y += mFont->GetMetrics( mFontSize ).line_height;
-				prev = 0;
-				continue;
-			}
-			else if ( c == '\t' )
-			{
-				// do something with tabs?
-			}
-			//TODO: Spaces are handled as quads... probably wrong.
-
-            const Glyph* g = mFont->GetGlyph( mFontSize, c );
-
-            if ( !g )
-            {
-            	continue; // unsupported character
-            }
-
-            if ( prev )
-            {
-            	x += mFont->GetKerning( mFontSize, prev, c );
-            }
-
-            BatchedQuad quaddata;
-	        quaddata.position[0] = mPosition.x + x + g->center.x;
-	        quaddata.position[1] = mPosition.y + y + g->center.y;
-	        quaddata.size[0]     = g->size.x;
-	        quaddata.size[1]     = g->size.y;
-	        quaddata.rotation    = mOrientation;
-	        quaddata.uvoffset[0] = (float)g->atlas_offset.s;
-	        quaddata.uvoffset[1] = (float)g->atlas_offset.t;
-	        quaddata.uvsize[0]   = (float)g->atlas_size.s;
-	        quaddata.uvsize[1]   = (float)g->atlas_size.t;
-	        quaddata.color[0] 	 = mColor.x;
-	        quaddata.color[1] 	 = mColor.y;
-	        quaddata.color[2] 	 = mColor.z;
-			quaddata.color[3] 	 = mColor.w;
-			quaddata.origin[0]	 = mOrigin.x;
-			quaddata.origin[1]	 = mOrigin.y;
-
-	        RenderCommand cmd;
-	        cmd.op               = RENDER_OP_QUAD;
-	        cmd.texture          = mFont->GetTexture( mFontSize );
-	        cmd.instancecount    = 1;
-	        cmd.quaddata         = &quaddata;
-	        cmd.flags 		 	 = RENDER_SCREEN_SPACE;
-	        rc->AddOrAppendCommand( cmd );
-
-            x += g->advance;
-
-            prev = c;
-		}
+        RenderCommand cmd;
+        cmd.op               = RENDER_OP_QUAD;
+        cmd.quaddata         = mQuads.data();
+        cmd.texture          = mTexture;
+        cmd.instancecount    = (int)mQuads.size();
+        cmd.flags 		 	 = RENDER_SCREEN_SPACE;
+        rc->AddOrAppendCommand( cmd );
 	}
 
 } /* namespace Procyon */
@@ -28,10 +28,12 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 #include "ProcyonCommon.h"
 #include "Transformable.h"
 #include "Renderable.h"
+#include "RenderCore.h"
 
 namespace Procyon {
 
 	class FontFace;
+	class Texture;
 
 	class Text : public Transformable, public Renderable
 	{
@@ -62,13 +64,28 @@ namespace Procyon {
 		virtual void 		PostRenderCommands( Renderer* r, RenderCore* rc ) const;
 
 	protected:
-		void				RecalculateDimensions();
+		// Walk the text once into mQuads and mDims. Needed after a change to
+		// the text, font or size.
+		void				Layout();
+
+		// Move mQuads to the current transform if it changed since.
+		void 				PlaceQuads() const;
 
 		const FontFace* 	mFont;
 		std::string 		mText;
 		glm::vec4			mColor;
 		unsigned int 		mFontSize;
 		glm::vec2 			mDims;
+
+		// The laid out glyphs, submitted as one command. mGlyphOffsets are
+		// their positions relative to the text's.
+		const Texture* 							mTexture;
+		std::vector< glm::vec2 > 				mGlyphOffsets;
+		mutable std::vector< BatchedQuad > 		mQuads;
+		mutable glm::vec2 						mPlacedPosition;
+		mutable glm::vec2 						mPlacedOrigin;
+		mutable float 							mPlacedOrientation;
+		mutable bool 							mPlacementDirty; 	// mQuads were rebuilt since
 	};
 
     extern bool sDebugText;
@@ -59,6 +59,11 @@ namespace Procyon {
 		static Texture* Allocate( const std::string& filepath, int mipLevel = 0 );
 		static Texture* Allocate( const IImage& img, int mipLevel = 0 );
 
+		// Copies img and leaves the upload to the first Bind(), so unlike
+		// Allocate() it is safe off the render thread. Filters and mipmaps
+		// requested before then are applied with the upload.
+		static Texture* AllocateDeferred( const IImage& img );
+
 	protected:
 		glm::ivec2 	mDimensions;
 	};
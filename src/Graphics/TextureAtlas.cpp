@@ -0,0 +1,206 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "TextureAtlas.h"
+#include "Texture.h"
+#include "Image.h"
+
+#include "stb_rect_pack.h"
+
+#define ATLAS_REGION_PADDING 1 // texels of extruded border around each region
+
+namespace Procyon {
+
+	TextureAtlas::TextureAtlas( int pageWidth /* = 2048 */, int pageHeight /* = 2048 */ )
+		: mPageDims( pageWidth, pageHeight )
+	{
+	}
+
+	TextureAtlas::~TextureAtlas()
+	{
+		for ( MutableImage* img : mImages )
+			delete img;
+
+		for ( Texture* page : mPages )
+			delete page;
+	}
+
+	TextureAtlas::RegionId TextureAtlas::Add( const IImage& img )
+	{
+		// Expand to RGBA here, MutableImage( img, 4 ) would leave RGB images
+		// with a zero alpha.
+		const int width 		= img.GetWidth();
+		const int height 		= img.GetHeight();
+		const int components 	= img.Components();
+		MutableImage* rgba 		= new MutableImage( width, height, 4 );
+
+		const unsigned char* in = img.Data();
+		unsigned char* out 		= rgba->MutableData();
+		for ( int i = 0; i < width * height; i++ )
+		{
+			const unsigned char* texel = &in[ i * components ];
+			if ( components <= 2 )
+			{
+				out[ i * 4 + 0 ] = texel[ 0 ];
+				out[ i * 4 + 1 ] = texel[ 0 ];
+				out[ i * 4 + 2 ] = texel[ 0 ];
+				out[ i * 4 + 3 ] = ( components == 2 ) ? texel[ 1 ] : 255;
+			}
+			else
+			{
+				out[ i * 4 + 0 ] = texel[ 0 ];
+				out[ i * 4 + 1 ] = texel[ 1 ];
+				out[ i * 4 + 2 ] = texel[ 2 ];
+				out[ i * 4 + 3 ] = ( components == 4 ) ? texel[ 3 ] : 255;
+			}
+		}
+
+		mImages.push_back( rgba );
+		mRegions.push_back( AtlasRegion() );
+		return (RegionId)mRegions.size() - 1;
+	}
+
+	TextureAtlas::RegionId TextureAtlas::Add( const std::string& filepath )
+	{
+		FileImage img( filepath );
+		return Add( img );
+	}
+
+	bool TextureAtlas::Build()
+	{
+		std::vector< RegionId > pending;
+		for ( RegionId id = 0; id < (RegionId)mImages.size(); id++ )
+		{
+			const MutableImage* img = mImages[ id ];
+			if ( !img )
+				continue; // built by an earlier call
+
+			glm::ivec2 padded( img->GetWidth() + 2 * ATLAS_REGION_PADDING, img->GetHeight() + 2 * ATLAS_REGION_PADDING );
+			if ( padded.x > mPageDims.x || padded.y > mPageDims.y )
+			{
+				PROCYON_WARN( "TextureAtlas", "Image %ix%i does not fit a %ix%i page, giving it its own page."
+					, img->GetWidth(), img->GetHeight(), mPageDims.x, mPageDims.y );
+
+				std::vector< RegionId > single( 1, id );
+				if ( !PackPage( single, padded ) )
+					return false;
+				continue;
+			}
+
+			pending.push_back( id );
+		}
+
+		while ( !pending.empty() )
+		{
+			if ( !PackPage( pending, mPageDims ) )
+				return false;
+		}
+
+		PROCYON_DEBUG( "TextureAtlas", "Built %i regions into %i pages.", (int)mRegions.size(), (int)mPages.size() );
+		return true;
+	}
+
+	bool TextureAtlas::PackPage( std::vector< RegionId >& pending, glm::ivec2 dims )
+	{
+		std::vector< stbrp_node > nodes( dims.x );
+		stbrp_context context;
+		stbrp_init_target( &context, dims.x, dims.y, &nodes[ 0 ], (int)nodes.size() );
+
+		std::vector< stbrp_rect > rects( pending.size() );
+		for ( size_t i = 0; i < pending.size(); i++ )
+		{
+			const MutableImage* img = mImages[ pending[ i ] ];
+			rects[ i ].id 			= pending[ i ];
+			rects[ i ].w 			= img->GetWidth() + 2 * ATLAS_REGION_PADDING;
+			rects[ i ].h 			= img->GetHeight() + 2 * ATLAS_REGION_PADDING;
+			rects[ i ].x 			= 0;
+			rects[ i ].y 			= 0;
+			rects[ i ].was_packed 	= 0;
+		}
+
+		stbrp_pack_rects( &context, &rects[ 0 ], (int)rects.size() );
+
+		MutableImage page( dims.x, dims.y, 4 );
+		std::vector< RegionId > packed;
+		pending.clear();
+		for ( const stbrp_rect& r : rects )
+		{
+			if ( !r.was_packed )
+			{
+				pending.push_back( r.id ); // retry on the next page
+				continue;
+			}
+
+			MutableImage* img = mImages[ r.id ];
+			IntRect rect( r.x + ATLAS_REGION_PADDING, r.y + ATLAS_REGION_PADDING, img->GetWidth(), img->GetHeight() );
+			Blit( page, *img, rect );
+			mRegions[ r.id ].rect = rect;
+			packed.push_back( r.id );
+
+			delete img;
+			mImages[ r.id ] = NULL;
+		}
+
+		if ( packed.empty() )
+		{
+			PROCYON_ERROR( "TextureAtlas", "Unable to pack any of %i images into a %ix%i page."
+				, (int)pending.size(), dims.x, dims.y );
+			return false;
+		}
+
+		Texture* texture = Texture::Allocate( page );
+		for ( RegionId id : packed )
+			mRegions[ id ].texture = texture;
+		mPages.push_back( texture );
+		return true;
+	}
+
+	void TextureAtlas::Blit( MutableImage& page, const MutableImage& img, const IntRect& rect )
+	{
+		unsigned char* dst 			= page.MutableData();
+		const unsigned char* src 	= img.Data();
+		const int pageWidth 		= page.GetWidth();
+		const int width 			= img.GetWidth();
+		const int height 			= img.GetHeight();
+
+		// Copy the padding too, clamping the source to extrude the edge texels.
+		for ( int y = -ATLAS_REGION_PADDING; y < height + ATLAS_REGION_PADDING; y++ )
+		{
+			const int srcY = glm::clamp( y, 0, height - 1 );
+			for ( int x = -ATLAS_REGION_PADDING; x < width + ATLAS_REGION_PADDING; x++ )
+			{
+				const int srcX = glm::clamp( x, 0, width - 1 );
+				const int dstIdx = ( ( rect.topleft.y + y ) * pageWidth + rect.topleft.x + x ) * 4;
+				memcpy( &dst[ dstIdx ], &src[ ( srcY * width + srcX ) * 4 ], 4 );
+			}
+		}
+	}
+
+	const AtlasRegion& TextureAtlas::GetRegion( RegionId id ) const
+	{
+		assert( id >= 0 && id < (RegionId)mRegions.size() );
+		return mRegions[ id ];
+	}
+
+} /* namespace Procyon */
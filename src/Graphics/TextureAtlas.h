@@ -0,0 +1,97 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _TEXTURE_ATLAS_H
+#define _TEXTURE_ATLAS_H
+
+#include "ProcyonCommon.h"
+
+namespace Procyon {
+
+	class Texture;
+	class IImage;
+	class MutableImage;
+
+	/*
+	================
+	AtlasRegion
+
+	Where an image ended up after TextureAtlas::Build(). The rect is in
+	texels of the page texture, which is what the quad UVs are expressed in.
+	================
+	*/
+	struct AtlasRegion
+	{
+		AtlasRegion()
+			: texture( NULL )
+		{
+		}
+
+		const Texture* 	texture;
+		IntRect 		rect;
+	};
+
+	/*
+	================
+	TextureAtlas
+
+	Packs many small images into a few shared page textures so sprites drawn
+	from different images still land in the same quad batch. Add() every
+	image, then Build() once. Images larger than a page get a page of their
+	own. Regions are padded and their edges extruded so filtering never
+	samples a neighbour.
+	================
+	*/
+	class TextureAtlas
+	{
+	public:
+		typedef int RegionId;
+
+								TextureAtlas( int pageWidth = 2048, int pageHeight = 2048 );
+								~TextureAtlas();
+
+		RegionId 				Add( const IImage& img );
+		RegionId 				Add( const std::string& filepath );
+
+		// Packs and uploads all images added so far. Regions are only valid
+		// after this returns.
+		bool 					Build();
+
+		const AtlasRegion& 		GetRegion( RegionId id ) const;
+		int 					GetPageCount() const { return (int)mPages.size(); }
+		const Texture* 			GetPage( int page ) const { return mPages[ page ]; }
+
+	protected:
+		bool 					PackPage( std::vector< RegionId >& pending, glm::ivec2 dims );
+		void 					Blit( MutableImage& page, const MutableImage& img, const IntRect& rect );
+
+		glm::ivec2 						mPageDims;
+		std::vector< MutableImage* > 	mImages; 	// owned until Build()
+		std::vector< AtlasRegion > 		mRegions;
+		std::vector< Texture* > 		mPages;
+	};
+
+} /* namespace Procyon */
+
+#endif /* _TEXTURE_ATLAS_H */
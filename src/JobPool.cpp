@@ -0,0 +1,121 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "JobPool.h"
+
+namespace Procyon {
+
+	JobPool::JobPool( unsigned workers /* = 0 */ )
+		: mShutdown( false )
+	{
+		if ( workers == 0 )
+		{
+			const unsigned hardware = std::thread::hardware_concurrency();
+			workers = ( hardware > 1 ) ? hardware - 1 : 1;
+		}
+
+		mWorkers.reserve( workers );
+		for ( unsigned i = 0; i < workers; i++ )
+		{
+			mWorkers.push_back( std::thread( &JobPool::WorkerMain, this ) );
+		}
+	}
+
+	JobPool::~JobPool()
+	{
+		{
+			std::lock_guard< std::mutex > lock( mMutex );
+			mShutdown = true;
+		}
+		mJobPushed.notify_all();
+
+		for ( std::thread& worker : mWorkers )
+		{
+			worker.join();
+		}
+	}
+
+	void JobPool::Push( const std::function< void() >& job, JobCounter* counter /* = NULL */ )
+	{
+		{
+			std::lock_guard< std::mutex > lock( mMutex );
+			if ( counter )
+			{
+				counter->mPending++;
+			}
+
+			Job queued;
+			queued.run = job;
+			queued.counter = counter;
+			mQueue.push_back( queued );
+		}
+		mJobPushed.notify_one();
+	}
+
+	void JobPool::Wait( JobCounter& counter )
+	{
+		std::unique_lock< std::mutex > lock( mMutex );
+		while ( counter.mPending > 0 )
+		{
+			if ( !mQueue.empty() )
+			{
+				RunFront( lock );
+			}
+			else
+			{
+				mJobDone.wait( lock );
+			}
+		}
+	}
+
+	void JobPool::WorkerMain()
+	{
+		std::unique_lock< std::mutex > lock( mMutex );
+		for ( ;; )
+		{
+			mJobPushed.wait( lock, [ this ]() { return mShutdown || !mQueue.empty(); } );
+			if ( mQueue.empty() )
+				return; // shutting down, and nothing left to run
+
+			RunFront( lock );
+		}
+	}
+
+	void JobPool::RunFront( std::unique_lock< std::mutex >& lock )
+	{
+		Job job = std::move( mQueue.front() );
+		mQueue.pop_front();
+
+		lock.unlock();
+		job.run();
+		lock.lock();
+
+		if ( job.counter )
+		{
+			job.counter->mPending--;
+		}
+		mJobDone.notify_all();
+	}
+
+} /* namespace Procyon */
@@ -0,0 +1,107 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _JOB_POOL_H
+#define _JOB_POOL_H
+
+#include "ProcyonCommon.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace Procyon {
+
+	/*
+	================
+	JobCounter
+
+	Counts the unfinished jobs pushed with it, see JobPool::Wait(). Only
+	touched under the pool's lock.
+	================
+	*/
+	class JobCounter
+	{
+	public:
+						JobCounter() : mPending( 0 ) { }
+
+	private:
+		friend class JobPool;
+
+		int 			mPending;
+	};
+
+	/*
+	================
+	JobPool
+
+	A fixed set of worker threads started once and fed jobs from a single
+	queue, so handing work off costs a lock and a wakeup rather than a new
+	thread. Jobs run in push order but finish in any order.
+	================
+	*/
+	class JobPool
+	{
+	public:
+		// 0 workers picks one less than the hardware threads, at least one.
+		explicit 			JobPool( unsigned workers = 0 );
+							~JobPool();
+
+		// Queue job, counted by counter until it returns if one is given.
+		void 				Push( const std::function< void() >& job, JobCounter* counter = NULL );
+
+		// Block until every job counted by counter has run. Queued jobs are
+		// run on the calling thread meanwhile, so a job may wait on jobs it
+		// pushed itself without starving the pool.
+		void 				Wait( JobCounter& counter );
+
+		unsigned 			GetWorkerCount() const { return (unsigned)mWorkers.size(); }
+
+	private:
+		struct Job
+		{
+			std::function< void() > 	run;
+			JobCounter* 				counter;
+		};
+
+							JobPool( const JobPool& ) = delete;
+		JobPool& 			operator=( const JobPool& ) = delete;
+
+		void 				WorkerMain();
+
+		// Run the front of the queue with lock released around the job.
+		void 				RunFront( std::unique_lock< std::mutex >& lock );
+
+		std::vector< std::thread > 	mWorkers;
+		std::deque< Job > 			mQueue;
+		std::mutex 					mMutex;
+		std::condition_variable 	mJobPushed; 	// or shutting down
+		std::condition_variable 	mJobDone;
+		bool 						mShutdown;
+	};
+
+} /* namespace Procyon */
+
+#endif /* _JOB_POOL_H */
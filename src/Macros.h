@@ -28,4 +28,7 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 
 #define BIT( bit ) (0x01<<bit)
 
+// Pointer doesn't alias any other in scope (MSVC, GCC and Clang spelling)
+#define RESTRICT __restrict
+
 #endif /* _MACROS_H */
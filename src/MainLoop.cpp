@@ -37,17 +37,21 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 
 namespace Procyon {
 
+    // Monotonic, and not rounded to the millisecond.
     static double Now()
     {
         typedef std::chrono::steady_clock Clock;
-        typedef std::chrono::milliseconds Ms;
-        return std::chrono::time_point_cast<Ms>( Clock::now() )
-            .time_since_epoch().count() / 1000.0;
+        return std::chrono::duration< double >( Clock::now().time_since_epoch() ).count();
     }
 
 	MainLoop::MainLoop( const std::string& windowTitle, unsigned width, unsigned height )
         : mAvgFPS( (double)TARGET_FPS )
 		, mFrame( 0 )
+		, mTimestepMode( TIMESTEP_VARIABLE )
+		, mFramePacing( FRAME_PACING_SLEEP )
+		, mAccumulator( 0.0 )
+		, mPipelined( false )
+		, mPlaybackFrame( -1 )
 	{
         Platform::Init();
 
@@ -164,11 +168,12 @@ namespace Procyon {
 
 	void MainLoop::Run()
 	{
-		float prevFrameStart = 0.0f;
+		double prevFrameStart = 0.0;
+		double nextFrame = SecsSinceLaunch();
         while ( mWindow->IsOpen() )
         {
-			float frameStart = (float)SecsSinceLaunch();
-			float frameDelta = 0.0f;
+			const double frameStart = SecsSinceLaunch();
+			double frameDelta = 0.0;
 			if ( mFrame != 0 )
 			{
 				frameDelta = frameStart - prevFrameStart;
@@ -180,37 +185,142 @@ namespace Procyon {
 
             Frame( frameDelta );
 
-			// Framerate limit
-			float processDelta = (float)SecsSinceLaunch() - frameStart;
-			if ( processDelta < TARGET_HZ )
+			// Framerate limit. Deadlines advance by whole frames so waking
+			// late once doesn't shift every frame after it.
+			nextFrame += TARGET_HZ;
+			const double now = SecsSinceLaunch();
+			if ( nextFrame < now - TARGET_HZ )
 			{
-				int sleepmicros = (int)( ( TARGET_HZ - processDelta ) * 1.0e6 );
-				PROCYON_DEBUG( "MainLoop", "Sleeping for %i", sleepmicros );
-				std::this_thread::sleep_for( std::chrono::microseconds( sleepmicros ) );
+				nextFrame = now; // fell behind, don't try to catch up
 			}
-
+			WaitUntil( nextFrame );
         }
 	}
 
-	void MainLoop::Frame( float dt )
+	void MainLoop::WaitUntil( double secsSinceLaunch ) const
 	{
-		if ( mFrame != 0 )
+		if ( mFramePacing == FRAME_PACING_NONE )
+			return;
+
+		// Sleep granularity is up to the OS, so the hybrid pacing wakes early
+		// and spins the remainder.
+		const double margin = ( mFramePacing == FRAME_PACING_HYBRID ) ? FRAME_SPIN_SECONDS : 0.0;
+		const double sleepSecs = secsSinceLaunch - margin - SecsSinceLaunch();
+		if ( sleepSecs > 0.0 )
 		{
-			mSimTime.dt = glm::clamp( dt, 0.0f, MAX_DT );
-			mSimTime.tsl += mSimTime.dt;
+			std::this_thread::sleep_for( std::chrono::duration< double >( sleepSecs ) );
 		}
 
-		mWindow->PollEvents();
-		Keyboard::Poll( mWindow->HasFocus() );
-		Mouse::Poll( mWindow->HasFocus() );
+		if ( mFramePacing == FRAME_PACING_HYBRID )
+		{
+			while ( SecsSinceLaunch() < secsSinceLaunch )
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void MainLoop::SetPipelined( bool pipelined )
+	{
+		// e.g. World keeps its chunk buffers in the core it first drew with,
+		// and would free the GL ones from the worker when that changed.
+		assert( mFrame == 0 );
+		mPipelined = pipelined;
+	}
+
+	void MainLoop::Tick( float dt )
+	{
+		mSimTime.dt = dt;
+		mSimTime.tsl += dt;
+
+		if ( !mPipelined )
+		{
+			Keyboard::Poll( mWindow->HasFocus() );
+			Mouse::Poll( mWindow->HasFocus() );
+		}
 
 		Console_Process( mSimTime );
 		Process( mSimTime );
 
-		mRenderer->BeginRender();
-			Render();
+		if ( mPipelined )
+		{
+			// Only the first tick after Frame() sampled sees the edges, and a
+			// frame without ticks leaves them for the next one.
+			Keyboard::ConsumeEdges();
+			Mouse::ConsumeEdges();
+		}
+	}
+
+	float MainLoop::Simulate( double dt )
+	{
+		if ( mTimestepMode == TIMESTEP_VARIABLE )
+		{
+			Tick( ( mFrame != 0 ) ? glm::clamp( (float)dt, 0.0f, MAX_DT ) : 0.0f );
+			return 1.0f;
+		}
+
+		mAccumulator += glm::min( dt, MAX_FRAME_TIME );
+
+		// Input is polled per tick so key presses fire once.
+		int ticks = 0;
+		while ( mAccumulator >= TARGET_HZ && ticks < MAX_TICKS_PER_FRAME )
+		{
+			Tick( (float)TARGET_HZ );
+			mAccumulator -= TARGET_HZ;
+			ticks++;
+		}
+
+		if ( mAccumulator >= TARGET_HZ )
+		{
+			// Can't keep up, run slow rather than spiral.
+			mAccumulator = fmod( mAccumulator, TARGET_HZ );
+		}
+		return (float)( mAccumulator / TARGET_HZ );
+	}
+
+	void MainLoop::Frame( double dt )
+	{
+		mWindow->PollEvents();
+
+		if ( !mPipelined )
+		{
+			mPlaybackFrame = -1;
+
+			const float alpha = Simulate( dt );
+			mRenderer->BeginRender();
+				Render( alpha );
+				Console_Render( mRenderer );
+			mRenderer->EndRender();
+
+			mFrame++;
+			return;
+		}
+
+		// Event callbacks and input sampling stay on this thread, the worker
+		// only ever sees the state left by them. Edges are consumed per tick
+		// in Tick().
+		Keyboard::Sample( mWindow->HasFocus() );
+		Mouse::Sample( mWindow->HasFocus() );
+
+		const int record = ( mPlaybackFrame == 0 ) ? 1 : 0;
+		mRenderer->BeginRecording( &mFrames[ record ] );
+
+		JobCounter recorded;
+		mJobs.Push( [ this, dt ]()
+		{
+			const float alpha = Simulate( dt );
+			Render( alpha );
 			Console_Render( mRenderer );
-		mRenderer->EndRender();
+		}, &recorded );
+
+		if ( mPlaybackFrame >= 0 )
+		{
+			mRenderer->Playback( mFrames[ mPlaybackFrame ] );
+		}
+
+		mJobs.Wait( recorded );
+		mRenderer->EndRecording();
+		mPlaybackFrame = record;
 
 		mFrame++;
 	}
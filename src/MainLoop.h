@@ -27,16 +27,56 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "ProcyonCommon.h"
 #include "Platform/Window.h"
+#include "Graphics/RecordedFrame.h"
+#include "JobPool.h"
 
 #define TARGET_FPS 60
 #define TARGET_HZ ( 1.0 / (double)TARGET_FPS )
 #define MAX_DT ( 1.0f / 20.0f )
 
+// TIMESTEP_FIXED: ticks run before rendering regardless, and frame time
+// past MAX_FRAME_TIME is dropped, so a stall can't snowball.
+#define MAX_TICKS_PER_FRAME 5
+#define MAX_FRAME_TIME 0.25
+
+// FRAME_PACING_HYBRID spins this close to the deadline instead of sleeping
+#define FRAME_SPIN_SECONDS 0.002
+
 namespace Procyon {
 
 	class Renderer;
 	class AudioDevice;
 
+	/*
+	================
+	TimestepMode
+
+	TIMESTEP_VARIABLE calls Process() once per frame with the frame's clamped
+	delta. TIMESTEP_FIXED calls it zero or more times per frame with dt of
+	exactly TARGET_HZ, then Render() with how far the remainder is into the
+	next tick, for interpolating between the last two ticks.
+	================
+	*/
+	enum TimestepMode
+	{
+		TIMESTEP_VARIABLE,
+		TIMESTEP_FIXED
+	};
+
+	/*
+	================
+	FramePacing
+
+	How MainLoop waits out the rest of each TARGET_HZ frame.
+	================
+	*/
+	enum FramePacing
+	{
+		FRAME_PACING_NONE, 		// don't wait, e.g. when vsync paces
+		FRAME_PACING_SLEEP, 	// sleep, cheap but can oversleep by the OS tick
+		FRAME_PACING_HYBRID 	// sleep, then spin the last FRAME_SPIN_SECONDS
+	};
+
 	class MainLoop : public IInputEventListener
 	{
 	public:
@@ -50,10 +90,27 @@ namespace Procyon {
 	protected:
         virtual void 	HandleInputEvent( const InputEvent& ev );
     	double 			SecsSinceLaunch() const;
-	    void    		Frame( float dt );
+	    void    		Frame( double dt );
+	    float 			Simulate( double dt );
+	    void 			Tick( float dt );
+	    void 			WaitUntil( double secsSinceLaunch ) const;
+
+		void 			SetTimestepMode( TimestepMode mode ) { mTimestepMode = mode; }
+		void 			SetFramePacing( FramePacing pacing ) { mFramePacing = pacing; }
+
+		// Pipelined frames simulate and record frame N+1 on a mJobs worker
+		// while frame N is drawn and presented on this one, see RecordedFrame.
+		// Process() and Render() then run off the GL thread, so they must not
+		// make graphics API calls directly, and input is sampled once per
+		// frame with its edges seen by a single tick. Only before the first
+		// frame, so nothing drawn so far holds resources of the real render
+		// core.
+		void 			SetPipelined( bool pipelined );
+		bool 			IsPipelined() const { return mPipelined; }
 
 	    virtual void    Process( FrameTime t ) { };
-	    virtual void    Render() { };
+	    // alpha is 1 with TIMESTEP_VARIABLE, see TimestepMode.
+	    virtual void    Render( float alpha ) { };
 
 	    // IInputEventListener
 	    virtual void    OnKeyDown( const InputEvent& ev ) {};
@@ -68,10 +125,21 @@ namespace Procyon {
 	    Renderer*       mRenderer;
 	    AudioDevice*    mAudioDev;
 
+	    // Shared workers for anything that splits a frame across threads.
+	    JobPool 		mJobs;
+
 		uint32_t		mFrame;
 	    FrameTime       mSimTime;
 	    double			mStartTime;
 	    double 			mAvgFPS;
+
+		TimestepMode 	mTimestepMode;
+		FramePacing 	mFramePacing;
+		double 			mAccumulator; 	// unsimulated seconds, TIMESTEP_FIXED
+
+		bool 			mPipelined;
+		RecordedFrame 	mFrames[ 2 ]; 	// recorded on the worker, played back here
+		int 			mPlaybackFrame; // index into mFrames, -1 when nothing is recorded
 	};
 
 } /* namespace Procyon */
@@ -40,7 +40,12 @@ namespace Procyon {
 
 	/* static */ void Keyboard::Poll( bool hasFocus )
 	{
-		sPrevKeyState = sCurrentKeyState;
+		ConsumeEdges();
+		Sample( hasFocus );
+	}
+
+	/* static */ void Keyboard::Sample( bool hasFocus )
+	{
 		PlatformInput::PollKeyboardState( &sCurrentKeyState );
 
 		if ( !hasFocus )
@@ -49,6 +54,11 @@ namespace Procyon {
 		}
 	}
 
+	/* static */ void Keyboard::ConsumeEdges()
+	{
+		sPrevKeyState = sCurrentKeyState;
+	}
+
 	/* static */ bool Keyboard::IsKeyUp( ProcyonKeyCode key )
 	{
 		return !sCurrentKeyState.keys[ int( key ) ];
@@ -39,6 +39,12 @@ namespace Procyon {
 	public:
 		static void Reset();
 		static void Poll( bool hasFocus );
+
+		// Poll() split in two for callers that sample more often than they
+		// consume edges. Sample() reads the current state but keeps the
+		// previous one, ConsumeEdges() makes the current state the previous.
+		static void Sample( bool hasFocus );
+		static void ConsumeEdges();
 		static bool	IsKeyUp( ProcyonKeyCode key );
 		static bool	IsKeyDown( ProcyonKeyCode key );
 		static bool	OnKeyUp( ProcyonKeyCode key);
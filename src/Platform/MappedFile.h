@@ -0,0 +1,61 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#ifndef _MAPPED_FILE_H
+#define _MAPPED_FILE_H
+
+#include "ProcyonCommon.h"
+
+namespace Procyon {
+
+	/*
+	================
+	MappedFile
+
+	Read-only memory mapping of a whole file. Pages are loaded lazily by the
+	OS, so opening even a large file costs next to nothing.
+	================
+	*/
+	class MappedFile
+	{
+	public:
+								MappedFile();
+								~MappedFile();
+
+		bool 					Open( const std::string& filepath );
+		void 					Close();
+
+		bool 					IsOpen() const { return mData != NULL; }
+		const unsigned char* 	GetData() const { return mData; }
+		size_t 					GetSize() const { return mSize; }
+
+	protected:
+		const unsigned char* 	mData;
+		size_t 					mSize;
+		void* 					mHandle; // platform mapping handle, if any
+	};
+
+} /* namespace Procyon */
+
+#endif /* _MAPPED_FILE_H */
@@ -41,7 +41,12 @@ namespace Procyon {
 
 	/* static */ void Mouse::Poll( bool hasFocus )
 	{
-		sPrevMouseState = sCurrentMouseState;
+		ConsumeEdges();
+		Sample( hasFocus );
+	}
+
+	/* static */ void Mouse::Sample( bool hasFocus )
+	{
 		PlatformInput::PollMouseState( &sCurrentMouseState );
 
 		if ( !hasFocus )
@@ -50,6 +55,11 @@ namespace Procyon {
 		}
 	}
 
+	/* static */ void Mouse::ConsumeEdges()
+	{
+		sPrevMouseState = sCurrentMouseState;
+	}
+
 	/* static */ bool Mouse::IsButtonUp( ProcyonMouseButton key )
 	{
 		return !sCurrentMouseState.btns[ int( key ) ];
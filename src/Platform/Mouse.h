@@ -42,6 +42,10 @@ namespace Procyon {
 	public:
 		static void Reset();
 		static void Poll( bool hasFocus );
+
+		// As Keyboard::Sample() and Keyboard::ConsumeEdges().
+		static void Sample( bool hasFocus );
+		static void ConsumeEdges();
 		static bool	IsButtonUp( ProcyonMouseButton key );
 		static bool	IsButtonDown( ProcyonMouseButton key );
 		static bool	OnButtonUp( ProcyonMouseButton key);
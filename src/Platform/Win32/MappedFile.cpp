@@ -0,0 +1,97 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "Platform/MappedFile.h"
+
+#include <windows.h>
+
+namespace Procyon {
+
+	MappedFile::MappedFile()
+		: mData( NULL )
+		, mSize( 0 )
+		, mHandle( NULL )
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open( const std::string& filepath )
+	{
+		Close();
+
+		HANDLE file = CreateFileA( filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL
+			, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+		if ( file == INVALID_HANDLE_VALUE )
+		{
+			PROCYON_WARN( "MappedFile", "Unable to open '%s'.", filepath.c_str() );
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if ( !GetFileSizeEx( file, &size ) || size.QuadPart == 0 )
+		{
+			PROCYON_WARN( "MappedFile", "Unable to map empty or unreadable file '%s'.", filepath.c_str() );
+			CloseHandle( file );
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+		CloseHandle( file ); // the mapping keeps the file alive
+		if ( !mapping )
+		{
+			PROCYON_WARN( "MappedFile", "CreateFileMapping failed for '%s'.", filepath.c_str() );
+			return false;
+		}
+
+		void* data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+		if ( !data )
+		{
+			PROCYON_WARN( "MappedFile", "MapViewOfFile failed for '%s'.", filepath.c_str() );
+			CloseHandle( mapping );
+			return false;
+		}
+
+		mData = (const unsigned char*)data;
+		mSize = (size_t)size.QuadPart;
+		mHandle = mapping;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if ( mData )
+		{
+			UnmapViewOfFile( mData );
+			CloseHandle( (HANDLE)mHandle );
+		}
+		mData = NULL;
+		mSize = 0;
+		mHandle = NULL;
+	}
+
+} /* namespace Procyon */
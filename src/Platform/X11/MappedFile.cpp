@@ -0,0 +1,89 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+#include "Platform/MappedFile.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace Procyon {
+
+	MappedFile::MappedFile()
+		: mData( NULL )
+		, mSize( 0 )
+		, mHandle( NULL )
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open( const std::string& filepath )
+	{
+		Close();
+
+		int fd = open( filepath.c_str(), O_RDONLY );
+		if ( fd == -1 )
+		{
+			PROCYON_WARN( "MappedFile", "Unable to open '%s'.", filepath.c_str() );
+			return false;
+		}
+
+		struct stat st;
+		if ( fstat( fd, &st ) != 0 || st.st_size == 0 )
+		{
+			PROCYON_WARN( "MappedFile", "Unable to map empty or unreadable file '%s'.", filepath.c_str() );
+			close( fd );
+			return false;
+		}
+
+		void* data = mmap( NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+		close( fd ); // the mapping keeps the file alive
+
+		if ( data == MAP_FAILED )
+		{
+			PROCYON_WARN( "MappedFile", "mmap failed for '%s'.", filepath.c_str() );
+			return false;
+		}
+
+		mData = (const unsigned char*)data;
+		mSize = (size_t)st.st_size;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if ( mData )
+		{
+			munmap( (void*)mData, mSize );
+		}
+		mData = NULL;
+		mSize = 0;
+	}
+
+} /* namespace Procyon */
@@ -47,6 +47,7 @@ along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
 #include <iomanip>
 #include <stack>
 #include <cmath>
+#include <limits>
 
 #include "Logging.h"
 #include "Macros.h"
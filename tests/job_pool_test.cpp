@@ -0,0 +1,74 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#include "test_base.h"
+#include "JobPool.h"
+
+#include <atomic>
+
+using namespace Procyon;
+
+class JobPoolTests : public ProcyonTestBase { };
+
+TEST_F( JobPoolTests, Wait_RunsEveryCountedJob )
+{
+	JobPool pool( 3 );
+	EXPECT_EQ( 3u, pool.GetWorkerCount() );
+
+	std::atomic< int > sum( 0 );
+	JobCounter counter;
+	for ( int i = 1; i <= 100; i++ )
+	{
+		pool.Push( [ &sum, i ]() { sum += i; }, &counter );
+	}
+
+	pool.Wait( counter );
+	EXPECT_EQ( 5050, sum.load() );
+
+	// Nothing pending returns straight away.
+	pool.Wait( counter );
+}
+
+TEST_F( JobPoolTests, Wait_InsideJobHelpsInsteadOfDeadlocking )
+{
+	// The only worker runs the outer job, so the inner ones can only
+	// finish by the outer job running them itself.
+	JobPool pool( 1 );
+
+	std::atomic< int > inner( 0 );
+	JobCounter outer;
+	pool.Push( [ &pool, &inner ]()
+	{
+		JobCounter children;
+		for ( int i = 0; i < 8; i++ )
+		{
+			pool.Push( [ &inner ]() { inner++; }, &children );
+		}
+		pool.Wait( children );
+	}, &outer );
+
+	pool.Wait( outer );
+	EXPECT_EQ( 8, inner.load() );
+}
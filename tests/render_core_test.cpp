@@ -0,0 +1,709 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#include "test_base.h"
+#include "Graphics/NullRenderCore.h"
+#include "Graphics/RenderCommandList.h"
+#include "Graphics/QuadBuffer.h"
+#include "Graphics/Camera.h"
+#include "Graphics/RecordedFrame.h"
+#include "Graphics/PolyLineTessellator.h"
+
+using namespace Procyon;
+
+class RenderCoreTests : public ProcyonTestBase { };
+
+/*
+================
+MakeQuad
+================
+*/
+static BatchedQuad MakeQuad( float x, float y )
+{
+	BatchedQuad quad;
+	memset( &quad, 0, sizeof( quad ) );
+	quad.position[0] = x;
+	quad.position[1] = y;
+	quad.size[0]     = 1.0f;
+	quad.size[1]     = 1.0f;
+	return quad;
+}
+
+/*
+================
+QuadCommand
+================
+*/
+static RenderCommand QuadCommand( const BatchedQuad* quad, const Texture* tex, char flags = 0 )
+{
+	RenderCommand cmd;
+	cmd.op               = RENDER_OP_QUAD;
+	cmd.flags            = flags;
+	cmd.texture          = tex;
+	cmd.instancecount    = 1;
+	cmd.quaddata         = quad;
+	return cmd;
+}
+
+/*
+================
+RenderCoreTests::NullCore_AppendsMatchingQuads
+================
+*/
+TEST_F(RenderCoreTests, NullCore_AppendsMatchingQuads)
+{
+	NullRenderCore core;
+	Camera2D camera;
+
+	BatchedQuad quads[] = { MakeQuad( 0.0f, 0.0f ), MakeQuad( 1.0f, 0.0f ), MakeQuad( 2.0f, 0.0f ) };
+	for ( int i = 0; i < 3; i++ )
+	{
+		core.AddOrAppendCommand( QuadCommand( &quads[ i ], NULL ) );
+	}
+
+	EXPECT_TRUE( core.RenderCommandsPending() );
+	core.Flush( camera );
+	EXPECT_FALSE( core.RenderCommandsPending() );
+
+	const std::vector< RenderCommand >& cmds = core.GetRecordedCommands();
+	ASSERT_EQ( 1u, cmds.size() );
+	EXPECT_EQ( 3, cmds[ 0 ].instancecount );
+	EXPECT_EQ( 3 * sizeof( BatchedQuad ), core.GetRecordedVertexData().size() );
+	EXPECT_EQ( 0, memcmp( quads, core.GetRecordedVertexData().data(), sizeof( quads ) ) );
+
+	const RenderFrameStats& stats = core.GetFrameStats();
+	EXPECT_EQ( 1, stats.batches );
+	EXPECT_EQ( 3, stats.totalquads );
+}
+
+/*
+================
+RenderCoreTests::NullCore_BreaksBatchOnStateChange
+================
+*/
+TEST_F(RenderCoreTests, NullCore_BreaksBatchOnStateChange)
+{
+	NullRenderCore core;
+	Camera2D camera;
+
+	BatchedQuad quad = MakeQuad( 0.0f, 0.0f );
+	core.AddOrAppendCommand( QuadCommand( &quad, NULL ) );
+	core.AddOrAppendCommand( QuadCommand( &quad, NULL, RENDER_SCREEN_SPACE ) );
+	core.AddOrAppendCommand( QuadCommand( &quad, NULL ) );
+	core.Flush( camera );
+
+	EXPECT_EQ( 3u, core.GetRecordedCommands().size() );
+	EXPECT_EQ( 3, core.GetFrameStats().batches );
+
+	// A new frame clears the recording.
+	core.ResetStats();
+	EXPECT_EQ( 0u, core.GetRecordedCommands().size() );
+	EXPECT_EQ( 0, core.GetRecordedFlushCount() );
+}
+
+/*
+================
+RenderCoreTests::AppendCommandData_WritesInPlace
+================
+*/
+TEST_F(RenderCoreTests, AppendCommandData_WritesInPlace)
+{
+	Camera2D camera;
+	const RenderSortMode modes[] = { RENDER_SORT_SUBMISSION, RENDER_SORT_STATE };
+
+	for ( RenderSortMode mode : modes )
+	{
+		NullRenderCore core;
+		core.SetSortMode( mode );
+
+		BatchedQuad quads[] = { MakeQuad( 0.0f, 0.0f ), MakeQuad( 1.0f, 0.0f ) };
+		for ( int i = 0; i < 2; i++ )
+		{
+			BatchedQuad* dst = (BatchedQuad*)core.AppendCommandData( QuadCommand( NULL, NULL ) );
+			ASSERT_TRUE( dst != NULL );
+			*dst = quads[ i ];
+		}
+		core.Flush( camera );
+
+		ASSERT_EQ( 1u, core.GetRecordedCommands().size() );
+		EXPECT_EQ( 2, core.GetRecordedCommands()[ 0 ].instancecount );
+		EXPECT_EQ( 0, memcmp( quads, core.GetRecordedVertexData().data(), sizeof( quads ) ) );
+	}
+}
+
+/*
+================
+RenderCoreTests::NullCore_AlignsCommandOffsets
+================
+*/
+TEST_F(RenderCoreTests, NullCore_AlignsCommandOffsets)
+{
+	NullRenderCore core;
+	Camera2D camera;
+
+	PrimitiveVertex verts[ 2 ] = { { { 0.0f, 0.0f } }, { { 1.0f, 1.0f } } };
+	RenderCommand line;
+	memset( &line, 0, sizeof( line ) );
+	line.op 		= RENDER_OP_PRIMITIVE;
+	line.primmode 	= PRIMITIVE_LINE;
+	line.verts 		= verts;
+	line.vertcount 	= 2;
+	core.AddOrAppendCommand( line );
+
+	BatchedQuad quad = MakeQuad( 0.0f, 0.0f );
+	core.AddOrAppendCommand( QuadCommand( &quad, NULL ) );
+	core.Flush( camera );
+
+	const std::vector< RenderCommand >& cmds = core.GetRecordedCommands();
+	ASSERT_EQ( 2u, cmds.size() );
+	EXPECT_EQ( 0, cmds[ 1 ].offset % (int)sizeof( BatchedQuad ) );
+	EXPECT_EQ( 0, memcmp( &quad, core.GetRecordedVertexData().data() + cmds[ 1 ].offset, sizeof( quad ) ) );
+}
+
+/*
+================
+RenderCoreTests::NullCore_GrowsInsteadOfDropping
+================
+*/
+TEST_F(RenderCoreTests, NullCore_GrowsInsteadOfDropping)
+{
+	Camera2D camera;
+	const int quadCount = ( RENDER_STREAM_CHUNK_BYTES / sizeof( BatchedQuad ) ) + 100;
+	const RenderSortMode modes[] = { RENDER_SORT_SUBMISSION, RENDER_SORT_STATE };
+
+	for ( RenderSortMode mode : modes )
+	{
+		NullRenderCore core;
+		core.SetSortMode( mode );
+
+		// Alternating state defeats submission order batching.
+		BatchedQuad quad = MakeQuad( 0.0f, 0.0f );
+		for ( int i = 0; i < quadCount; i++ )
+		{
+			core.AddOrAppendCommand( QuadCommand( &quad, NULL, ( i % 2 ) ? RENDER_SCREEN_SPACE : 0 ) );
+		}
+		core.Flush( camera );
+
+		const RenderFrameStats& stats = core.GetFrameStats();
+		EXPECT_EQ( quadCount, stats.totalquads );
+		EXPECT_GT( stats.autoflushes, 0 );
+		EXPECT_EQ( stats.autoflushes + 1, core.GetRecordedFlushCount() );
+		if ( mode == RENDER_SORT_SUBMISSION )
+		{
+			EXPECT_LE( stats.peakvertexbytes, RENDER_STREAM_CHUNK_BYTES );
+			EXPECT_GT( stats.peakcommands, RENDER_CMDS_INITIAL );
+		}
+		else
+		{
+			// Staging holds the whole frame.
+			EXPECT_EQ( quadCount, stats.peakcommands );
+		}
+	}
+}
+
+/*
+================
+RenderCoreTests::Submit_SplitsRunsLongerThanAChunk
+================
+*/
+TEST_F(RenderCoreTests, Submit_SplitsRunsLongerThanAChunk)
+{
+	Camera2D camera;
+	const int quadCount = 2 * ( RENDER_STREAM_CHUNK_BYTES / sizeof( BatchedQuad ) ) + 7;
+	const RenderSortMode modes[] = { RENDER_SORT_SUBMISSION, RENDER_SORT_STATE };
+
+	std::vector< BatchedQuad > quads;
+	for ( int i = 0; i < quadCount; i++ )
+	{
+		quads.push_back( MakeQuad( (float)i, 0.0f ) );
+	}
+
+	// One run, merged in the list, that no single chunk can hold.
+	RenderCommandList list;
+	RenderCommand cmd = QuadCommand( quads.data(), NULL );
+	cmd.instancecount = quadCount;
+	list.AddOrAppendCommand( cmd );
+	ASSERT_EQ( 1, list.GetCommandCount() );
+
+	for ( RenderSortMode mode : modes )
+	{
+		NullRenderCore core;
+		core.SetSortMode( mode );
+		core.Submit( list );
+		core.Flush( camera );
+
+		const RenderFrameStats& stats = core.GetFrameStats();
+		EXPECT_EQ( quadCount, stats.totalquads );
+		EXPECT_EQ( 2, stats.autoflushes );
+
+		// Every quad arrives once, in order.
+		int next = 0;
+		for ( const RenderCommand& rc : core.GetRecordedCommands() )
+		{
+			const BatchedQuad* recorded = (const BatchedQuad*)( core.GetRecordedVertexData().data() + rc.offset );
+			for ( int i = 0; i < rc.instancecount; i++ )
+			{
+				EXPECT_EQ( (float)next++, recorded[ i ].position[ 0 ] );
+			}
+		}
+		EXPECT_EQ( quadCount, next );
+	}
+}
+
+/*
+================
+RenderCoreTests::NullCore_WriteFrameIsStable
+================
+*/
+TEST_F(RenderCoreTests, NullCore_WriteFrameIsStable)
+{
+	Camera2D camera;
+	std::string frames[ 2 ];
+
+	for ( int i = 0; i < 2; i++ )
+	{
+		NullRenderCore core;
+		BatchedQuad quad = MakeQuad( 4.0f, 2.0f );
+		core.AddOrAppendCommand( QuadCommand( &quad, NULL ) );
+		core.Flush( camera );
+
+		std::stringstream out;
+		core.WriteFrame( out );
+		frames[ i ] = out.str();
+	}
+
+	EXPECT_FALSE( frames[ 0 ].empty() );
+	EXPECT_EQ( frames[ 0 ], frames[ 1 ] );
+}
+
+/*
+================
+RenderCoreTests::SortState_MergesInterleavedTextures
+================
+*/
+TEST_F(RenderCoreTests, SortState_MergesInterleavedTextures)
+{
+	NullRenderCore core;
+	Camera2D camera;
+	core.SetSortMode( RENDER_SORT_STATE );
+
+	// Only compared by address.
+	int texStorage[ 2 ];
+	const Texture* texA = reinterpret_cast< const Texture* >( &texStorage[ 0 ] );
+	const Texture* texB = reinterpret_cast< const Texture* >( &texStorage[ 1 ] );
+
+	BatchedQuad quads[ 6 ];
+	for ( int i = 0; i < 6; i++ )
+	{
+		quads[ i ] = MakeQuad( (float)i, 0.0f );
+		core.AddOrAppendCommand( QuadCommand( &quads[ i ], ( i % 2 ) ? texB : texA ) );
+	}
+	core.Flush( camera );
+
+	const std::vector< RenderCommand >& cmds = core.GetRecordedCommands();
+	ASSERT_EQ( 2u, cmds.size() );
+	EXPECT_EQ( 3, cmds[ 0 ].instancecount );
+	EXPECT_EQ( 3, cmds[ 1 ].instancecount );
+	EXPECT_EQ( 4, core.GetFrameStats().sortmerges );
+
+	// Submission order is kept within the merged run.
+	const BatchedQuad* recorded = reinterpret_cast< const BatchedQuad* >( core.GetRecordedVertexData().data() + cmds[ 0 ].offset );
+	EXPECT_EQ( 0.0f, recorded[ 0 ].position[ 0 ] );
+	EXPECT_EQ( 2.0f, recorded[ 1 ].position[ 0 ] );
+	EXPECT_EQ( 4.0f, recorded[ 2 ].position[ 0 ] );
+}
+
+/*
+================
+RenderCoreTests::SortState_LayersDrawInOrder
+================
+*/
+TEST_F(RenderCoreTests, SortState_LayersDrawInOrder)
+{
+	NullRenderCore core;
+	Camera2D camera;
+	core.SetSortMode( RENDER_SORT_STATE );
+
+	BatchedQuad front = MakeQuad( 1.0f, 0.0f );
+	BatchedQuad back = MakeQuad( 0.0f, 0.0f );
+
+	core.SetLayer( 2 );
+	core.AddOrAppendCommand( QuadCommand( &front, NULL ) );
+	core.SetLayer( 1 );
+	core.AddOrAppendCommand( QuadCommand( &back, NULL ) );
+	core.Flush( camera );
+
+	const std::vector< RenderCommand >& cmds = core.GetRecordedCommands();
+	ASSERT_EQ( 2u, cmds.size() );
+	EXPECT_EQ( 1, cmds[ 0 ].layer );
+	EXPECT_EQ( 2, cmds[ 1 ].layer );
+}
+
+/*
+================
+RenderCoreTests::AddOrAppendQuad_CompactsExactQuads
+================
+*/
+TEST_F(RenderCoreTests, AddOrAppendQuad_CompactsExactQuads)
+{
+	NullRenderCore core;
+	Camera2D camera;
+
+	BatchedQuad exact = MakeQuad( 10.5f, -3.0f );
+	BatchedQuad inexact = MakeQuad( 10.3f, 0.0f );
+
+	CompactQuad packed;
+	EXPECT_TRUE( PackCompactQuad( exact, &packed ) );
+	EXPECT_EQ( 21, packed.position[ 0 ] );
+	EXPECT_FALSE( PackCompactQuad( inexact, &packed ) );
+
+	// An inexact quad splits off a full precision batch, which then keeps
+	// absorbing quads rather than flip flopping between layouts.
+	core.AddOrAppendQuad( QuadCommand( NULL, NULL ), exact );
+	core.AddOrAppendQuad( QuadCommand( NULL, NULL ), inexact );
+	core.AddOrAppendQuad( QuadCommand( NULL, NULL ), exact );
+	core.Flush( camera );
+
+	const std::vector< RenderCommand >& cmds = core.GetRecordedCommands();
+	ASSERT_EQ( 2u, cmds.size() );
+	EXPECT_TRUE( ( cmds[ 0 ].flags & RENDER_QUAD_COMPACT ) != 0 );
+	EXPECT_EQ( 1, cmds[ 0 ].instancecount );
+	EXPECT_FALSE( ( cmds[ 1 ].flags & RENDER_QUAD_COMPACT ) != 0 );
+	EXPECT_EQ( 2, cmds[ 1 ].instancecount );
+}
+
+/*
+================
+RenderCoreTests::Submit_MergesListsInOrder
+================
+*/
+TEST_F(RenderCoreTests, Submit_MergesListsInOrder)
+{
+	NullRenderCore core;
+	Camera2D camera;
+	RenderCommandList lists[ 2 ];
+
+	BatchedQuad quads[] = { MakeQuad( 0.0f, 0.0f ), MakeQuad( 1.0f, 0.0f ), MakeQuad( 2.0f, 0.0f ) };
+	lists[ 1 ].AddOrAppendCommand( QuadCommand( &quads[ 1 ], NULL ) );
+	lists[ 1 ].AddOrAppendCommand( QuadCommand( &quads[ 2 ], NULL ) );
+	lists[ 0 ].SetLayer( 3 );
+	lists[ 0 ].AddOrAppendCommand( QuadCommand( &quads[ 0 ], NULL ) );
+
+	core.Submit( lists[ 0 ] );
+	core.Submit( lists[ 1 ] );
+	core.Flush( camera );
+
+	// Different layers stay apart, the rest follows submission order.
+	const std::vector< RenderCommand >& cmds = core.GetRecordedCommands();
+	ASSERT_EQ( 2u, cmds.size() );
+	EXPECT_EQ( 3, cmds[ 0 ].layer );
+	EXPECT_EQ( 2, cmds[ 1 ].instancecount );
+
+	const BatchedQuad* recorded = (const BatchedQuad*)( core.GetRecordedVertexData().data() + cmds[ 1 ].offset );
+	EXPECT_EQ( 1.0f, recorded[ 0 ].position[ 0 ] );
+	EXPECT_EQ( 2.0f, recorded[ 1 ].position[ 0 ] );
+
+	lists[ 1 ].Clear();
+	EXPECT_EQ( 0, lists[ 1 ].GetCommandCount() );
+}
+
+/*
+================
+RenderCoreTests::QuadBuffer_DrawsWithoutStreaming
+================
+*/
+TEST_F(RenderCoreTests, QuadBuffer_DrawsWithoutStreaming)
+{
+	NullRenderCore core;
+	Camera2D camera;
+
+	BatchedQuad quads[] = { MakeQuad( 0.0f, 0.0f ), MakeQuad( 16.0f, 0.0f ) };
+	QuadBuffer* buffer = core.AllocateQuadBuffer();
+	buffer->SetQuads( quads, 2 );
+	EXPECT_TRUE( buffer->IsCompact() );
+
+	// Static batches never absorb or get absorbed by streamed quads.
+	core.AddQuadBuffer( buffer, NULL );
+	core.AddOrAppendCommand( QuadCommand( &quads[ 0 ], NULL ) );
+	core.AddQuadBuffer( buffer, NULL );
+	core.Flush( camera );
+
+	const std::vector< RenderCommand >& cmds = core.GetRecordedCommands();
+	ASSERT_EQ( 3u, cmds.size() );
+	EXPECT_TRUE( ( cmds[ 0 ].flags & RENDER_QUAD_STATIC ) != 0 );
+	EXPECT_TRUE( ( cmds[ 0 ].flags & RENDER_QUAD_COMPACT ) != 0 );
+	EXPECT_EQ( 2, cmds[ 0 ].instancecount );
+	EXPECT_EQ( buffer, cmds[ 2 ].quadbuffer );
+	EXPECT_EQ( sizeof( BatchedQuad ), core.GetRecordedVertexData().size() );
+
+	delete buffer;
+}
+
+/*
+================
+RenderCoreTests::FrameRecorder_SplitsPassesByCamera
+================
+*/
+TEST_F(RenderCoreTests, FrameRecorder_SplitsPassesByCamera)
+{
+	FrameRecorder recorder;
+	RecordedFrame frame;
+	RenderFrameStats stats;
+	memset( &stats, 0, sizeof( stats ) );
+	stats.batches = 7;
+
+	Camera2D world;
+	world.SetPosition( glm::vec2( 5.0f, 0.0f ) );
+	Camera2D screen;
+
+	BatchedQuad quads[] = { MakeQuad( 0.0f, 0.0f ), MakeQuad( 16.0f, 0.0f ) };
+	QuadBuffer* buffer = recorder.AllocateQuadBuffer();
+	buffer->SetQuads( quads, 2 );
+
+	// Record twice into the same frame, storage is reused.
+	for ( int i = 0; i < 2; i++ )
+	{
+		recorder.Begin( &frame, stats );
+		recorder.SetLayer( 2 );
+		recorder.AddQuadBuffer( buffer, NULL );
+		recorder.AddOrAppendCommand( QuadCommand( &quads[ 0 ], NULL ) );
+		EXPECT_TRUE( recorder.RenderCommandsPending() );
+		recorder.Flush( world );
+		recorder.Flush( world ); // nothing new, no empty pass
+		recorder.AddOrAppendCommand( QuadCommand( &quads[ 1 ], NULL ) );
+		recorder.End( screen );
+	}
+
+	EXPECT_EQ( 7, recorder.GetFrameStats().batches );
+	ASSERT_EQ( 2, frame.GetPassCount() );
+	EXPECT_EQ( glm::vec2( 5.0f, 0.0f ), frame.GetPassCamera( 0 ).GetPosition() );
+
+	// The buffer is streamed since the render core can't draw it directly.
+	NullRenderCore core;
+	core.Submit( frame.GetPassList( 0 ) );
+	core.Flush( frame.GetPassCamera( 0 ) );
+	const std::vector< RenderCommand >& cmds = core.GetRecordedCommands();
+	ASSERT_EQ( 2u, cmds.size() );
+	EXPECT_EQ( 0, cmds[ 0 ].flags & RENDER_QUAD_STATIC );
+	EXPECT_TRUE( ( cmds[ 0 ].flags & RENDER_QUAD_COMPACT ) != 0 );
+	EXPECT_EQ( 2, cmds[ 0 ].instancecount );
+	EXPECT_EQ( 2, cmds[ 0 ].layer );
+	EXPECT_EQ( 1, frame.GetPassList( 1 ).GetCommandCount() );
+	EXPECT_EQ( 2, frame.GetPassList( 1 ).GetCommands()[ 0 ].layer );
+
+	delete buffer;
+}
+
+static float CoveredArea( const PolyLineTessellator& tess )
+{
+	const ColorVertex* v = tess.GetVertices();
+	float area = 0.0f;
+	for ( int i = 0; i + 2 < tess.GetVertexCount(); i += 3 )
+	{
+		const glm::vec2 a( v[ i ].position[ 0 ], v[ i ].position[ 1 ] );
+		const glm::vec2 b( v[ i + 1 ].position[ 0 ], v[ i + 1 ].position[ 1 ] );
+		const glm::vec2 c( v[ i + 2 ].position[ 0 ], v[ i + 2 ].position[ 1 ] );
+		area += fabs( ( b.x - a.x ) * ( c.y - a.y ) - ( c.x - a.x ) * ( b.y - a.y ) ) * 0.5f;
+	}
+	return area;
+}
+
+/*
+================
+RenderCoreTests::PolyLine_CoversStrokeWithoutOverlap
+================
+*/
+TEST_F(RenderCoreTests, PolyLine_CoversStrokeWithoutOverlap)
+{
+	PolyLineTessellator tess;
+	PolyLineStyle style;
+	style.color 		= glm::vec4( 1.0f );
+	style.width 		= 2.0f;
+	style.feather 		= 0.0f;
+	style.miterLimit 	= 4.0f;
+	style.join 			= PolyLineJoinMode::BEVEL;
+	style.cap 			= PolyLineCapMode::BUTT;
+
+	// Straight, with a duplicate point: 20x2.
+	const glm::vec2 straight[] = { glm::vec2( 0, 0 ), glm::vec2( 10, 0 ), glm::vec2( 10, 0 ), glm::vec2( 20, 0 ) };
+	tess.Tessellate( straight, 4, style );
+	EXPECT_NEAR( 40.0f, CoveredArea( tess ), 1e-3f );
+
+	// Square caps add half the width at each end.
+	tess.Clear();
+	style.cap = PolyLineCapMode::SQUARE;
+	tess.Tessellate( straight, 4, style );
+	EXPECT_NEAR( 44.0f, CoveredArea( tess ), 1e-3f );
+	style.cap = PolyLineCapMode::BUTT;
+
+	// Right angle bevels, turning either way: two 10x2 legs sharing a
+	// corner, plus the bevel triangle.
+	const glm::vec2 left[] = { glm::vec2( 0, 0 ), glm::vec2( 10, 0 ), glm::vec2( 10, 10 ) };
+	const glm::vec2 right[] = { glm::vec2( 0, 0 ), glm::vec2( 10, 0 ), glm::vec2( 10, -10 ) };
+	tess.Clear();
+	tess.Tessellate( left, 3, style );
+	EXPECT_NEAR( 39.5f, CoveredArea( tess ), 1e-3f );
+	tess.Clear();
+	tess.Tessellate( right, 3, style );
+	EXPECT_NEAR( 39.5f, CoveredArea( tess ), 1e-3f );
+
+	// A miter fills the whole corner square.
+	tess.Clear();
+	style.join = PolyLineJoinMode::MITER;
+	tess.Tessellate( left, 3, style );
+	EXPECT_NEAR( 40.0f, CoveredArea( tess ), 1e-3f );
+
+	// Round joins land between the two, round caps add a disc.
+	tess.Clear();
+	style.join = PolyLineJoinMode::ROUND;
+	style.cap = PolyLineCapMode::ROUND;
+	tess.Tessellate( left, 3, style );
+	const float round = CoveredArea( tess ) - (float)M_PI;
+	EXPECT_GT( round, 39.5f );
+	EXPECT_LT( round, 39.5f + 0.25f * (float)M_PI - 0.5f + 1e-3f );
+
+	// Feathering adds fringe geometry, and once the arena has grown to fit
+	// it smaller lines reuse the same storage.
+	const int count = tess.GetVertexCount();
+	tess.Clear();
+	style.feather = 0.5f;
+	tess.Tessellate( left, 3, style );
+	EXPECT_GT( tess.GetVertexCount(), count );
+	const ColorVertex* storage = tess.GetVertices();
+	tess.Clear();
+	style.feather = 0.0f;
+	EXPECT_EQ( count, tess.Tessellate( left, 3, style ) );
+	EXPECT_EQ( storage, tess.GetVertices() );
+}
+
+/*
+================
+RenderCoreTests::PolyLine_BatchesMatchingStyles
+================
+*/
+TEST_F(RenderCoreTests, PolyLine_BatchesMatchingStyles)
+{
+	Camera2D camera;
+	NullRenderCore core;
+
+	RenderCommand cmd;
+	memset( &cmd, 0, sizeof( cmd ) );
+	cmd.op 				= RENDER_OP_POLYLINE;
+	cmd.polypointcount 	= 4;
+	cmd.polywidth 		= 2.0f;
+	cmd.polymiterlimit 	= 4.0f;
+	cmd.polyjoin 		= PolyLineJoinMode::ROUND;
+	cmd.polycap 		= PolyLineCapMode::BUTT;
+
+	// Two separate lines in one batch, each keeps its own breaks.
+	const PolyLinePoint lines[] =
+	{
+		{ POLYLINE_BREAK, POLYLINE_BREAK }, { 0.0f, 0.0f }, { 1.0f, 0.0f }, { POLYLINE_BREAK, POLYLINE_BREAK },
+		{ POLYLINE_BREAK, POLYLINE_BREAK }, { 5.0f, 5.0f }, { 6.0f, 5.0f }, { POLYLINE_BREAK, POLYLINE_BREAK }
+	};
+	for ( int i = 0; i < 2; i++ )
+	{
+		PolyLinePoint* dst = (PolyLinePoint*)core.AppendCommandData( cmd );
+		ASSERT_TRUE( dst != NULL );
+		memcpy( dst, &lines[ i * 4 ], sizeof( PolyLinePoint ) * 4 );
+	}
+
+	// Any style change starts a new batch.
+	cmd.polyjoin = PolyLineJoinMode::MITER;
+	cmd.polypoints = lines;
+	core.AddOrAppendCommand( cmd );
+	core.Flush( camera );
+
+	const std::vector< RenderCommand >& cmds = core.GetRecordedCommands();
+	ASSERT_EQ( 2u, cmds.size() );
+	EXPECT_EQ( 8, cmds[ 0 ].polypointcount );
+	EXPECT_EQ( 4, cmds[ 1 ].polypointcount );
+	EXPECT_EQ( 0, memcmp( lines, core.GetRecordedVertexData().data() + cmds[ 0 ].offset, sizeof( lines ) ) );
+}
+
+/*
+================
+RenderCoreTests::AALinesAndPolygons_Batch
+================
+*/
+TEST_F(RenderCoreTests, AALinesAndPolygons_Batch)
+{
+	Camera2D camera;
+	const RenderSortMode modes[] = { RENDER_SORT_SUBMISSION, RENDER_SORT_STATE };
+
+	for ( RenderSortMode mode : modes )
+	{
+		NullRenderCore core;
+		core.SetSortMode( mode );
+
+		// Lines of any width and color share a batch.
+		RenderCommand line;
+		memset( &line, 0, sizeof( line ) );
+		line.op = RENDER_OP_AA_LINE;
+		line.linevertcount = 4;
+		for ( int i = 0; i < 1000; i++ )
+		{
+			AALineVertex* dst = (AALineVertex*)core.AppendCommandData( line );
+			ASSERT_TRUE( dst != NULL );
+			const AALineVertex v = { (float)i, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, (float)( i % 7 ), 0.5f };
+			dst[ 0 ] = dst[ 1 ] = dst[ 2 ] = dst[ 3 ] = v;
+		}
+
+		ColorVertex tri[ 3 ];
+		memset( tri, 0, sizeof( tri ) );
+		RenderCommand polygon;
+		memset( &polygon, 0, sizeof( polygon ) );
+		polygon.op = RENDER_OP_POLYGON;
+		polygon.colorprimmode = PRIMITIVE_TRIANGLE;
+		polygon.colorverts = tri;
+		polygon.colorvertcount = 3;
+		core.AddOrAppendCommand( polygon );
+		core.AddOrAppendCommand( polygon );
+		polygon.colorprimmode = PRIMITIVE_LINE;
+		polygon.colorvertcount = 2;
+		core.AddOrAppendCommand( polygon );
+		core.Flush( camera );
+
+		// RENDER_SORT_STATE may reorder the three batches.
+		const RenderCommand* lines = NULL;
+		const RenderCommand* triangles = NULL;
+		const std::vector< RenderCommand >& cmds = core.GetRecordedCommands();
+		ASSERT_EQ( 3u, cmds.size() );
+		for ( const RenderCommand& rc : cmds )
+		{
+			if ( rc.op == RENDER_OP_AA_LINE )
+				lines = &rc;
+			else if ( rc.colorprimmode == PRIMITIVE_TRIANGLE )
+				triangles = &rc;
+		}
+		ASSERT_TRUE( lines != NULL && triangles != NULL );
+		EXPECT_EQ( 4000, lines->linevertcount );
+		EXPECT_EQ( 6, triangles->colorvertcount );
+
+		const AALineVertex* verts = (const AALineVertex*)( core.GetRecordedVertexData().data() + lines->offset );
+		EXPECT_EQ( 999.0f, verts[ 3996 ].position[ 0 ] );
+		EXPECT_EQ( 5.0f, verts[ 3996 ].width );
+	}
+}
@@ -0,0 +1,628 @@
+/*
+===========================================================================
+
+Procyon, a 2D game.
+
+Copyright (C) 2015 Tim Ullrich.
+
+This file is part of Procyon.
+
+Procyon is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Procyon is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Procyon.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#include "test_base.h"
+#include "Collision/BinaryMap.h"
+#include "Collision/XmlMapReader.h"
+#include "Collision/Contact.h"
+#include "Collision/BodySystem.h"
+#include "Collision/SpatialHash.h"
+#include "Aabb.h"
+
+using namespace Procyon;
+
+class WorldTests : public ProcyonTestBase { };
+
+/*
+================
+TestMap
+
+Map held in memory, tile (x, y) is mostly empty with a column pattern.
+================
+*/
+class TestMap : public Map
+{
+public:
+	TestMap( int width, int height )
+		: mSize( width, height )
+	{
+		TileDef def;
+		def.filepath 	= "tiles/ground.png";
+		def.type 		= TILETYPE_SOLID;
+		def.collidable 	= true;
+		mTileSet.AddTileDef( def );
+	}
+
+	virtual TileId GetTile( int x, int y ) const { return ( x % 7 == 0 || y == 3 ) ? 1 : 0; }
+	virtual const TileSet* GetTileSet() const { return &mTileSet; }
+	virtual glm::ivec2 GetSize() const { return mSize; }
+
+protected:
+	TileSet 	mTileSet;
+	glm::ivec2 	mSize;
+};
+
+/*
+================
+WorldTests::BinaryMap_RoundTrips
+================
+*/
+TEST_F(WorldTests, BinaryMap_RoundTrips)
+{
+	// Not a multiple of WORLD_CHUNK_TILES, so the edge chunks are padded.
+	TestMap src( WORLD_CHUNK_TILES * 2 + 5, WORLD_CHUNK_TILES + 9 );
+
+	const bool modes[] = { true, false };
+	for ( bool compress : modes )
+	{
+		const std::string path = "binary_map_test.pmap";
+		ASSERT_TRUE( BinaryMap::Write( path, src, compress ) );
+
+		BinaryMap map( path, false );
+		ASSERT_TRUE( map.Load() );
+		ASSERT_EQ( src.GetSize(), map.GetSize() );
+		ASSERT_EQ( 2, map.GetTileSet()->Size() );
+		EXPECT_EQ( "tiles/ground.png", map.GetTileSet()->GetTileDef( 1 ).filepath );
+		EXPECT_TRUE( map.GetTileSet()->GetTileDef( 1 ).collidable );
+
+		for ( int x = 0; x < src.GetSize().x; x++ )
+		{
+			for ( int y = 0; y < src.GetSize().y; y++ )
+			{
+				ASSERT_EQ( src.GetTile( x, y ), map.GetTile( x, y ) );
+			}
+		}
+
+		const TileId* chunk = map.GetChunk( glm::ivec2( 1, 0 ) );
+		ASSERT_TRUE( chunk != NULL );
+		EXPECT_EQ( src.GetTile( WORLD_CHUNK_TILES, 5 ), chunk[ 5 ] );
+		EXPECT_TRUE( map.GetChunk( glm::ivec2( 3, 0 ) ) == NULL );
+	}
+	remove( "binary_map_test.pmap" );
+}
+
+/*
+================
+WorldTests::BinaryMap_RejectsUnknownTileIds
+================
+*/
+class UnknownTileMap : public TestMap
+{
+public:
+	UnknownTileMap() : TestMap( WORLD_CHUNK_TILES, WORLD_CHUNK_TILES ) { }
+
+	// Only tile def 1 exists.
+	virtual TileId GetTile( int x, int y ) const { return ( x == 3 && y == 4 ) ? 2 : TestMap::GetTile( x, y ); }
+};
+
+TEST_F(WorldTests, BinaryMap_RejectsUnknownTileIds)
+{
+	UnknownTileMap src;
+
+	// Raw and RLE chunks both.
+	const bool modes[] = { true, false };
+	for ( bool compress : modes )
+	{
+		const std::string path = "binary_map_test.pmap";
+		ASSERT_TRUE( BinaryMap::Write( path, src, compress ) );
+
+		BinaryMap map( path, false );
+		EXPECT_FALSE( map.Load() );
+	}
+	remove( "binary_map_test.pmap" );
+}
+
+/*
+================
+RecordingMapReader
+================
+*/
+class RecordingMapReader : public XmlMapReader
+{
+public:
+	std::vector< TileDef > 		defs;
+	glm::ivec2 					size;
+	std::vector< glm::ivec3 > 	tiles;
+	std::vector< std::string > 	events;
+
+protected:
+	virtual void OnTileDef( const TileDef& def ) { defs.push_back( def ); }
+	virtual bool OnTilesBegin( const glm::ivec2& s ) { size = s; return true; }
+	virtual void OnTile( int x, int y, TileId tile ) { tiles.push_back( glm::ivec3( x, y, tile ) ); }
+
+	virtual void OnStartElement( const char* name, const Attribute* attrs, int count )
+	{
+		const char* x = FindAttribute( attrs, count, "x" );
+		events.push_back( std::string( "<" ) + name + ( x ? std::string( " " ) + x : "" ) );
+	}
+
+	virtual void OnEndElement( const char* name, const char* text )
+	{
+		events.push_back( std::string( "/" ) + name + " " + text );
+	}
+};
+
+/*
+================
+WorldTests::XmlMapReader_StreamsTiles
+================
+*/
+TEST_F(WorldTests, XmlMapReader_StreamsTiles)
+{
+	const char* xml =
+		"<?xml version=\"1.0\"?>\n"
+		"<!-- legacy map -->\n"
+		"<Map>\n"
+		"  <TileSet><TileDef filepath='a&amp;b.png' type=\"OneWay\"/><TileDef/></TileSet>\n"
+		"  <Camera x=\"1.5\" y=\"2\" zoom=\"1\"/>\n"
+		"  <Tiles width=\"2\" height=\"3\">\n"
+		"    <TileRow index=\"1\"><Tile index=\"2\">7</Tile><Tile index=\"9\">1</Tile></TileRow>\n"
+		"    <TileRow index=\"0\"><Tile index=\"0\"><![CDATA[2]]></Tile></TileRow>\n"
+		"  </Tiles>\n"
+		"  <Objects><Object name=\"o\"><Rotation>&#51;</Rotation></Object></Objects>\n"
+		"</Map>\n";
+
+	const std::string path = "xml_map_reader_test.xml";
+	{
+		std::ofstream out( path );
+		out << xml;
+	}
+
+	RecordingMapReader reader;
+	ASSERT_TRUE( reader.Read( path ) );
+
+	ASSERT_EQ( 2u, reader.defs.size() );
+	EXPECT_EQ( "a&b.png", reader.defs[ 0 ].filepath );
+	EXPECT_EQ( TILETYPE_ONE_WAY, reader.defs[ 0 ].type );
+	EXPECT_TRUE( reader.defs[ 0 ].collidable );
+	EXPECT_FALSE( reader.defs[ 1 ].collidable );
+
+	// Out of range tiles are dropped.
+	EXPECT_EQ( glm::ivec2( 2, 3 ), reader.size );
+	ASSERT_EQ( 2u, reader.tiles.size() );
+	EXPECT_EQ( glm::ivec3( 1, 2, 7 ), reader.tiles[ 0 ] );
+	EXPECT_EQ( glm::ivec3( 0, 0, 2 ), reader.tiles[ 1 ] );
+
+	const char* events[] = { "<Camera 1.5", "/Camera ", "<Objects", "<Object", "<Rotation", "/Rotation 3", "/Object ", "/Objects " };
+	ASSERT_EQ( sizeof( events ) / sizeof( events[ 0 ] ), reader.events.size() );
+	for ( size_t i = 0; i < reader.events.size(); i++ )
+	{
+		EXPECT_EQ( events[ i ], reader.events[ i ] );
+	}
+
+	// Unbalanced tags fail.
+	{
+		std::ofstream out( path );
+		out << "<Map><Tiles width=\"1\" height=\"1\"></Map>";
+	}
+	EXPECT_FALSE( reader.Read( path ) );
+	remove( path.c_str() );
+}
+
+/*
+================
+WorldTests::SparseStorage_SkipsAir
+================
+*/
+TEST_F(WorldTests, SparseStorage_SkipsAir)
+{
+	TileSet tileSet;
+	TileDef solid;
+	solid.type 			= TILETYPE_SOLID;
+	solid.collidable 	= true;
+	TileDef decal;
+	decal.type 			= TILETYPE_SOLID;
+	const TileId solidId = tileSet.AddTileDef( solid );
+	const TileId decalId = tileSet.AddTileDef( decal );
+
+	// A floor along the bottom and a few tiles up high.
+	const glm::ivec2 size( 1024, 1024 );
+	World world;
+	world.NewWorld( size, &tileSet );
+	for ( int x = 0; x < size.x; x++ )
+	{
+		world.SetTile( glm::ivec2( x, 0 ), solidId );
+	}
+	world.SetTile( glm::ivec2( 40, 700 ), decalId );
+	world.SetTile( glm::ivec2( 40, 900 ), solidId );
+	world.SetTile( glm::ivec2( 70, 5 ), solidId );
+
+	EXPECT_EQ( solidId, world.GetTile( glm::ivec2( 500, 0 ) ) );
+	EXPECT_EQ( 0u, world.GetTile( glm::ivec2( 500, 500 ) ) );
+	EXPECT_LT( world.GetTileMemory() * 10, size.x * size.y * sizeof( TileId ) );
+
+	int hit = -1;
+	EXPECT_TRUE( world.FirstCollidableInColumn( 40, 1000, 0, hit ) );
+	EXPECT_EQ( 900, hit ); // skips air chunks from the top
+	EXPECT_FALSE( world.FirstCollidableInColumn( 40, 800, 1, hit ) );
+	EXPECT_TRUE( world.FirstCollidableInColumn( 40, 1, 1000, hit ) );
+	EXPECT_EQ( 900, hit ); // the decal isn't collidable
+	EXPECT_TRUE( world.FirstCollidableInRow( 5, 1023, 0, hit ) );
+	EXPECT_EQ( 70, hit );
+	EXPECT_FALSE( world.FirstCollidableInRow( 5, -50, 69, hit ) );
+
+	std::vector< glm::ivec2 > tiles;
+	world.TileIntersection( Aabb( 40.5f * TILE_PIXEL_SIZE, 1.0f, 1.0f * TILE_PIXEL_SIZE, 2.0f ), tiles );
+	ASSERT_EQ( 3u, tiles.size() );
+	EXPECT_EQ( glm::ivec2( 39, 0 ), tiles[ 0 ] );
+	EXPECT_EQ( glm::ivec2( 41, 0 ), tiles[ 2 ] );
+
+	// Clearing the last tile of a chunk releases it.
+	const size_t before = world.GetTileMemory();
+	world.SetTile( glm::ivec2( 40, 900 ), 0 );
+	EXPECT_LT( world.GetTileMemory(), before );
+	EXPECT_FALSE( world.FirstCollidableInColumn( 40, 1023, 1, hit ) );
+}
+
+/*
+================
+WorldTests::SweepAabb_StopsFastBodies
+================
+*/
+TEST_F(WorldTests, SweepAabb_StopsFastBodies)
+{
+	TileSet tileSet;
+	TileDef solid;
+	solid.type 			= TILETYPE_SOLID;
+	solid.collidable 	= true;
+	TileDef oneWay = solid;
+	oneWay.type 		= TILETYPE_ONE_WAY;
+	const TileId solidId = tileSet.AddTileDef( solid );
+	const TileId oneWayId = tileSet.AddTileDef( oneWay );
+
+	World world;
+	world.NewWorld( glm::ivec2( 64, 64 ), &tileSet );
+	for ( int x = 0; x < 64; x++ )
+	{
+		world.SetTile( glm::ivec2( x, 0 ), solidId );
+		world.SetTile( glm::ivec2( x, 5 ), oneWayId );
+	}
+	world.SetTile( glm::ivec2( 40, 1 ), solidId );
+	world.SetTile( glm::ivec2( 20, 20 ), solidId );
+
+	const float T = (float)TILE_PIXEL_SIZE;
+	SweepHit hit;
+
+	// Falling far past a one way platform in a single step.
+	const Aabb player( 10.5f * T, 200.0f + T, 0.5f * T, T );
+	ASSERT_TRUE( world.SweepAabb( player, glm::vec2( 0.0f, -1000.0f ), hit ) );
+	EXPECT_FLOAT_EQ( ( 6.0f * T - 200.0f ) / -1000.0f, hit.time );
+	EXPECT_EQ( glm::vec2( 0.0f, 1.0f ), hit.normal );
+	EXPECT_EQ( glm::ivec2( 10, 5 ), hit.tile );
+
+	// One way platforms let bodies through from below and the side.
+	const Aabb below( 10.5f * T, 2.0f * T, 0.5f * T, T );
+	EXPECT_FALSE( world.SweepAabb( below, glm::vec2( 0.0f, 100.0f ), hit ) );
+
+	// Sliding along the floor only stops at the wall.
+	ASSERT_TRUE( world.SweepAabb( below, glm::vec2( 1000.0f, 0.0f ), hit ) );
+	EXPECT_EQ( glm::vec2( -1.0f, 0.0f ), hit.normal );
+	EXPECT_EQ( glm::ivec2( 40, 1 ), hit.tile );
+	EXPECT_FLOAT_EQ( ( 40.0f * T - 11.0f * T ) / 1000.0f, hit.time );
+
+	// Exactly through a corner.
+	const Aabb box = Aabb::FromMinMax( glm::vec2( 18.0f * T ), glm::vec2( 19.0f * T ) );
+	ASSERT_TRUE( world.SweepAabb( box, glm::vec2( 2.0f * T ), hit ) );
+	EXPECT_EQ( glm::ivec2( 20, 20 ), hit.tile );
+	EXPECT_FLOAT_EQ( 0.5f, hit.time );
+}
+
+/*
+================
+WorldTests::BodySystem_LandsWithoutTunneling
+================
+*/
+TEST_F(WorldTests, BodySystem_LandsWithoutTunneling)
+{
+	TileSet tileSet;
+	TileDef solid;
+	solid.type 			= TILETYPE_SOLID;
+	solid.collidable 	= true;
+	TileDef oneWay = solid;
+	oneWay.type 		= TILETYPE_ONE_WAY;
+	const TileId solidId = tileSet.AddTileDef( solid );
+	const TileId oneWayId = tileSet.AddTileDef( oneWay );
+
+	// A floor, with a one way platform over the left half.
+	World world;
+	world.NewWorld( glm::ivec2( 128, 128 ), &tileSet );
+	for ( int x = 0; x < 128; x++ )
+	{
+		world.SetTile( glm::ivec2( x, 0 ), solidId );
+		if ( x < 64 )
+		{
+			world.SetTile( glm::ivec2( x, 10 ), oneWayId );
+		}
+	}
+
+	const float T = (float)TILE_PIXEL_SIZE;
+	BodySystem bodies( &world );
+	bodies.SetGravity( glm::vec2( 0.0f, -T * 200.0f ) );
+
+	std::vector< BodyId > ids;
+	for ( int i = 0; i < 1000; i++ )
+	{
+		const float x = ( 2.0f + ( i % 120 ) ) * T;
+		const float y = ( 40.0f + ( i / 120 ) * 2.0f ) * T;
+		ids.push_back( bodies.Add( Aabb( x, y, 0.4f * T, 0.4f * T ) ) );
+	}
+
+	// Removing keeps the other ids pointing at the same bodies.
+	bodies.Remove( ids[ 3 ] );
+	const Aabb before = bodies.GetBounds( ids[ 999 ] );
+	EXPECT_EQ( 999, bodies.GetCount() );
+	EXPECT_EQ( before.mCenter, bodies.GetBounds( ids[ 999 ] ).mCenter );
+
+	// Big steps so bodies move several tiles each.
+	for ( int step = 0; step < 60; step++ )
+	{
+		bodies.Step( 1.0f / 20.0f );
+	}
+
+	for ( int i = 0; i < 1000; i++ )
+	{
+		if ( i == 3 ) continue;
+
+		const Aabb b = bodies.GetBounds( ids[ i ] );
+		const float floor = ( b.GetMin().x < 64.0f * T ) ? 11.0f * T : 1.0f * T;
+		EXPECT_TRUE( bodies.IsGrounded( ids[ i ] ) );
+		EXPECT_NEAR( floor, b.GetMin().y, 0.5f );
+	}
+
+	// A body can jump up through the platform.
+	const BodyId jumper = ids[ 0 ];
+	bodies.SetCenter( jumper, glm::vec2( 10.5f * T, 1.0f * T + 0.4f * T ) );
+	bodies.SetVelocity( jumper, glm::vec2( 0.0f, T * 150.0f ) );
+	bodies.Step( 1.0f / 20.0f );
+	bodies.Step( 1.0f / 20.0f );
+	EXPECT_GT( bodies.GetBounds( jumper ).GetMin().y, 11.0f * T );
+
+	// Max speed holds against gravity, and against the velocity it's given.
+	BodySystem falling( NULL );
+	falling.SetGravity( glm::vec2( 0.0f, -T * 200.0f ) );
+	const BodyId faller = falling.Add( Aabb( 0.0f, 0.0f, T, T ) );
+	falling.SetMaxSpeed( faller, glm::vec2( T * 10.0f, T * 50.0f ) );
+	falling.SetVelocity( faller, glm::vec2( T * 40.0f, 0.0f ) );
+	for ( int step = 0; step < 10; step++ )
+	{
+		falling.Step( 1.0f / 20.0f );
+	}
+	EXPECT_EQ( glm::vec2( T * 10.0f, -T * 50.0f ), falling.GetVelocity( faller ) );
+	EXPECT_NEAR( -T * 20.0f, falling.GetBounds( faller ).mCenter.y, 0.5f ); // 10, 20 .. 50, then 50 a step
+}
+
+/*
+================
+WorldTests::SpatialHash_MatchesBruteForce
+================
+*/
+TEST_F(WorldTests, SpatialHash_MatchesBruteForce)
+{
+	// Mostly small boxes with a few spanning many cells, some negative.
+	std::vector< Aabb > boxes;
+	std::vector< ProxyId > ids;
+	SpatialHash hash( 32.0f );
+	srand( 7 );
+	for ( int i = 0; i < 400; i++ )
+	{
+		const float half = ( i % 50 == 0 ) ? 150.0f : 4.0f + rand() % 12;
+		boxes.push_back( Aabb( (float)( rand() % 1000 ) - 300.0f, (float)( rand() % 1000 ) - 300.0f, half, half ) );
+		ids.push_back( hash.Insert( boxes.back() ) );
+	}
+
+	// Move everything, then free and reuse some ids.
+	for ( int i = 0; i < 400; i++ )
+	{
+		boxes[ i ].mCenter += glm::vec2( (float)( rand() % 81 - 40 ), (float)( rand() % 81 - 40 ) );
+		hash.Update( ids[ i ], boxes[ i ] );
+	}
+	for ( int i = 0; i < 400; i += 9 )
+	{
+		hash.Remove( ids[ i ] );
+		ids[ i ] = hash.Insert( boxes[ i ] );
+	}
+	ASSERT_EQ( 400, hash.GetCount() );
+
+	std::vector< std::pair< ProxyId, ProxyId > > expected;
+	for ( int i = 0; i < 400; i++ )
+	{
+		for ( int j = 0; j < 400; j++ )
+		{
+			const glm::vec2 d = glm::abs( boxes[ i ].mCenter - boxes[ j ].mCenter );
+			const glm::vec2 r = boxes[ i ].mHalfExtent + boxes[ j ].mHalfExtent;
+			if ( ids[ i ] < ids[ j ] && d.x < r.x && d.y < r.y )
+				expected.push_back( std::make_pair( ids[ i ], ids[ j ] ) );
+		}
+	}
+	std::sort( expected.begin(), expected.end() );
+
+	std::vector< ProxyPair > pairs;
+	hash.FindPairs( pairs );
+	ASSERT_EQ( expected.size(), pairs.size() );
+	for ( size_t i = 0; i < pairs.size(); i++ )
+	{
+		EXPECT_EQ( expected[ i ].first, pairs[ i ].a );
+		EXPECT_EQ( expected[ i ].second, pairs[ i ].b );
+	}
+
+	// A query sees the same overlaps as the pairs.
+	std::vector< ProxyId > found;
+	hash.Query( boxes[ 10 ], found );
+	size_t overlaps = 0;
+	for ( size_t i = 0; i < expected.size(); i++ )
+		overlaps += ( expected[ i ].first == ids[ 10 ] || expected[ i ].second == ids[ 10 ] ) ? 1 : 0;
+	EXPECT_EQ( overlaps + 1, found.size() );
+
+	// Rays return the nearest box along them.
+	SpatialHash line( 16.0f );
+	const ProxyId nearBox = line.Insert( Aabb( 200.0f, 5.0f, 10.0f, 10.0f ) );
+	line.Insert( Aabb( 100.0f, 500.0f, 10.0f, 10.0f ) );
+	line.Insert( Aabb( 400.0f, 0.0f, 10.0f, 10.0f ) );
+	const ProxyId big = line.Insert( Aabb( 300.0f, 0.0f, 5.0f, 100.0f ) );
+
+	ProxyId hitId = PROXY_NONE;
+	float t = 0.0f;
+	ASSERT_TRUE( line.Raycast( glm::vec2( 0.0f ), glm::vec2( 1000.0f, 0.0f ), hitId, t ) );
+	EXPECT_EQ( nearBox, hitId );
+	EXPECT_FLOAT_EQ( 0.19f, t );
+	ASSERT_TRUE( line.Raycast( glm::vec2( 0.0f ), glm::vec2( 1000.0f, 0.0f ), hitId, t, nearBox ) );
+	EXPECT_EQ( big, hitId );
+	EXPECT_FLOAT_EQ( 0.295f, t );
+	EXPECT_FALSE( line.Raycast( glm::vec2( 0.0f ), glm::vec2( 150.0f, 0.0f ), hitId, t ) );
+	EXPECT_FALSE( line.Raycast( glm::vec2( 0.0f, 200.0f ), glm::vec2( 1000.0f, 200.0f ), hitId, t ) );
+}
+
+/*
+================
+WorldTests::Raycast_HitsFaces
+================
+*/
+TEST_F(WorldTests, Raycast_HitsFaces)
+{
+	TileSet tileSet;
+	TileDef solid;
+	solid.type 			= TILETYPE_SOLID;
+	solid.collidable 	= true;
+	TileDef oneWay = solid;
+	oneWay.type 		= TILETYPE_ONE_WAY;
+	const TileId solidId = tileSet.AddTileDef( solid );
+	const TileId oneWayId = tileSet.AddTileDef( oneWay );
+
+	World world;
+	world.NewWorld( glm::ivec2( 64, 64 ), &tileSet );
+	for ( int x = 0; x < 64; x++ )
+	{
+		world.SetTile( glm::ivec2( x, 0 ), solidId );
+		world.SetTile( glm::ivec2( x, 5 ), oneWayId );
+	}
+	world.SetTile( glm::ivec2( 40, 1 ), solidId );
+
+	const float T = (float)TILE_PIXEL_SIZE;
+	RaycastHit hit;
+
+	// Straight down lands on the one way platform, or the floor ignoring it.
+	ASSERT_TRUE( world.Raycast( glm::vec2( 10.5f * T, 20.0f * T ), glm::vec2( 0.0f, -3.0f ), 1000.0f, hit ) );
+	EXPECT_EQ( glm::ivec2( 10, 5 ), hit.tile );
+	EXPECT_EQ( glm::vec2( 0.0f, 1.0f ), hit.normal );
+	EXPECT_FLOAT_EQ( 14.0f * T, hit.distance );
+	ASSERT_TRUE( world.Raycast( glm::vec2( 10.5f * T, 20.0f * T ), glm::vec2( 0.0f, -1.0f ), 1000.0f, hit, RAYCAST_IGNORE_ONE_WAY ) );
+	EXPECT_EQ( glm::ivec2( 10, 0 ), hit.tile );
+	EXPECT_FLOAT_EQ( T, hit.point.y );
+
+	// Up through the platform from below, and too short to reach anything.
+	EXPECT_FALSE( world.Raycast( glm::vec2( 10.5f * T, 1.5f * T ), glm::vec2( 0.0f, 1.0f ), 1000.0f, hit ) );
+	EXPECT_FALSE( world.Raycast( glm::vec2( 10.5f * T, 20.0f * T ), glm::vec2( 0.0f, -1.0f ), 13.0f * T, hit ) );
+
+	// Diagonal into the wall's side, from outside the world.
+	ASSERT_TRUE( world.Raycast( glm::vec2( -T, 3.5f * T ), glm::vec2( 41.0f * T, -2.0f * T ), 1000.0f * T, hit ) );
+	EXPECT_EQ( glm::ivec2( 40, 1 ), hit.tile );
+	EXPECT_EQ( glm::vec2( -1.0f, 0.0f ), hit.normal );
+	EXPECT_NEAR( 40.0f * T, hit.point.x, 0.01f );
+	EXPECT_NEAR( 1.5f * T, hit.point.y, 0.01f );
+
+	// Starting inside a solid tile, and entering the floor from the world's edge.
+	ASSERT_TRUE( world.Raycast( glm::vec2( 3.5f * T, 0.5f * T ), glm::vec2( 1.0f, 1.0f ), 10.0f, hit ) );
+	EXPECT_EQ( 0.0f, hit.distance );
+	EXPECT_EQ( glm::vec2( 0.0f ), hit.normal );
+	ASSERT_TRUE( world.Raycast( glm::vec2( -10.0f, 0.5f * T ), glm::vec2( 1.0f, 0.0f ), 100.0f, hit ) );
+	EXPECT_EQ( glm::ivec2( 0, 0 ), hit.tile );
+	EXPECT_EQ( glm::vec2( -1.0f, 0.0f ), hit.normal );
+	EXPECT_FLOAT_EQ( 10.0f, hit.distance );
+
+	Ray rays[ 3 ];
+	rays[ 0 ] = Ray{ glm::vec2( 2.5f * T, 3.5f * T ), glm::vec2( 0.0f, -1.0f ), 100.0f };
+	rays[ 1 ] = Ray{ glm::vec2( 2.5f * T, 3.5f * T ), glm::vec2( 1.0f, 0.0f ), 100.0f };
+	rays[ 2 ] = Ray{ glm::vec2( 2.5f * T, 8.5f * T ), glm::vec2( 0.0f, -1.0f ), 100.0f };
+	RaycastHit hits[ 3 ];
+	EXPECT_EQ( 2, world.RaycastMany( rays, 3, hits ) );
+	EXPECT_EQ( glm::ivec2( 2, 0 ), hits[ 0 ].tile );
+	EXPECT_EQ( glm::ivec2( -1 ), hits[ 1 ].tile );
+	EXPECT_EQ( glm::vec2( 2.5f * T + 100.0f, 3.5f * T ), hits[ 1 ].point );
+	EXPECT_EQ( glm::ivec2( 2, 5 ), hits[ 2 ].tile );
+	EXPECT_EQ( 1, world.RaycastMany( rays, 3, hits, RAYCAST_IGNORE_ONE_WAY ) );
+	EXPECT_EQ( glm::ivec2( -1 ), hits[ 2 ].tile );
+}
+
+/*
+================
+WorldTests::TileCells_TrackNeighbours
+================
+*/
+TEST_F(WorldTests, TileCells_TrackNeighbours)
+{
+	// Column pattern crossing chunk edges, then edited tile by tile.
+	TestMap map( 70, 40 );
+	World world;
+	world.LoadMap( &map );
+
+	TileSet& tileSet = const_cast< TileSet& >( *map.GetTileSet() );
+	TileDef oneWay;
+	oneWay.type 		= TILETYPE_ONE_WAY;
+	oneWay.collidable 	= true;
+	const TileId oneWayId = tileSet.AddTileDef( oneWay );
+
+	srand( 3 );
+	for ( int i = 0; i < 2000; i++ )
+	{
+		world.SetTile( glm::ivec2( rand() % 70, rand() % 40 ), rand() % 3 == 0 ? 0 : 1 + rand() % 2 );
+	}
+	world.SetTile( glm::ivec2( 31, 31 ), 1 );
+	world.SetTile( glm::ivec2( 32, 31 ), oneWayId );
+	world.SetTile( glm::ivec2( 31, 32 ), 1 );
+
+	const TileSet* ts = map.GetTileSet();
+	auto solid = [&]( int x, int y )
+	{
+		if ( x < 0 || x >= 70 || y < 0 || y >= 40 )
+			return false;
+		const TileDef& def = ts->GetTileDef( world.GetTile( glm::ivec2( x, y ) ) );
+		return def.collidable && def.type == TILETYPE_SOLID;
+	};
+
+	for ( int x = 0; x < 70; x++ )
+	{
+		for ( int y = 0; y < 40; y++ )
+		{
+			const uint8_t cell = world.GetTileCell( glm::ivec2( x, y ) );
+			if ( !world.GetTile( glm::ivec2( x, y ) ) )
+			{
+				ASSERT_EQ( 0, cell );
+				continue;
+			}
+
+			ASSERT_EQ( solid( x, y ), ( cell & TILECELL_SOLID ) != 0 );
+			ASSERT_EQ( solid( x - 1, y ), ( cell & TILECELL_SOLID_LEFT ) != 0 ) << x << "," << y;
+			ASSERT_EQ( solid( x + 1, y ), ( cell & TILECELL_SOLID_RIGHT ) != 0 ) << x << "," << y;
+			ASSERT_EQ( solid( x, y - 1 ), ( cell & TILECELL_SOLID_DOWN ) != 0 ) << x << "," << y;
+			ASSERT_EQ( solid( x, y + 1 ), ( cell & TILECELL_SOLID_UP ) != 0 ) << x << "," << y;
+		}
+	}
+
+	// One way neighbours don't hide a face.
+	EXPECT_TRUE( world.GetTileCell( glm::ivec2( 32, 31 ) ) & TILECELL_ONE_WAY );
+	EXPECT_FALSE( world.IsInternalCollision( glm::ivec2( 31, 31 ), Contact( glm::vec2( 1.0f, 0.0f ), -1.0f ) ) );
+	EXPECT_TRUE( world.IsInternalCollision( glm::ivec2( 31, 31 ), Contact( glm::vec2( 0.0f, 1.0f ), -1.0f ) ) );
+	EXPECT_EQ( 0, world.GetTileCell( glm::ivec2( -1, 5 ) ) );
+}